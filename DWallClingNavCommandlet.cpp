@@ -0,0 +1,346 @@
+#include "Dignity.h"
+#include "DWallClingNavCommandlet.h"
+#include "DWallClingNavData.h"
+#include "DWallJumpComponent.h"
+#include "DWallJumpStats.h"
+#include "DWallJumpSubsystem.h"
+#include "DWallSurfaceCache.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "Misc/FileHelper.h"
+#include "UObject/Package.h"
+
+/* Surface samples are merged into an Patch by their Component, an coarse normal and the cell they land in on its plane. */
+struct FDWallClingNavCellKey
+{
+	FIntVector Normal;
+	FIntVector Cell;
+
+	FORCEINLINE bool operator==(const FDWallClingNavCellKey& Other) const { return Normal == Other.Normal && Cell == Other.Cell; }
+
+	friend FORCEINLINE uint32 GetTypeHash(const FDWallClingNavCellKey& Key) { return HashCombine(GetTypeHash(Key.Normal), GetTypeHash(Key.Cell)); }
+};
+
+struct FDWallClingNavCell
+{
+	FVector CenterSum;
+	FVector NormalSum;
+	int32 NumSamples;
+
+	/* EDWallSurfaceFlags of every sample. */
+	uint8 Flags;
+
+	FDWallClingNavCell()
+		: CenterSum(FVector::ZeroVector)
+		, NormalSum(FVector::ZeroVector)
+		, NumSamples(0)
+		, Flags(EDWallSurfaceFlags::None)
+	{
+	}
+};
+
+UDWallClingNavCommandlet::UDWallClingNavCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+	ShowErrorCount = true;
+
+	SampleSpacing = 50.f;
+	PatchSize = 200.f;
+	ChunkSize = 5000.f;
+	MaxLinksPerPatch = 16;
+}
+
+int32 UDWallClingNavCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	FString MapList;
+	if (!FParse::Value(*Params, TEXT("Map="), MapList, false))
+	{
+		UE_LOG(LogDWallJump, Error, TEXT("Usage: -run=DWallClingNav -Map=/Game/Maps/MapA[,/Game/Maps/MapB] [-Component=<WJC Class>] [-SampleSpacing=50] [-PatchSize=200] [-ChunkSize=5000] [-MaxLinks=16] [-Verify]"));
+		return 1;
+	}
+
+	TArray<FString> MapNames;
+	MapList.ParseIntoArray(MapNames, TEXT(","));
+
+	FParse::Value(*Params, TEXT("SampleSpacing="), SampleSpacing);
+	FParse::Value(*Params, TEXT("PatchSize="), PatchSize);
+	FParse::Value(*Params, TEXT("ChunkSize="), ChunkSize);
+	FParse::Value(*Params, TEXT("MaxLinks="), MaxLinksPerPatch);
+
+	SampleSpacing = FMath::Max(SampleSpacing, 1.f);
+	PatchSize = FMath::Max(PatchSize, SampleSpacing);
+	ChunkSize = FMath::Max(ChunkSize, PatchSize);
+
+	const bool bVerify = FParse::Param(*Params, TEXT("Verify"));
+
+	// Bake with the Cling angles and WallJumpMagnitude the Characters will actually use.
+	const UDWallJumpComponent* Settings = GetDefault<UDWallJumpComponent>();
+
+	FString ComponentClassPath;
+	if (FParse::Value(*Params, TEXT("Component="), ComponentClassPath))
+	{
+		UClass* ComponentClass = LoadClass<UDWallJumpComponent>(nullptr, *ComponentClassPath);
+		if (!ComponentClass)
+		{
+			UE_LOG(LogDWallJump, Error, TEXT("%s is not an WallJumpComponent class."), *ComponentClassPath);
+			return 1;
+		}
+
+		Settings = ComponentClass->GetDefaultObject<UDWallJumpComponent>();
+	}
+
+	int32 NumFailed = 0;
+
+	for (const FString& MapName : MapNames)
+	{
+		if (!BakeMap(MapName, Settings, bVerify))
+		{
+			NumFailed++;
+		}
+
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	return NumFailed > 0 ? 1 : 0;
+#else
+	UE_LOG(LogDWallJump, Error, TEXT("Wall Cling navigation data can only be baked in an Editor build."));
+	return 1;
+#endif //WITH_EDITOR
+}
+
+bool UDWallClingNavCommandlet::BakeMap(const FString& MapName, const UDWallJumpComponent* Settings, bool bVerify)
+{
+#if WITH_EDITOR
+	UPackage* Package = LoadPackage(nullptr, *MapName, LOAD_None);
+	UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+
+	if (!World)
+	{
+		UE_LOG(LogDWallJump, Error, TEXT("Failed to load map %s."), *MapName);
+		return false;
+	}
+
+	World->WorldType = EWorldType::Editor;
+	World->AddToRoot();
+
+	if (!World->bIsWorldInitialized)
+	{
+		World->InitWorld(UWorld::InitializationValues()
+			.ShouldSimulatePhysics(false)
+			.EnableTraceCollision(true)
+			.CreateNavigation(false)
+			.CreateAISystem(false)
+			.AllowAudioPlayback(false)
+			.CreatePhysicsScene(true));
+	}
+
+	World->LoadSecondaryLevels();
+	World->UpdateWorldComponents(true, false);
+
+	// The furthest an WallJump can carry the Character is an 45 degree Launch at WallJumpMagnitude, and the highest is straight up.
+	const float Gravity = FMath::Max(FMath::Abs(World->GetGravityZ()), KINDA_SMALL_NUMBER);
+	const float LaunchSpeedSquared = FMath::Square(Settings->GetTuning().WallJumpMagnitude);
+
+	FDWallClingNavDataBuilder Builder(ChunkSize, LaunchSpeedSquared / Gravity, LaunchSpeedSquared / (2.f * Gravity));
+
+	GatherPatches(World, Settings, Builder);
+	Builder.BuildLinks(MaxLinksPerPatch);
+
+	TArray<uint8> Data;
+	Builder.Write(Data);
+
+	World->CleanupWorld();
+	World->RemoveFromRoot();
+
+	const FString FilePath = FDWallClingNavData::GetFilePath(MapName);
+	if (!FFileHelper::SaveArrayToFile(Data, *FilePath))
+	{
+		UE_LOG(LogDWallJump, Error, TEXT("Failed to write %s."), *FilePath);
+		return false;
+	}
+
+	UE_LOG(LogDWallJump, Display, TEXT("Baked %s to %s, %d Patches, %d Links, %d bytes."), *MapName, *FilePath, Builder.NumPatches(), Builder.NumLinks(), Data.Num());
+
+	return !bVerify || VerifyFile(FilePath, Builder.NumPatches(), Builder.NumLinks());
+#else
+	return false;
+#endif //WITH_EDITOR
+}
+
+void UDWallClingNavCommandlet::GatherPatches(UWorld* World, const UDWallJumpComponent* Settings, FDWallClingNavDataBuilder& Builder) const
+{
+	const UDWallJumpSubsystem* SubsystemDefaults = GetDefault<UDWallJumpSubsystem>();
+
+	FDWallSurfaceRules Rules;
+	Rules.NoClingTag = SubsystemDefaults->NoWallClingTag;
+	Rules.NoJumpTag = SubsystemDefaults->NoWallJumpTag;
+	Rules.NoClingSurfaceTypes = SubsystemDefaults->NoWallClingSurfaceTypes;
+	Rules.NoJumpSurfaceTypes = SubsystemDefaults->NoWallJumpSurfaceTypes;
+
+	// The same bounds the WJC Clings with, for an Character whose Up is the World Up.
+	const float MinPitchCos = Settings->GetTuning().ClingMinPitchSurfaceAngleCos;
+	const float MaxPitchCos = Settings->GetTuning().ClingMaxPitchSurfaceAngleCos;
+
+	TMap<FDWallClingNavCellKey, FDWallClingNavCell> Cells;
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(DWallClingNav), false);
+	QueryParams.bReturnPhysicalMaterial = true;
+
+	static const FVector Directions[] = { FVector::ForwardVector, -FVector::ForwardVector, FVector::RightVector, -FVector::RightVector };
+
+	for (ULevel* Level : World->GetLevels())
+	{
+		for (AActor* Actor : Level->Actors)
+		{
+			if (!Actor)
+			{
+				continue;
+			}
+
+			TInlineComponentArray<UPrimitiveComponent*> Components(Actor);
+
+			for (UPrimitiveComponent* Component : Components)
+			{
+				// The same Surfaces OnCharacterCapsuleHit() accepts, that will never move.
+				if (!Component->IsRegistered() || Component->Mobility != EComponentMobility::Static || !Component->IsQueryCollisionEnabled()
+					|| Component->GetCollisionObjectType() != ECC_WorldStatic || Component->GetCollisionResponseToChannel(ECC_Pawn) != ECR_Block)
+				{
+					continue;
+				}
+
+				Cells.Reset();
+
+				const FBox Bounds = Component->Bounds.GetBox();
+				const FVector BoundsCenter = Bounds.GetCenter();
+				const FVector BoundsExtent = Bounds.GetExtent();
+
+				// Walls are sampled with horizontal traces from every side of the bounds, the first face each trace hits is an Surface an Character could run into.
+				for (const FVector& Direction : Directions)
+				{
+					const FVector Across = FMath::Abs(Direction.X) > 0.f ? FVector::RightVector : FVector::ForwardVector;
+					const float AcrossExtent = BoundsExtent | Across;
+					const float AlongExtent = FMath::Abs(BoundsExtent | Direction) + 10.f;
+
+					for (float AcrossOffset = -AcrossExtent; AcrossOffset <= AcrossExtent; AcrossOffset += SampleSpacing)
+					{
+						for (float UpOffset = -BoundsExtent.Z; UpOffset <= BoundsExtent.Z; UpOffset += SampleSpacing)
+						{
+							const FVector Origin = BoundsCenter + Across * AcrossOffset + FVector::UpVector * UpOffset;
+
+							FHitResult Hit;
+							if (!Component->LineTraceComponent(Hit, Origin - Direction * AlongExtent, Origin + Direction * AlongExtent, QueryParams))
+							{
+								continue;
+							}
+
+							const FVector Normal = Hit.ImpactNormal;
+							if (Normal.Z > MinPitchCos || Normal.Z < MaxPitchCos)
+							{
+								continue;
+							}
+
+							const uint8 Flags = FDWallSurfaceCache::GetSurfaceFlags(Component, Hit, Rules);
+							if ((Flags & EDWallSurfaceFlags::NoCling) && (Flags & EDWallSurfaceFlags::NoJump))
+							{
+								continue;
+							}
+
+							FDWallClingNavCellKey Key;
+							Key.Normal = FIntVector(FMath::RoundToInt(Normal.X * 8.f), FMath::RoundToInt(Normal.Y * 8.f), FMath::RoundToInt(Normal.Z * 8.f));
+
+							// Cell axes come from the coarse normal so every sample of the same face agrees on them.
+							const FVector KeyNormal = FVector(Key.Normal).GetSafeNormal();
+							FVector AxisU, AxisV;
+							KeyNormal.FindBestAxisVectors(AxisU, AxisV);
+
+							const FVector& Point = Hit.ImpactPoint;
+							Key.Cell = FIntVector(FMath::FloorToInt((Point | AxisU) / PatchSize), FMath::FloorToInt((Point | AxisV) / PatchSize), FMath::RoundToInt((Point | KeyNormal) / SampleSpacing));
+
+							FDWallClingNavCell& Cell = Cells.FindOrAdd(Key);
+							Cell.CenterSum += Point;
+							Cell.NormalSum += Normal;
+							Cell.NumSamples++;
+							Cell.Flags |= Flags;
+						}
+					}
+				}
+
+				for (const TPair<FDWallClingNavCellKey, FDWallClingNavCell>& Pair : Cells)
+				{
+					const FDWallClingNavCell& Cell = Pair.Value;
+					Builder.AddPatch(Cell.CenterSum / Cell.NumSamples, Cell.NormalSum, PatchSize * 0.5f, PatchSize * 0.5f, Cell.Flags);
+				}
+			}
+		}
+	}
+}
+
+bool UDWallClingNavCommandlet::VerifyFile(const FString& FilePath, int32 ExpectedPatches, int32 ExpectedLinks)
+{
+	FDWallClingNavData NavData;
+	if (!NavData.Open(FilePath))
+	{
+		UE_LOG(LogDWallJump, Error, TEXT("Verify: failed to open %s."), *FilePath);
+		return false;
+	}
+
+	int32 NumPatches = 0;
+	int32 NumLinks = 0;
+	int32 NumErrors = 0;
+
+	TArray<FDWallClingPatchRef> FoundPatches;
+
+	for (int32 ChunkIndex = 0; ChunkIndex < NavData.NumChunks(); ChunkIndex++)
+	{
+		for (int32 PatchIndex = 0; PatchIndex < (int32)NavData.GetChunk(ChunkIndex).NumPatches; PatchIndex++)
+		{
+			const FDWallClingPatchRef PatchRef(ChunkIndex, PatchIndex);
+			const FDWallClingPatch* Patch = NavData.GetPatch(PatchRef);
+			if (!Patch)
+			{
+				NumErrors++;
+				continue;
+			}
+
+			NumPatches++;
+
+			FoundPatches.Reset();
+			NavData.FindPatches(Patch->Center, 1.f, FoundPatches);
+
+			if (!FoundPatches.Contains(PatchRef))
+			{
+				UE_LOG(LogDWallJump, Error, TEXT("Verify: Patch %d of chunk %d at %s was not found by an query at its Center."), PatchIndex, ChunkIndex, *Patch->Center.ToString());
+				NumErrors++;
+			}
+
+			int32 NumPatchLinks = 0;
+			const FDWallJumpLink* Links = NavData.GetLinks(PatchRef, NumPatchLinks);
+
+			for (int32 LinkIndex = 0; LinkIndex < NumPatchLinks; LinkIndex++)
+			{
+				if (Links[LinkIndex].FromPatch != (uint32)PatchIndex || !NavData.GetPatch(FDWallClingPatchRef(Links[LinkIndex].ToChunk, Links[LinkIndex].ToPatch)))
+				{
+					UE_LOG(LogDWallJump, Error, TEXT("Verify: Link %d of Patch %d of chunk %d is invalid."), LinkIndex, PatchIndex, ChunkIndex);
+					NumErrors++;
+				}
+			}
+
+			NumLinks += NumPatchLinks;
+		}
+	}
+
+	if (NumPatches != ExpectedPatches || NumLinks != ExpectedLinks)
+	{
+		UE_LOG(LogDWallJump, Error, TEXT("Verify: %s has %d Patches and %d Links, expected %d and %d."), *FilePath, NumPatches, NumLinks, ExpectedPatches, ExpectedLinks);
+		NumErrors++;
+	}
+
+	UE_CLOG(NumErrors == 0, LogDWallJump, Display, TEXT("Verify: %s is valid."), *FilePath);
+
+	return NumErrors == 0;
+}
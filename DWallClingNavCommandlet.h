@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "DWallClingNavCommandlet.generated.h"
+
+class UDWallJumpComponent;
+class FDWallClingNavDataBuilder;
+
+/**
+ * Bakes the Wall Cling navigation data AI use to plan WallJumps, see FDWallClingNavData.
+ * Every static Surface a Character can collide with is sampled with the same Pitch rules WallCling() uses, and the Surfaces that pass are
+ * merged into Patches and linked by how far an WallJump with the WJCs WallJumpMagnitude can reach.
+ *
+ * UE4Editor-Cmd <Project> -run=DWallClingNav -Map=/Game/Maps/MapA[,/Game/Maps/MapB] [-Component=/Game/Path/BP_Character.BP_Character_C]
+ *	[-SampleSpacing=50] [-PatchSize=200] [-ChunkSize=5000] [-MaxLinks=16] [-Verify]
+ *
+ * -Component is the class whose WJC defaults are baked with, -Verify reads every file back and checks it against what was baked.
+ */
+UCLASS()
+class DIGNITY_API UDWallClingNavCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	UDWallClingNavCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+
+	/* Distance between the traces sampling each Surface. */
+	float SampleSpacing;
+
+	/* The size of the cells Surface samples are merged into Patches by. */
+	float PatchSize;
+
+	float ChunkSize;
+
+	int32 MaxLinksPerPatch;
+
+	/* Bakes one map, returning false if it couldnt be loaded or written. */
+	bool BakeMap(const FString& MapName, const UDWallJumpComponent* Settings, bool bVerify);
+
+	/* Samples every static Surface of the World, adding the clingable ones to the Builder. */
+	void GatherPatches(UWorld* World, const UDWallJumpComponent* Settings, FDWallClingNavDataBuilder& Builder) const;
+
+	/* Opens the baked file and checks every Patch can be found again at its own Center. */
+	static bool VerifyFile(const FString& FilePath, int32 ExpectedPatches, int32 ExpectedLinks);
+};
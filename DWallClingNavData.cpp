@@ -0,0 +1,420 @@
+#include "Dignity.h"
+#include "DWallClingNavData.h"
+#include "DWallJumpStats.h"
+#include "DWallSurfaceCache.h"
+#include "Algo/BinarySearch.h"
+#include "Async/MappedFileHandle.h"
+#include "Containers/ArrayView.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+
+FDWallClingNavDataBuilder::FDWallClingNavDataBuilder(float InChunkSize, float InMaxJumpDistance, float InMaxJumpHeight)
+	: ChunkSize(FMath::Max(InChunkSize, 1.f))
+	, MaxJumpDistance(InMaxJumpDistance)
+	, MaxJumpHeight(InMaxJumpHeight)
+{
+}
+
+FIntPoint FDWallClingNavDataBuilder::GetChunkCoords(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / ChunkSize), FMath::FloorToInt(Location.Y / ChunkSize));
+}
+
+void FDWallClingNavDataBuilder::AddPatch(const FVector& Center, const FVector& Normal, float HalfWidth, float HalfHeight, uint16 Flags)
+{
+	const FVector SafeNormal = Normal.GetSafeNormal();
+
+	FDWallClingPatch& Patch = Patches.AddDefaulted_GetRef();
+	Patch.Center = Center;
+	Patch.Normal[0] = (int16)FMath::RoundToInt(SafeNormal.X * MAX_int16);
+	Patch.Normal[1] = (int16)FMath::RoundToInt(SafeNormal.Y * MAX_int16);
+	Patch.Normal[2] = (int16)FMath::RoundToInt(SafeNormal.Z * MAX_int16);
+	Patch.HalfWidth = (uint16)FMath::Clamp(FMath::RoundToInt(HalfWidth), 0, (int32)MAX_uint16);
+	Patch.HalfHeight = (uint16)FMath::Clamp(FMath::RoundToInt(HalfHeight), 0, (int32)MAX_uint16);
+	Patch.Flags = Flags;
+}
+
+void FDWallClingNavDataBuilder::BuildLinks(int32 MaxLinksPerPatch /*= 16*/)
+{
+	Links.Reset();
+
+	// Sorting by X lets each Patch only look at the Patches within MaxJumpDistance of it on that axis.
+	TArray<int32> SortedByX;
+	SortedByX.Reserve(Patches.Num());
+	for (int32 Index = 0; Index < Patches.Num(); Index++)
+	{
+		SortedByX.Add(Index);
+	}
+	SortedByX.Sort([this](int32 A, int32 B) { return Patches[A].Center.X < Patches[B].Center.X; });
+
+	const float MaxJumpDistanceSquared = FMath::Square(MaxJumpDistance);
+
+	struct FCandidate
+	{
+		int32 To;
+		float DistanceSquared;
+	};
+
+	TArray<FCandidate> Candidates;
+
+	for (int32 From = 0; From < Patches.Num(); From++)
+	{
+		const FDWallClingPatch& FromPatch = Patches[From];
+		if ((FromPatch.Flags & EDWallSurfaceFlags::NoJump) != 0)
+		{
+			continue;
+		}
+
+		const FVector FromNormal = FromPatch.GetNormal();
+
+		Candidates.Reset();
+
+		int32 Start = Algo::LowerBoundBy(SortedByX, FromPatch.Center.X - MaxJumpDistance, [this](int32 Index) { return Patches[Index].Center.X; });
+		for (int32 Sorted = Start; Sorted < SortedByX.Num(); Sorted++)
+		{
+			const int32 To = SortedByX[Sorted];
+			const FDWallClingPatch& ToPatch = Patches[To];
+
+			if (ToPatch.Center.X > FromPatch.Center.X + MaxJumpDistance)
+			{
+				break;
+			}
+
+			if (To == From)
+			{
+				continue;
+			}
+
+			const FVector Delta = ToPatch.Center - FromPatch.Center;
+			const float DistanceSquared = Delta.SizeSquared();
+
+			// An WallJump Launches the Character away from the Surface it is on, so the other Surface has to be in front of it, facing back and within reach.
+			if (DistanceSquared > MaxJumpDistanceSquared || Delta.Z > MaxJumpHeight || (Delta | FromNormal) <= 0.f || (Delta | ToPatch.GetNormal()) >= 0.f)
+			{
+				continue;
+			}
+
+			Candidates.Add({ To, DistanceSquared });
+		}
+
+		Candidates.Sort([](const FCandidate& A, const FCandidate& B) { return A.DistanceSquared < B.DistanceSquared; });
+
+		for (int32 Index = 0; Index < FMath::Min(Candidates.Num(), MaxLinksPerPatch); Index++)
+		{
+			Links.Add({ From, Candidates[Index].To });
+		}
+	}
+}
+
+void FDWallClingNavDataBuilder::Write(TArray<uint8>& OutData) const
+{
+	// Group the Patches into their chunks, the chunk table is sorted by key so readers can binary search it.
+	TMap<int64, TArray<int32>> ChunkPatches;
+	for (int32 Index = 0; Index < Patches.Num(); Index++)
+	{
+		const FIntPoint Coords = GetChunkCoords(Patches[Index].Center);
+		ChunkPatches.FindOrAdd(FDWallClingNavChunk::MakeKey(Coords.X, Coords.Y)).Add(Index);
+	}
+
+	ChunkPatches.KeySort([](int64 A, int64 B) { return A < B; });
+
+	TArray<FDWallClingNavChunk> Chunks;
+	Chunks.Reserve(ChunkPatches.Num());
+
+	// Where each Patch ended up, so the Links can be remapped to it.
+	TArray<FDWallClingPatchRef> PatchRefs;
+	PatchRefs.SetNum(Patches.Num());
+
+	for (TPair<int64, TArray<int32>>& Pair : ChunkPatches)
+	{
+		Pair.Value.Sort([this](int32 A, int32 B) { return Patches[A].Center.X < Patches[B].Center.X; });
+
+		const int32 ChunkIndex = Chunks.Num();
+		for (int32 LocalIndex = 0; LocalIndex < Pair.Value.Num(); LocalIndex++)
+		{
+			PatchRefs[Pair.Value[LocalIndex]] = FDWallClingPatchRef(ChunkIndex, LocalIndex);
+		}
+
+		FDWallClingNavChunk& Chunk = Chunks.AddZeroed_GetRef();
+		Chunk.X = (int32)(Pair.Key >> 32);
+		Chunk.Y = (int32)(uint32)Pair.Key;
+		Chunk.NumPatches = Pair.Value.Num();
+	}
+
+	// Links live in the chunk of the Patch they leave from, sorted by that Patch.
+	TArray<TArray<FDWallJumpLink>> ChunkLinks;
+	ChunkLinks.SetNum(Chunks.Num());
+
+	for (const FBuildLink& Link : Links)
+	{
+		const FDWallClingPatchRef& From = PatchRefs[Link.From];
+		const FDWallClingPatchRef& To = PatchRefs[Link.To];
+		ChunkLinks[From.Chunk].Add({ (uint32)From.Patch, (uint32)To.Chunk, (uint32)To.Patch });
+	}
+
+	int64 DataOffset = sizeof(FDWallClingNavHeader) + (int64)Chunks.Num() * sizeof(FDWallClingNavChunk);
+	for (int32 ChunkIndex = 0; ChunkIndex < Chunks.Num(); ChunkIndex++)
+	{
+		ChunkLinks[ChunkIndex].StableSort([](const FDWallJumpLink& A, const FDWallJumpLink& B) { return A.FromPatch < B.FromPatch; });
+
+		Chunks[ChunkIndex].NumLinks = ChunkLinks[ChunkIndex].Num();
+		Chunks[ChunkIndex].DataOffset = (uint32)DataOffset;
+		DataOffset += Chunks[ChunkIndex].GetDataSize();
+	}
+
+	// The offsets in the chunk table are 32 bits and the file is built in memory, so it has to fit an TArray.
+	checkf(DataOffset <= MAX_int32, TEXT("The WallCling nav data is %lld bytes, raise -PatchSize or lower -MaxLinks."), DataOffset);
+
+	FDWallClingNavHeader Header;
+	FMemory::Memzero(Header);
+	Header.Magic = DWALLCLINGNAV_MAGIC;
+	Header.Version = DWALLCLINGNAV_VERSION;
+	Header.ChunkSize = ChunkSize;
+	Header.MaxJumpDistance = MaxJumpDistance;
+	Header.NumChunks = Chunks.Num();
+
+	OutData.Reset((int32)DataOffset);
+	OutData.Append((const uint8*)&Header, sizeof(Header));
+	OutData.Append((const uint8*)Chunks.GetData(), Chunks.Num() * sizeof(FDWallClingNavChunk));
+
+	int32 ChunkIndex = 0;
+	for (const TPair<int64, TArray<int32>>& Pair : ChunkPatches)
+	{
+		for (int32 PatchIndex : Pair.Value)
+		{
+			OutData.Append((const uint8*)&Patches[PatchIndex], sizeof(FDWallClingPatch));
+		}
+
+		OutData.Append((const uint8*)ChunkLinks[ChunkIndex].GetData(), ChunkLinks[ChunkIndex].Num() * sizeof(FDWallJumpLink));
+		ChunkIndex++;
+	}
+
+	check(OutData.Num() == DataOffset);
+}
+
+FDWallClingNavData::FDWallClingNavData()
+{
+	FMemory::Memzero(Header);
+}
+
+FDWallClingNavData::~FDWallClingNavData()
+{
+	Close();
+}
+
+FString FDWallClingNavData::GetFilePath(const FString& MapName)
+{
+	return FPaths::Combine(FPaths::ProjectContentDir(), TEXT("WallJump"), FPackageName::GetShortName(MapName) + TEXT(".wjnav"));
+}
+
+bool FDWallClingNavData::Open(const FString& FilePath)
+{
+	Close();
+
+	int64 FileSize = 0;
+
+	MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FilePath));
+	if (MappedFile)
+	{
+		FileSize = MappedFile->GetFileSize();
+
+		if (FileSize >= (int64)sizeof(FDWallClingNavHeader))
+		{
+			TUniquePtr<IMappedFileRegion> HeaderRegion(MappedFile->MapRegion(0, sizeof(FDWallClingNavHeader)));
+			if (HeaderRegion)
+			{
+				FMemory::Memcpy(&Header, HeaderRegion->GetMappedPtr(), sizeof(FDWallClingNavHeader));
+			}
+		}
+	}
+	else if (FFileHelper::LoadFileToArray(FallbackData, *FilePath, FILEREAD_Silent))
+	{
+		FileSize = FallbackData.Num();
+
+		if (FileSize >= (int64)sizeof(FDWallClingNavHeader))
+		{
+			FMemory::Memcpy(&Header, FallbackData.GetData(), sizeof(FDWallClingNavHeader));
+		}
+	}
+
+	const int64 TableSize = (int64)Header.NumChunks * sizeof(FDWallClingNavChunk);
+
+	if (Header.Magic != DWALLCLINGNAV_MAGIC || Header.Version != DWALLCLINGNAV_VERSION || Header.ChunkSize <= 0.f || sizeof(FDWallClingNavHeader) + TableSize > FileSize)
+	{
+		UE_CLOG(FileSize > 0, LogDWallJump, Warning, TEXT("%s is not valid Wall Cling navigation data, rebuild it with the DWallClingNav commandlet."), *FilePath);
+		Close();
+		return false;
+	}
+
+	// The chunk table is small and searched on every query, so keep an copy rather than an mapping.
+	Chunks.SetNumUninitialized(Header.NumChunks);
+	if (TableSize > 0)
+	{
+		if (MappedFile)
+		{
+			TUniquePtr<IMappedFileRegion> TableRegion(MappedFile->MapRegion(sizeof(FDWallClingNavHeader), TableSize));
+			if (!TableRegion)
+			{
+				Close();
+				return false;
+			}
+
+			FMemory::Memcpy(Chunks.GetData(), TableRegion->GetMappedPtr(), TableSize);
+		}
+		else
+		{
+			FMemory::Memcpy(Chunks.GetData(), FallbackData.GetData() + sizeof(FDWallClingNavHeader), TableSize);
+		}
+	}
+
+	for (const FDWallClingNavChunk& Chunk : Chunks)
+	{
+		if (Chunk.DataOffset + Chunk.GetDataSize() > FileSize)
+		{
+			UE_LOG(LogDWallJump, Warning, TEXT("%s is truncated, rebuild it with the DWallClingNav commandlet."), *FilePath);
+			Close();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void FDWallClingNavData::Close()
+{
+	MappedChunks.Empty();
+	MappedFile.Reset();
+	FallbackData.Empty();
+	Chunks.Empty();
+	FMemory::Memzero(Header);
+}
+
+void FDWallClingNavData::UnloadChunks()
+{
+	MappedChunks.Empty();
+}
+
+int32 FDWallClingNavData::FindChunkByKey(int64 Key) const
+{
+	const int32 Index = Algo::LowerBoundBy(Chunks, Key, [](const FDWallClingNavChunk& Chunk) { return Chunk.GetKey(); });
+	return Chunks.IsValidIndex(Index) && Chunks[Index].GetKey() == Key ? Index : INDEX_NONE;
+}
+
+int32 FDWallClingNavData::FindChunk(const FVector& Location) const
+{
+	if (!IsOpen())
+	{
+		return INDEX_NONE;
+	}
+
+	return FindChunkByKey(FDWallClingNavChunk::MakeKey(FMath::FloorToInt(Location.X / Header.ChunkSize), FMath::FloorToInt(Location.Y / Header.ChunkSize)));
+}
+
+const uint8* FDWallClingNavData::GetChunkData(int32 ChunkIndex)
+{
+	const FDWallClingNavChunk& Chunk = Chunks[ChunkIndex];
+	if (Chunk.GetDataSize() == 0)
+	{
+		return nullptr;
+	}
+
+	if (!MappedFile)
+	{
+		return FallbackData.GetData() + Chunk.DataOffset;
+	}
+
+	TUniquePtr<IMappedFileRegion>& Region = MappedChunks.FindOrAdd(ChunkIndex);
+	if (!Region)
+	{
+		Region.Reset(MappedFile->MapRegion(Chunk.DataOffset, Chunk.GetDataSize()));
+	}
+
+	return Region ? Region->GetMappedPtr() : nullptr;
+}
+
+void FDWallClingNavData::FindPatches(const FVector& Location, float Radius, TArray<FDWallClingPatchRef>& OutPatches)
+{
+	if (!IsOpen())
+	{
+		return;
+	}
+
+	const float RadiusSquared = FMath::Square(Radius);
+
+	const int32 MinX = FMath::FloorToInt((Location.X - Radius) / Header.ChunkSize);
+	const int32 MaxX = FMath::FloorToInt((Location.X + Radius) / Header.ChunkSize);
+	const int32 MinY = FMath::FloorToInt((Location.Y - Radius) / Header.ChunkSize);
+	const int32 MaxY = FMath::FloorToInt((Location.Y + Radius) / Header.ChunkSize);
+
+	for (int32 ChunkX = MinX; ChunkX <= MaxX; ChunkX++)
+	{
+		for (int32 ChunkY = MinY; ChunkY <= MaxY; ChunkY++)
+		{
+			const int32 ChunkIndex = FindChunkByKey(FDWallClingNavChunk::MakeKey(ChunkX, ChunkY));
+			if (ChunkIndex == INDEX_NONE)
+			{
+				continue;
+			}
+
+			const FDWallClingPatch* Patches = (const FDWallClingPatch*)GetChunkData(ChunkIndex);
+			if (!Patches)
+			{
+				continue;
+			}
+
+			const TArrayView<const FDWallClingPatch> PatchView(Patches, Chunks[ChunkIndex].NumPatches);
+
+			for (int32 PatchIndex = Algo::LowerBoundBy(PatchView, Location.X - Radius, [](const FDWallClingPatch& Patch) { return Patch.Center.X; }); PatchIndex < PatchView.Num(); PatchIndex++)
+			{
+				const FDWallClingPatch& Patch = PatchView[PatchIndex];
+				if (Patch.Center.X > Location.X + Radius)
+				{
+					break;
+				}
+
+				if (FVector::DistSquared(Patch.Center, Location) <= RadiusSquared)
+				{
+					OutPatches.Add(FDWallClingPatchRef(ChunkIndex, PatchIndex));
+				}
+			}
+		}
+	}
+}
+
+const FDWallClingPatch* FDWallClingNavData::GetPatch(const FDWallClingPatchRef& PatchRef)
+{
+	if (!PatchRef.IsValid() || !Chunks.IsValidIndex(PatchRef.Chunk) || (uint32)PatchRef.Patch >= Chunks[PatchRef.Chunk].NumPatches)
+	{
+		return nullptr;
+	}
+
+	const FDWallClingPatch* Patches = (const FDWallClingPatch*)GetChunkData(PatchRef.Chunk);
+	return Patches ? Patches + PatchRef.Patch : nullptr;
+}
+
+const FDWallJumpLink* FDWallClingNavData::GetLinks(const FDWallClingPatchRef& PatchRef, int32& OutNumLinks)
+{
+	OutNumLinks = 0;
+
+	if (!PatchRef.IsValid() || !Chunks.IsValidIndex(PatchRef.Chunk))
+	{
+		return nullptr;
+	}
+
+	const FDWallClingNavChunk& Chunk = Chunks[PatchRef.Chunk];
+	const uint8* Data = GetChunkData(PatchRef.Chunk);
+	if (!Data || Chunk.NumLinks == 0)
+	{
+		return nullptr;
+	}
+
+	const TArrayView<const FDWallJumpLink> LinkView((const FDWallJumpLink*)(Data + Chunk.NumPatches * sizeof(FDWallClingPatch)), Chunk.NumLinks);
+
+	const int32 First = Algo::LowerBoundBy(LinkView, (uint32)PatchRef.Patch, [](const FDWallJumpLink& Link) { return Link.FromPatch; });
+	const int32 Last = Algo::UpperBoundBy(LinkView, (uint32)PatchRef.Patch, [](const FDWallJumpLink& Link) { return Link.FromPatch; });
+
+	OutNumLinks = Last - First;
+	return OutNumLinks > 0 ? &LinkView[First] : nullptr;
+}
@@ -0,0 +1,227 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Baked Wall Cling navigation data, written by UDWallClingNavCommandlet and read by FDWallClingNavData.
+ *
+ * The file is an FDWallClingNavHeader followed by an table of FDWallClingNavChunk sorted by their chunk coordinates.
+ * Each chunk points at its own block of FDWallClingPatch sorted by X, followed by its FDWallJumpLink sorted by the Patch they leave from.
+ * Everything is plain old data laid out exactly as it is in memory so chunks can be used straight out of an memory mapped region.
+ */
+
+#define DWALLCLINGNAV_MAGIC 0x4E434A57 // WJCN
+#define DWALLCLINGNAV_VERSION 1
+
+struct FDWallClingNavHeader
+{
+	uint32 Magic;
+	uint32 Version;
+
+	/* The size of an chunk on the X and Y axes. */
+	float ChunkSize;
+
+	/* How far apart two Patches can be and still be linked, from the WallJumpMagnitude the data was baked with. */
+	float MaxJumpDistance;
+
+	uint32 NumChunks;
+	uint32 Pad;
+};
+
+struct FDWallClingNavChunk
+{
+	int32 X;
+	int32 Y;
+
+	/* Offset of the chunks Patches from the start of the file, its Links follow straight after. */
+	uint32 DataOffset;
+
+	uint32 NumPatches;
+	uint32 NumLinks;
+	uint32 Pad;
+
+	FORCEINLINE int64 GetKey() const { return MakeKey(X, Y); }
+
+	static FORCEINLINE int64 MakeKey(int32 InX, int32 InY) { return ((int64)InX << 32) | (uint32)InY; }
+
+	/* Size of the chunks Patches and Links, in 64 bits as an corrupt chunk table can hold counts whose size doesnt fit in 32. */
+	FORCEINLINE int64 GetDataSize() const;
+};
+
+/* An clingable patch of an static Surface. */
+struct FDWallClingPatch
+{
+	FVector Center;
+
+	/* The Surface normal quantized to 16 bits per axis. */
+	int16 Normal[3];
+
+	/* Half the width and height of the Patch along the Surface. */
+	uint16 HalfWidth;
+	uint16 HalfHeight;
+
+	/* EDWallSurfaceFlags of the Surface. */
+	uint16 Flags;
+
+	FORCEINLINE FVector GetNormal() const { return FVector(Normal[0], Normal[1], Normal[2]) * (1.f / MAX_int16); }
+};
+
+/* An WallJump that can get an Character from one Patch to another. */
+struct FDWallJumpLink
+{
+	/* Index of the Patch in this chunk the Link leaves from. */
+	uint32 FromPatch;
+
+	/* Index in the chunk table and of the Patch in that chunk the Link lands on. */
+	uint32 ToChunk;
+	uint32 ToPatch;
+};
+
+static_assert(sizeof(FDWallClingNavHeader) == 24, "FDWallClingNavHeader is read straight from the file.");
+static_assert(sizeof(FDWallClingNavChunk) == 24, "FDWallClingNavChunk is read straight from the file.");
+static_assert(sizeof(FDWallClingPatch) == 24, "FDWallClingPatch is read straight from the file.");
+static_assert(sizeof(FDWallJumpLink) == 12, "FDWallJumpLink is read straight from the file.");
+
+FORCEINLINE int64 FDWallClingNavChunk::GetDataSize() const
+{
+	return (int64)NumPatches * sizeof(FDWallClingPatch) + (int64)NumLinks * sizeof(FDWallJumpLink);
+}
+
+/* Identifies an Patch in an FDWallClingNavData. */
+struct FDWallClingPatchRef
+{
+	int32 Chunk;
+	int32 Patch;
+
+	FDWallClingPatchRef()
+		: Chunk(INDEX_NONE)
+		, Patch(INDEX_NONE)
+	{
+	}
+
+	FDWallClingPatchRef(int32 InChunk, int32 InPatch)
+		: Chunk(InChunk)
+		, Patch(InPatch)
+	{
+	}
+
+	FORCEINLINE bool IsValid() const { return Chunk != INDEX_NONE && Patch != INDEX_NONE; }
+
+	FORCEINLINE bool operator==(const FDWallClingPatchRef& Other) const { return Chunk == Other.Chunk && Patch == Other.Patch; }
+};
+
+/* Gathers Patches, links them and writes them out in the baked format. */
+class DIGNITY_API FDWallClingNavDataBuilder
+{
+public:
+
+	FDWallClingNavDataBuilder(float InChunkSize, float InMaxJumpDistance, float InMaxJumpHeight);
+
+	void AddPatch(const FVector& Center, const FVector& Normal, float HalfWidth, float HalfHeight, uint16 Flags);
+
+	/**
+	 * Links every Patch to the Patches an WallJump from it could reach.
+	 * The Character has to be Launched away from the Surface it is on towards an Surface that faces back at it, no further than MaxJumpDistance and no higher than MaxJumpHeight.
+	 *
+	 * @param	MaxLinksPerPatch	Only the closest Patches are kept.
+	 */
+	void BuildLinks(int32 MaxLinksPerPatch = 16);
+
+	/* Writes the baked data, chunked and sorted. */
+	void Write(TArray<uint8>& OutData) const;
+
+	FORCEINLINE int32 NumPatches() const { return Patches.Num(); }
+	FORCEINLINE int32 NumLinks() const { return Links.Num(); }
+
+private:
+
+	struct FBuildLink
+	{
+		int32 From;
+		int32 To;
+	};
+
+	float ChunkSize;
+	float MaxJumpDistance;
+	float MaxJumpHeight;
+
+	TArray<FDWallClingPatch> Patches;
+	TArray<FBuildLink> Links;
+
+	FIntPoint GetChunkCoords(const FVector& Location) const;
+};
+
+/**
+ * Read only access to baked Wall Cling navigation data.
+ * The file is memory mapped and each chunk is only mapped the first time something queries it, platforms that cant map files read it into memory instead.
+ * Finding an chunk is an binary search of the chunk table and finding Patches within it an binary search on X, so queries are O(log n) in the number of chunks and Patches.
+ * Queries map chunks as they go, so they are only safe from one thread at an time.
+ */
+class DIGNITY_API FDWallClingNavData
+{
+public:
+
+	FDWallClingNavData();
+	~FDWallClingNavData();
+
+	/**
+	 * Where the data for an map is baked to, Content/WallJump/<MapName>.wjnav.
+	 * Add Content/WallJump to DirectoriesToAlwaysStageAsNonUFS so the files are staged loose and can still be mapped in an packaged game.
+	 */
+	static FString GetFilePath(const FString& MapName);
+
+	/* Opens the baked data at FilePath, only the header and chunk table are read. */
+	bool Open(const FString& FilePath);
+
+	void Close();
+
+	FORCEINLINE bool IsOpen() const { return Header.Magic == DWALLCLINGNAV_MAGIC; }
+
+	FORCEINLINE const FDWallClingNavHeader& GetHeader() const { return Header; }
+
+	FORCEINLINE int32 NumChunks() const { return Chunks.Num(); }
+
+	FORCEINLINE const FDWallClingNavChunk& GetChunk(int32 ChunkIndex) const { return Chunks[ChunkIndex]; }
+
+	/* Returns the index of the chunk that holds Location, INDEX_NONE if there is no data there. */
+	int32 FindChunk(const FVector& Location) const;
+
+	/* Finds every Patch whose Center is within Radius of Location. */
+	void FindPatches(const FVector& Location, float Radius, TArray<FDWallClingPatchRef>& OutPatches);
+
+	/* Returns the Patch, mapping its chunk if it hasnt been yet. */
+	const FDWallClingPatch* GetPatch(const FDWallClingPatchRef& PatchRef);
+
+	/**
+	 * Returns the WallJump Links leaving the Patch.
+	 *
+	 * @param	OutNumLinks	How many Links the returned pointer points to.
+	 */
+	const FDWallJumpLink* GetLinks(const FDWallClingPatchRef& PatchRef, int32& OutNumLinks);
+
+	/* Unmaps every chunk, they are mapped again the next time they are queried. */
+	void UnloadChunks();
+
+private:
+
+	FDWallClingNavHeader Header;
+
+	/* The chunk table, sorted by chunk key. */
+	TArray<FDWallClingNavChunk> Chunks;
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+
+	/* The mapped region of each chunk that has been queried. */
+	TMap<int32, TUniquePtr<IMappedFileRegion>> MappedChunks;
+
+	/* The whole file on platforms that cant map it. */
+	TArray<uint8> FallbackData;
+
+	/* Returns the start of the chunks data, mapping it if needed. */
+	const uint8* GetChunkData(int32 ChunkIndex);
+
+	int32 FindChunkByKey(int64 Key) const;
+};
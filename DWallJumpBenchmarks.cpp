@@ -0,0 +1,920 @@
+#include "Dignity.h"
+#include "DWallJumpComponent.h"
+#include "DWallJumpCore.h"
+#include "DWallJumpStats.h"
+#include "DWallJumpHitStream.h"
+#include "DWallJumpSubsystem.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SceneComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Math/RandomStream.h"
+#include "TimerManager.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectIterator.h"
+
+#if !UE_BUILD_SHIPPING && DIGNITY_DEVELOPMENT
+/* What every WallJump benchmark shares, so they all take their counts and time and log their results the same way. */
+struct FDWallJumpBenchmark
+{
+	/* The count at Index in the console Args, at least 1, or Default if it wasnt given. */
+	static int32 GetCountArg(const TArray<FString>& Args, int32 Index, int32 Default)
+	{
+		return Args.IsValidIndex(Index) ? FMath::Max(FCString::Atoi(*Args[Index]), 1) : Default;
+	}
+
+	/* Runs Body once and returns what it cost in nanoseconds for each of the NumOperations it performed. */
+	template<typename FunctionType>
+	static double TimeNanoseconds(double NumOperations, FunctionType&& Body)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		Body();
+		const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+		return Seconds * 1000000000.0 / FMath::Max(NumOperations, 1.0);
+	}
+
+	/* Fills OutCandidates with Num random Hits from an fixed Seed, so every run evaluates the same ones, with the default Tunings Cling bounds. */
+	static void GenerateRandomCandidates(int32 Num, int32 Seed, TArray<FDWallHitCandidate>& OutCandidates)
+	{
+		FRandomStream Random(Seed);
+		OutCandidates.SetNum(Num);
+		for (FDWallHitCandidate& Candidate : OutCandidates)
+		{
+			Candidate.Intent = Random.FRand() < 0.5f ? EDWallHitIntent::Cling : EDWallHitIntent::Jump;
+			Candidate.SurfaceNormal = FVector(Random.FRandRange(-1.f, 1.f), Random.FRandRange(-1.f, 1.f), Random.FRandRange(-0.2f, 0.2f)).GetSafeNormal();
+			Candidate.CharacterForward = FVector(Random.FRandRange(-1.f, 1.f), Random.FRandRange(-1.f, 1.f), 0.f).GetSafeNormal();
+			Candidate.CharacterSpeed = Random.FRandRange(0.f, 1000.f);
+			Candidate.LaunchVelocity = Random.GetUnitVector() * 1000.f;
+			Candidate.MinPitchSurfaceAngleCos = FMath::Cos(FMath::DegreesToRadians(44.f));
+			Candidate.MaxPitchSurfaceAngleCos = FMath::Cos(FMath::DegreesToRadians(135.f));
+			Candidate.MaxYawSurfaceAngleCos = FMath::Cos(FMath::DegreesToRadians(45.f));
+			Candidate.MinSpeed = 300.f;
+		}
+	}
+
+	/* Builds the single line an benchmark logs its results on, "<Name>: <Setup>. <Label>: <N> ns per <Operation>." for each timing. */
+	struct FResults
+	{
+		FString Line;
+
+		FResults(const TCHAR* Name, const FString& Setup)
+			: Line(FString::Printf(TEXT("%s: %s."), Name, *Setup))
+		{
+		}
+
+		FResults& Add(const TCHAR* Label, double Nanoseconds, const TCHAR* Operation)
+		{
+			Line += FString::Printf(TEXT(" %s: %.2f ns per %s."), Label, Nanoseconds, Operation);
+			return *this;
+		}
+
+		/* Anything else worth logging, the checksums that keep the timed loops from being optimized away for example. */
+		FResults& AddNote(const FString& Note)
+		{
+			Line += TEXT(" ");
+			Line += Note;
+			return *this;
+		}
+
+		void Log() const
+		{
+			UE_LOG(LogDWallJump, Log, TEXT("%s"), *Line);
+		}
+	};
+};
+
+/**
+ * An idle WJC as TickComponent() handled it before WJCs stopped Ticking while idle.
+ * It Ticked every frame just to find out it wasnt Clung, which is all an idle Tick did, so that is all this keeps of it.
+ */
+static FORCENOINLINE bool TickIdleAsBefore(UDWallJumpComponent* WallJumpComponent, const ACharacter* OwningCharacter, float DeltaTime)
+{
+	WallJumpComponent->UActorComponent::TickComponent(DeltaTime, LEVELTICK_All, nullptr);
+
+	// CheckWallClingJump() as it was, OwningCharacter was cached then and is resolved up front here.
+	if (OwningCharacter->Role == ROLE_AutonomousProxy || (OwningCharacter->Role == ROLE_Authority && OwningCharacter->GetRemoteRole() < ROLE_AutonomousProxy))
+	{
+		return WallJumpComponent->IsClungToWall() && WallJumpComponent->bCanWallJump;
+	}
+
+	return false;
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CmdWallJumpIdleTickBenchmark(
+	TEXT("dignity.WallJump.IdleTickBenchmark"),
+	TEXT("Ticks every idle WJC in the World the way TickComponent() used to every frame, for an number of frames, default 1000, and logs what that cost per frame against the WJCs that still Tick now. Optionally takes an WJC count to project the cost to, default 100."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 NumFrames = FDWallJumpBenchmark::GetCountArg(Args, 0, 1000);
+		const int32 NumProjected = FDWallJumpBenchmark::GetCountArg(Args, 1, 100);
+
+		TArray<UDWallJumpComponent*> IdleComponents;
+		TArray<const ACharacter*> IdleCharacters;
+		TArray<UDWallJumpComponent*> TickingComponents;
+		for (TObjectIterator<UDWallJumpComponent> It; It; ++It)
+		{
+			UDWallJumpComponent* WallJumpComponent = *It;
+			const ACharacter* Character = Cast<ACharacter>(WallJumpComponent->GetOwner());
+			if (Character && WallJumpComponent->GetWorld() == World && !WallJumpComponent->IsTemplate() && WallJumpComponent->IsRegistered() && !WallJumpComponent->IsClungToWall())
+			{
+				IdleComponents.Add(WallJumpComponent);
+				IdleCharacters.Add(Character);
+
+				if (WallJumpComponent->IsComponentTickEnabled())
+				{
+					TickingComponents.Add(WallJumpComponent);
+				}
+			}
+		}
+
+		if (IdleComponents.Num() == 0)
+		{
+			UE_LOG(LogDWallJump, Warning, TEXT("IdleTickBenchmark needs an idle WJC owned by an Character in the World to Tick."));
+			return;
+		}
+
+		const float DeltaTime = World->GetDeltaSeconds();
+		int32 NumClung = 0;
+
+		const double BeforeNanoseconds = FDWallJumpBenchmark::TimeNanoseconds((double)NumFrames * IdleComponents.Num(), [&]()
+		{
+			for (int32 Frame = 0; Frame < NumFrames; Frame++)
+			{
+				for (int32 Index = 0; Index < IdleComponents.Num(); Index++)
+				{
+					NumClung += TickIdleAsBefore(IdleComponents[Index], IdleCharacters[Index], DeltaTime) ? 1 : 0;
+				}
+			}
+		});
+
+		// An idle WJC should have disabled its Tick, any that havent are timed with the Tick they run now.
+		double NowNanoseconds = 0.0;
+		if (TickingComponents.Num() > 0)
+		{
+			NowNanoseconds = FDWallJumpBenchmark::TimeNanoseconds((double)NumFrames * TickingComponents.Num(), [&]()
+			{
+				for (int32 Frame = 0; Frame < NumFrames; Frame++)
+				{
+					for (UDWallJumpComponent* WallJumpComponent : TickingComponents)
+					{
+						WallJumpComponent->TickComponent(DeltaTime, LEVELTICK_All, nullptr);
+					}
+				}
+			});
+		}
+
+		FDWallJumpBenchmark::FResults(TEXT("IdleTickBenchmark"), FString::Printf(TEXT("%d idle WJCs, %d of them still Ticking, %d frames"), IdleComponents.Num(), TickingComponents.Num(), NumFrames))
+			.Add(TEXT("Before, every idle WJC"), BeforeNanoseconds * IdleComponents.Num(), TEXT("frame"))
+			.Add(*FString::Printf(TEXT("Before, %d WJCs"), NumProjected), BeforeNanoseconds * NumProjected, TEXT("frame"))
+			.Add(TEXT("Now"), NowNanoseconds * TickingComponents.Num(), TEXT("frame"))
+			.AddNote(FString::Printf(TEXT("(%d)"), NumClung))
+			.Log();
+	}));
+
+static FAutoConsoleCommand CmdWallJumpBatchScalingBenchmark(
+	TEXT("dignity.WallJump.BatchScalingBenchmark"),
+	TEXT("Evaluates 1, 100, 1000 and 10000 WJCs worth of Hits one at an time, as an FDWallHitBatch and as an parallel FDWallHitBatch, and logs the cost per WJC of each."),
+	FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+	{
+		const int32 AgentCounts[] = { 1, 100, 1000, 10000 };
+
+		// Each count is evaluated this many times in total, so the small counts are repeated enough to measure.
+		const int32 NumEvaluations = 1000000;
+
+		TArray<FDWallHitCandidate> Candidates;
+		FDWallJumpBenchmark::GenerateRandomCandidates(AgentCounts[ARRAY_COUNT(AgentCounts) - 1], 0x57A11, Candidates);
+
+		FDWallHitBatch Batch;
+		for (const int32 NumAgents : AgentCounts)
+		{
+			const int32 NumRepeats = FMath::Max(NumEvaluations / NumAgents, 1);
+			const double NumEvaluated = (double)NumAgents * NumRepeats;
+			int32 NumAccepted = 0;
+
+			const double SingleNanoseconds = FDWallJumpBenchmark::TimeNanoseconds(NumEvaluated, [&]()
+			{
+				for (int32 Repeat = 0; Repeat < NumRepeats; Repeat++)
+				{
+					for (int32 Index = 0; Index < NumAgents; Index++)
+					{
+						NumAccepted += FDWallJumpCore::EvaluateCandidate(Candidates[Index]).bIsPitchValid;
+					}
+				}
+			});
+
+			// The batch is filled every time, the same as the UDWallJumpSubsystem does every frame.
+			const double BatchNanoseconds = FDWallJumpBenchmark::TimeNanoseconds(NumEvaluated, [&]()
+			{
+				for (int32 Repeat = 0; Repeat < NumRepeats; Repeat++)
+				{
+					Batch.Reset();
+					for (int32 Index = 0; Index < NumAgents; Index++)
+					{
+						Batch.Add(Candidates[Index]);
+					}
+					Batch.Evaluate();
+					NumAccepted += Batch.PitchValid[0];
+				}
+			});
+
+			const double ParallelNanoseconds = FDWallJumpBenchmark::TimeNanoseconds(NumEvaluated, [&]()
+			{
+				for (int32 Repeat = 0; Repeat < NumRepeats; Repeat++)
+				{
+					Batch.Reset();
+					for (int32 Index = 0; Index < NumAgents; Index++)
+					{
+						Batch.Add(Candidates[Index]);
+					}
+					Batch.EvaluateParallel();
+					NumAccepted += Batch.PitchValid[0];
+				}
+			});
+
+			FDWallJumpBenchmark::FResults(TEXT("BatchScalingBenchmark"), FString::Printf(TEXT("%d WJCs"), NumAgents))
+				.Add(TEXT("One at an time"), SingleNanoseconds, TEXT("WJC"))
+				.Add(TEXT("Batch"), BatchNanoseconds, TEXT("WJC"))
+				.Add(TEXT("Parallel Batch"), ParallelNanoseconds, TEXT("WJC"))
+				.AddNote(FString::Printf(TEXT("(%d)"), NumAccepted))
+				.Log();
+		}
+	}));
+
+static FAutoConsoleCommand CmdWallJumpAIBatchBenchmark(
+	TEXT("dignity.WallJump.AIBatchBenchmark"),
+	TEXT("Evaluates AI batches of 8 up to 8192 requests on the Game thread and on the task graph the way the UDWallJumpSubsystem dispatches them, and logs what each costs the Game thread per request. ")
+	TEXT("The smallest batch the task graph wins at is where to set AIBatchMinDispatchSize. Usage: dignity.WallJump.AIBatchBenchmark [MinBatchSize]."),
+	FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+	{
+		const int32 BatchSizes[] = { 8, 32, 128, 512, 2048, 8192 };
+		const int32 MinBatchSize = FDWallJumpBenchmark::GetCountArg(Args, 0, GetDefault<UDWallJumpSubsystem>()->AIBatchMinSize);
+
+		// Each size is evaluated this many times in total, so the small batches are repeated enough to measure.
+		const int32 NumEvaluations = 1000000;
+
+		TArray<FDWallHitCandidate> Candidates;
+		FDWallJumpBenchmark::GenerateRandomCandidates(BatchSizes[ARRAY_COUNT(BatchSizes) - 1], 0x57A11, Candidates);
+
+		FDWallHitBatch Batch;
+		for (const int32 BatchSize : BatchSizes)
+		{
+			Batch.Reset();
+			for (int32 Index = 0; Index < BatchSize; Index++)
+			{
+				Batch.Add(Candidates[Index]);
+			}
+
+			const int32 NumRepeats = FMath::Max(NumEvaluations / BatchSize, 1);
+			const double NumEvaluated = (double)BatchSize * NumRepeats;
+			int32 NumAccepted = 0;
+
+			const double InlineNanoseconds = FDWallJumpBenchmark::TimeNanoseconds(NumEvaluated, [&]()
+			{
+				for (int32 Repeat = 0; Repeat < NumRepeats; Repeat++)
+				{
+					Batch.Evaluate();
+					NumAccepted += Batch.PitchValid[0];
+				}
+			});
+
+			// Dispatched and waited for straight away, the most the Game thread pays when the task has had no time to run.
+			const double WaitedNanoseconds = FDWallJumpBenchmark::TimeNanoseconds(NumEvaluated, [&]()
+			{
+				for (int32 Repeat = 0; Repeat < NumRepeats; Repeat++)
+				{
+					FGraphEventRef Task = FFunctionGraphTask::CreateAndDispatchWhenReady([&Batch, MinBatchSize]()
+					{
+						Batch.EvaluateParallel(MinBatchSize);
+					}, TStatId(), nullptr, ENamedThreads::AnyHiPriThreadNormalTask);
+
+					FTaskGraphInterface::Get().WaitUntilTaskCompletes(Task, ENamedThreads::GameThread);
+					NumAccepted += Batch.PitchValid[0];
+				}
+			});
+
+			// Only the dispatch, the least the Game thread pays when the task finishes during the rest of the frame.
+			double DispatchSeconds = 0.0;
+			for (int32 Repeat = 0; Repeat < NumRepeats; Repeat++)
+			{
+				const double StartTime = FPlatformTime::Seconds();
+				FGraphEventRef Task = FFunctionGraphTask::CreateAndDispatchWhenReady([&Batch, MinBatchSize]()
+				{
+					Batch.EvaluateParallel(MinBatchSize);
+				}, TStatId(), nullptr, ENamedThreads::AnyHiPriThreadNormalTask);
+				DispatchSeconds += FPlatformTime::Seconds() - StartTime;
+
+				FTaskGraphInterface::Get().WaitUntilTaskCompletes(Task, ENamedThreads::GameThread);
+				NumAccepted += Batch.PitchValid[0];
+			}
+
+			FDWallJumpBenchmark::FResults(TEXT("AIBatchBenchmark"), FString::Printf(TEXT("%d requests, MinBatchSize %d"), BatchSize, MinBatchSize))
+				.Add(TEXT("Game thread"), InlineNanoseconds, TEXT("request"))
+				.Add(TEXT("Task dispatched and waited for"), WaitedNanoseconds, TEXT("request"))
+				.Add(TEXT("Task dispatch only"), DispatchSeconds * 1000000000.0 / NumEvaluated, TEXT("request"))
+				.AddNote(FString::Printf(TEXT("(%d)"), NumAccepted))
+				.Log();
+		}
+	}));
+
+/* What an scripted agent in the DeadlineStressBenchmark does on an frame. */
+enum class EDWallJumpStressAction : uint8
+{
+	None,
+	Cling,
+	Jump
+};
+
+static FAutoConsoleCommand CmdWallJumpDeadlineStressBenchmark(
+	TEXT("dignity.WallJump.DeadlineStressBenchmark"),
+	TEXT("Scripts an number of agents, default 1000, Clinging and Jumping for an number of frames, default 600, and logs the cost per frame of tracking their Cling and grace period with FTimerManager timers as WJCs used to against the deadlines they use now."),
+	FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+	{
+		const int32 NumAgents = FDWallJumpBenchmark::GetCountArg(Args, 0, 1000);
+		const int32 NumFrames = FDWallJumpBenchmark::GetCountArg(Args, 1, 600);
+		const float DeltaTime = 1.f / 60.f;
+		const float ClingDuration = 5.f;
+		const float GracePeriodDuration = 0.5f;
+
+		// Script every agent up front so both runs do exactly the same Clings and Jumps, and only the tracking is timed.
+		FRandomStream Random(0x57A11);
+		TArray<EDWallJumpStressAction> Actions;
+		Actions.SetNumZeroed(NumAgents * NumFrames);
+		TArray<float> ScriptReleaseTimes;
+		ScriptReleaseTimes.SetNumZeroed(NumAgents);
+		int32 NumActions = 0;
+
+		for (int32 Frame = 0; Frame < NumFrames; Frame++)
+		{
+			const float Time = Frame * DeltaTime;
+			for (int32 Agent = 0; Agent < NumAgents; Agent++)
+			{
+				float& ReleaseTime = ScriptReleaseTimes[Agent];
+				if (ReleaseTime > 0.f && Time >= ReleaseTime)
+				{
+					ReleaseTime = 0.f;
+				}
+
+				EDWallJumpStressAction& Action = Actions[Frame * NumAgents + Agent];
+				if (ReleaseTime == 0.f && Random.FRand() < 0.02f)
+				{
+					Action = EDWallJumpStressAction::Cling;
+					ReleaseTime = Time + ClingDuration;
+					NumActions++;
+				}
+				else if (ReleaseTime > 0.f && Random.FRand() < 0.05f)
+				{
+					Action = EDWallJumpStressAction::Jump;
+					ReleaseTime = 0.f;
+					NumActions++;
+				}
+			}
+		}
+
+		// The timers need an UFunction to bind to by name as WJCs used to, an unregistered WJC makes an harmless target for the ones that fire.
+		UDWallJumpComponent* TimerTarget = NewObject<UDWallJumpComponent>(GetTransientPackage());
+		const FName TimerFunctionName = GET_FUNCTION_NAME_CHECKED(UDWallJumpComponent, ResetHitStats);
+
+		FTimerManager TimerManager;
+		TArray<FTimerHandle> ClingTimerHandles;
+		TArray<FTimerHandle> GracePeriodTimerHandles;
+		ClingTimerHandles.SetNum(NumAgents);
+		GracePeriodTimerHandles.SetNum(NumAgents);
+
+		const double TimerNanoseconds = FDWallJumpBenchmark::TimeNanoseconds(NumFrames, [&]()
+		{
+			for (int32 Frame = 0; Frame < NumFrames; Frame++)
+			{
+				for (int32 Agent = 0; Agent < NumAgents; Agent++)
+				{
+					const EDWallJumpStressAction Action = Actions[Frame * NumAgents + Agent];
+					if (Action == EDWallJumpStressAction::Cling)
+					{
+						FTimerDelegate ReleaseWallClingTimerDelegate;
+						ReleaseWallClingTimerDelegate.BindUFunction(TimerTarget, TimerFunctionName);
+						TimerManager.SetTimer(ClingTimerHandles[Agent], ReleaseWallClingTimerDelegate, ClingDuration, false);
+					}
+					else if (Action == EDWallJumpStressAction::Jump)
+					{
+						TimerManager.SetTimer(ClingTimerHandles[Agent], nullptr, -1.f, false);
+						TimerManager.SetTimer(GracePeriodTimerHandles[Agent], TimerTarget, &UDWallJumpComponent::ResetHitStats, GracePeriodDuration, false);
+					}
+				}
+
+				TimerManager.Tick(DeltaTime);
+			}
+		});
+
+		TimerManager.ClearAllTimersForObject(TimerTarget);
+
+		// The same two deadlines every WJC keeps, checked only by the agents that have one running as the WJC only Ticks while it does.
+		TArray<float> ReleaseTimes;
+		TArray<float> GracePeriodEndTimes;
+		TArray<int32> ActiveAgents;
+		ReleaseTimes.SetNumZeroed(NumAgents);
+		GracePeriodEndTimes.SetNumZeroed(NumAgents);
+		ActiveAgents.Reserve(NumAgents);
+		int32 NumExpired = 0;
+
+		const double DeadlineNanoseconds = FDWallJumpBenchmark::TimeNanoseconds(NumFrames, [&]()
+		{
+			for (int32 Frame = 0; Frame < NumFrames; Frame++)
+			{
+				const float Time = Frame * DeltaTime;
+				for (int32 Agent = 0; Agent < NumAgents; Agent++)
+				{
+					const EDWallJumpStressAction Action = Actions[Frame * NumAgents + Agent];
+					if (Action == EDWallJumpStressAction::Cling)
+					{
+						ReleaseTimes[Agent] = Time + ClingDuration;
+						ActiveAgents.AddUnique(Agent);
+					}
+					else if (Action == EDWallJumpStressAction::Jump)
+					{
+						ReleaseTimes[Agent] = 0.f;
+						GracePeriodEndTimes[Agent] = Time + GracePeriodDuration;
+						ActiveAgents.AddUnique(Agent);
+					}
+				}
+
+				for (int32 Index = ActiveAgents.Num() - 1; Index >= 0; Index--)
+				{
+					const int32 Agent = ActiveAgents[Index];
+					if (GracePeriodEndTimes[Agent] > 0.f && Time >= GracePeriodEndTimes[Agent])
+					{
+						GracePeriodEndTimes[Agent] = 0.f;
+						NumExpired++;
+					}
+
+					if (ReleaseTimes[Agent] > 0.f && Time >= ReleaseTimes[Agent])
+					{
+						ReleaseTimes[Agent] = 0.f;
+						NumExpired++;
+					}
+
+					if (ReleaseTimes[Agent] == 0.f && GracePeriodEndTimes[Agent] == 0.f)
+					{
+						ActiveAgents.RemoveAtSwap(Index);
+					}
+				}
+			}
+		});
+
+		FDWallJumpBenchmark::FResults(TEXT("DeadlineStressBenchmark"), FString::Printf(TEXT("%d agents, %d frames, %d Clings and Jumps, %d deadlines expired"), NumAgents, NumFrames, NumActions, NumExpired))
+			.Add(TEXT("Timers"), TimerNanoseconds, TEXT("frame"))
+			.Add(TEXT("Deadlines"), DeadlineNanoseconds, TEXT("frame"))
+			.Log();
+	}));
+
+static FAutoConsoleCommand CmdWallJumpEventBroadcastBenchmark(
+	TEXT("dignity.WallJump.EventBroadcastBenchmark"),
+	TEXT("Broadcasts an WJC event to 10 native listeners and to 10 Blueprint delegate listeners an number of times, default 100000, and logs the cost of an broadcast to each."),
+	FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+	{
+		const int32 NumBroadcasts = FDWallJumpBenchmark::GetCountArg(Args, 0, 100000);
+		const int32 NumListeners = 10;
+
+		FOnWallJumpEventNative NativeEvent;
+		int32 NumNativeCalls = 0;
+		for (int32 Index = 0; Index < NumListeners; Index++)
+		{
+			NativeEvent.AddLambda([&NumNativeCalls](const FDWallJumpEvent& Event) { NumNativeCalls += Event.Type == EDWallJumpEventType::Jumped ? 1 : 0; });
+		}
+
+		// Every Blueprint listener is an UFunction called through ProcessEvent, unregistered WJCs make harmless ones.
+		FOnJumpedFromWall BlueprintEvent;
+		for (int32 Index = 0; Index < NumListeners; Index++)
+		{
+			FScriptDelegate Listener;
+			Listener.BindUFunction(NewObject<UDWallJumpComponent>(GetTransientPackage()), GET_FUNCTION_NAME_CHECKED(UDWallJumpComponent, ResetHitStats));
+			BlueprintEvent.Add(Listener);
+		}
+
+		FDWallJumpEvent Event(EDWallJumpEventType::Jumped);
+		Event.LaunchVelocity = FVector(0.f, 0.f, 1000.f);
+
+		const double NativeNanoseconds = FDWallJumpBenchmark::TimeNanoseconds(NumBroadcasts, [&]()
+		{
+			for (int32 Index = 0; Index < NumBroadcasts; Index++)
+			{
+				NativeEvent.Broadcast(Event);
+			}
+		});
+
+		const double BlueprintNanoseconds = FDWallJumpBenchmark::TimeNanoseconds(NumBroadcasts, [&]()
+		{
+			for (int32 Index = 0; Index < NumBroadcasts; Index++)
+			{
+				BlueprintEvent.Broadcast();
+			}
+		});
+
+		// The Jumped delegate has no parameters, the Clung one also builds and copies an FHitResult for every listener so costs more again.
+		FDWallJumpBenchmark::FResults(TEXT("EventBroadcastBenchmark"), FString::Printf(TEXT("%d listeners, %d broadcasts"), NumListeners, NumBroadcasts))
+			.Add(TEXT("Native"), NativeNanoseconds, TEXT("broadcast"))
+			.Add(TEXT("Blueprint"), BlueprintNanoseconds, TEXT("broadcast"))
+			.AddNote(FString::Printf(TEXT("(%d)"), NumNativeCalls))
+			.Log();
+	}));
+
+static FAutoConsoleCommand CmdWallJumpClingContextSize(
+	TEXT("dignity.WallJump.ClingContextSize"),
+	TEXT("Logs the size of the Cling context every WJC holds against the FHitResult, basis vectors and Rotation it replaced, and what each comes to for 10000 WJCs."),
+	FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+	{
+		const int32 NumComponents = 10000;
+
+		// WallClingHitResult, CharacterWallClingForward/Right/UpVector and OriginalActorMeshRotationBeforeCling.
+		const SIZE_T OldContextSize = sizeof(FHitResult) + 3 * sizeof(FVector) + sizeof(FRotator);
+		const SIZE_T ContextSize = sizeof(FDWallClingContext);
+		const int32 ComponentSize = UDWallJumpComponent::StaticClass()->GetStructureSize();
+
+		FDWallJumpBenchmark::FResults(TEXT("ClingContextSize"), FString::Printf(TEXT("%d WJCs"), NumComponents))
+			.AddNote(FString::Printf(TEXT("Before: %u bytes, %.1f KB."), (uint32)OldContextSize, OldContextSize * NumComponents / 1024.0))
+			.AddNote(FString::Printf(TEXT("Now: %u bytes, %.1f KB."), (uint32)ContextSize, ContextSize * NumComponents / 1024.0))
+			.AddNote(FString::Printf(TEXT("An WJC is %d bytes, %.1f KB."), ComponentSize, (double)ComponentSize * NumComponents / 1024.0))
+			.Log();
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdWallJumpProbeBenchmark(
+	TEXT("dignity.WallJump.ProbeBenchmark"),
+	TEXT("Times an number of Cling probe sweeps around the first Player Character, default 1000, run synchronously and then requested asynchronously, and logs the Game Thread cost of each."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+	{
+		ACharacter* Character = World ? UGameplayStatics::GetPlayerCharacter(World, 0) : nullptr;
+		if (!Character)
+		{
+			UE_LOG(LogDWallJump, Warning, TEXT("ProbeBenchmark needs an Player Character to sweep from."));
+			return;
+		}
+
+		const int32 NumSweeps = FDWallJumpBenchmark::GetCountArg(Args, 0, 1000);
+
+		// The same sweep an WJC requests for its Cling probe.
+		const UCapsuleComponent* Capsule = Character->GetCapsuleComponent();
+		const FVector Start = Capsule->GetComponentLocation();
+		const FQuat Rotation = Capsule->GetComponentQuat();
+		const FCollisionShape Shape = Capsule->GetCollisionShape();
+		const ECollisionChannel Channel = Capsule->GetCollisionObjectType();
+		FCollisionQueryParams Params(SCENE_QUERY_STAT(DWallClingProbeBenchmark), false, Character);
+		FCollisionResponseParams ResponseParams;
+		Capsule->InitSweepCollisionParams(Params, ResponseParams);
+
+		// Fan the sweeps out around the Character so they dont all hit the same Surface.
+		TArray<FVector> Ends;
+		Ends.Reserve(NumSweeps);
+		for (int32 Index = 0; Index < NumSweeps; Index++)
+		{
+			const float Angle = 2.f * PI * Index / NumSweeps;
+			Ends.Add(Start + FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.f) * 500.f);
+		}
+
+		int32 NumSyncHits = 0;
+		const double SyncNanoseconds = FDWallJumpBenchmark::TimeNanoseconds(NumSweeps, [&]()
+		{
+			for (const FVector& End : Ends)
+			{
+				FHitResult Hit;
+				NumSyncHits += World->SweepSingleByChannel(Hit, Start, End, Rotation, Channel, Shape, Params, ResponseParams) ? 1 : 0;
+			}
+		});
+
+		// Only the request is timed, the sweeps themselves run on worker threads during the next World tick.
+		const double AsyncNanoseconds = FDWallJumpBenchmark::TimeNanoseconds(NumSweeps, [&]()
+		{
+			for (const FVector& End : Ends)
+			{
+				World->AsyncSweepByChannel(EAsyncTraceType::Single, Start, End, Rotation, Channel, Shape, Params, ResponseParams);
+			}
+		});
+
+		FDWallJumpBenchmark::FResults(TEXT("ProbeBenchmark"), FString::Printf(TEXT("%d sweeps, %d hits, Game Thread cost"), NumSweeps, NumSyncHits))
+			.Add(TEXT("Sync"), SyncNanoseconds, TEXT("sweep"))
+			.Add(TEXT("Async"), AsyncNanoseconds, TEXT("sweep"))
+			.Log();
+	}));
+
+/* Turns the Character to Rotation and back NumTransitions times the way an WJC does when it Clings and is released, returning the average cost of each turn in nanoseconds. */
+static double TimeClingTransitions(ACharacter* Character, int32 NumTransitions, const FRotator& Rotation, bool bSweep, bool bDeferred)
+{
+	USceneComponent* RootComponent = Character->GetRootComponent();
+	const FRotator OriginalRotation = RootComponent->GetComponentRotation();
+
+	return FDWallJumpBenchmark::TimeNanoseconds((double)NumTransitions * 2, [&]()
+	{
+		for (int32 Index = 0; Index < NumTransitions; Index++)
+		{
+			{
+				FScopedMovementUpdate ScopedUpdate(bDeferred ? RootComponent : nullptr, EScopedUpdate::DeferredUpdates);
+				RootComponent->SetWorldRotation(Rotation, bSweep);
+			}
+
+			{
+				FScopedMovementUpdate ScopedUpdate(bDeferred ? RootComponent : nullptr, EScopedUpdate::DeferredUpdates);
+				RootComponent->SetWorldRotation(OriginalRotation, bSweep);
+			}
+		}
+	});
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CmdWallJumpClingTransitionBenchmark(
+	TEXT("dignity.WallJump.ClingTransitionBenchmark"),
+	TEXT("Turns the first Player Character to an Cling Rotation and back an number of times, default 1000, swept and immediate as it used to be, swept and deferred, and unswept and deferred, and logs the cost of each turn."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+	{
+		ACharacter* Character = World ? UGameplayStatics::GetPlayerCharacter(World, 0) : nullptr;
+		if (!Character || !Character->GetRootComponent())
+		{
+			UE_LOG(LogDWallJump, Warning, TEXT("ClingTransitionBenchmark needs an Player Character to turn."));
+			return;
+		}
+
+		const int32 NumTransitions = FDWallJumpBenchmark::GetCountArg(Args, 0, 1000);
+
+		// The cost of an transition is mostly in moving everything attached to the Character.
+		TArray<USceneComponent*> AttachedComponents;
+		Character->GetRootComponent()->GetChildrenComponents(true, AttachedComponents);
+
+		const FRotator ClingRotation = Character->GetActorRotation() + FRotator(0.f, 90.f, 0.f);
+
+		FDWallJumpBenchmark::FResults(TEXT("ClingTransitionBenchmark"), FString::Printf(TEXT("%d transitions of an Character with %d attached Components"), NumTransitions, AttachedComponents.Num()))
+			.Add(TEXT("Swept and immediate"), TimeClingTransitions(Character, NumTransitions, ClingRotation, true, false), TEXT("turn"))
+			.Add(TEXT("Swept and deferred"), TimeClingTransitions(Character, NumTransitions, ClingRotation, true, true), TEXT("turn"))
+			.Add(TEXT("Unswept and deferred"), TimeClingTransitions(Character, NumTransitions, ClingRotation, false, true), TEXT("turn"))
+			.Log();
+	}));
+
+/* Replays the Frames with the Policy enough times to measure, returning the average cost of an Step in nanoseconds. */
+template<typename Policy>
+static double TimePolicyReplay(const FDWallJumpCoreSettings& Settings, const TArray<FDWallJumpCoreFrame>& Frames, int32 NumRepeats, uint32& OutHash)
+{
+	TArray<FDWallJumpCoreStepResult> Results;
+
+	return FDWallJumpBenchmark::TimeNanoseconds((double)Frames.Num() * NumRepeats, [&]()
+	{
+		for (int32 Repeat = 0; Repeat < NumRepeats; Repeat++)
+		{
+			OutHash = FDWallJumpCore::Replay<Policy>(Settings, Frames, Results);
+		}
+	});
+}
+
+/* Calls DecideHitIntent() for every Frame in an loop compiled for the Policy as the WJCs are gathered, returning the average cost of an call in nanoseconds. */
+template<typename Policy>
+static FORCENOINLINE double TimeDecideHitIntentLoop(const FDWallJumpCoreSettings& Settings, const TArray<FDWallJumpCoreFrame>& Frames, int32 NumRepeats, int32& OutNumDecided)
+{
+	const FDWallJumpCoreState State;
+	EDWallHitIntent Intent;
+
+	return FDWallJumpBenchmark::TimeNanoseconds((double)Frames.Num() * NumRepeats, [&]()
+	{
+		for (int32 Repeat = 0; Repeat < NumRepeats; Repeat++)
+		{
+			for (const FDWallJumpCoreFrame& Frame : Frames)
+			{
+				OutNumDecided += FDWallJumpCore::DecideHitIntent<Policy>(Settings, State, Frame.bJumpKeyDown, Frame.bJumpJustPressed, Intent) ? 1 : 0;
+			}
+		}
+	});
+}
+
+static FAutoConsoleCommand CmdWallJumpPolicyBenchmark(
+	TEXT("dignity.WallJump.PolicyBenchmark"),
+	TEXT("Replays an random feed of Frames, default 100000, through the Dynamic and the ClingAndJump policies and logs the average cost of an Step, and of an DecideHitIntent() in the loop the WJCs are gathered with, with each."),
+	FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+	{
+		const int32 NumFrames = FDWallJumpBenchmark::GetCountArg(Args, 0, 100000);
+		const int32 NumRepeats = 10;
+
+		// An fixed seed so every run replays the same Frames.
+		FDWallJumpHitStream Stream;
+		Stream.GenerateRandom(NumFrames, 0x57A11);
+		const TArray<FDWallJumpCoreFrame>& Frames = Stream.Frames;
+		const FDWallJumpCoreSettings& Settings = Stream.Settings;
+		check(FDWallJumpClingAndJumpPolicy::Matches(Settings));
+
+		// Warm the caches up before timing either.
+		uint32 DynamicHash = 0;
+		uint32 StaticHash = 0;
+		TimePolicyReplay<FDWallJumpDynamicPolicy>(Settings, Frames, 1, DynamicHash);
+
+		const double DynamicNanoseconds = TimePolicyReplay<FDWallJumpDynamicPolicy>(Settings, Frames, NumRepeats, DynamicHash);
+		const double StaticNanoseconds = TimePolicyReplay<FDWallJumpClingAndJumpPolicy>(Settings, Frames, NumRepeats, StaticHash);
+
+		FDWallJumpBenchmark::FResults(TEXT("PolicyBenchmark"), FString::Printf(TEXT("%d frames"), NumFrames))
+			.Add(TEXT("Dynamic"), DynamicNanoseconds, TEXT("Step"))
+			.Add(TEXT("ClingAndJump"), StaticNanoseconds, TEXT("Step"))
+			.AddNote(FString::Printf(TEXT("Results %s."), DynamicHash == StaticHash ? TEXT("match") : TEXT("DONT match")))
+			.Log();
+
+		// The WJCs are gathered in an loop per policy, see UDWallJumpComponent::GatherWallHitCandidates(), so time the decision the same way.
+		int32 NumDecided = 0;
+		const double DynamicDispatchNanoseconds = TimeDecideHitIntentLoop<FDWallJumpDynamicPolicy>(Settings, Frames, NumRepeats, NumDecided);
+		const double StaticDispatchNanoseconds = TimeDecideHitIntentLoop<FDWallJumpClingAndJumpPolicy>(Settings, Frames, NumRepeats, NumDecided);
+
+		FDWallJumpBenchmark::FResults(TEXT("PolicyBenchmark"), TEXT("DecideHitIntent in the per policy gather loop"))
+			.Add(TEXT("Dynamic"), DynamicDispatchNanoseconds, TEXT("call"))
+			.Add(TEXT("ClingAndJump"), StaticDispatchNanoseconds, TEXT("call"))
+			.AddNote(FString::Printf(TEXT("(%d)"), NumDecided))
+			.Log();
+	}));
+
+/**
+ * The Cling angle checks exactly as WallCling() and AlignCharacterMeshForCling() made them before the Cosine bounds, in degrees from Acos.
+ * An Cosine that rounds past 1 straight on to an axis makes the Acos NaN, which every check rejected.
+ */
+struct FDWallClingDegreeChecks
+{
+	float PitchDegrees;
+	float YawDegrees;
+	float RightSideDegrees;
+	bool bIsPitchValid;
+	bool bIsYawValid;
+	bool bIsHoldingRightSide;
+	bool bIsPitchNaN;
+	bool bIsYawNaN;
+	bool bIsRightSideNaN;
+
+	FDWallClingDegreeChecks(const FDWallJumpTuningValues& Values, const FVector& CharacterUp, const FVector& CharacterForward, const FVector& SurfaceNormal)
+	{
+		FVector SurfaceNormalUpVector;
+		FVector SurfaceNormalLeftVector;
+		SurfaceNormal.FindBestAxisVectors(SurfaceNormalUpVector, SurfaceNormalLeftVector);
+
+		PitchDegrees = (180.f) / PI * FMath::Acos(FVector::DotProduct(CharacterUp, SurfaceNormal));
+		YawDegrees = (180.f) / PI * FMath::Acos(CharacterForward.CosineAngle2D(SurfaceNormal * -1.f));
+		RightSideDegrees = (180.f) / PI * FMath::Acos(CharacterForward.CosineAngle2D(SurfaceNormalLeftVector * -1.f));
+
+		bIsPitchNaN = FMath::IsNaN(PitchDegrees);
+		bIsYawNaN = FMath::IsNaN(YawDegrees);
+		bIsRightSideNaN = FMath::IsNaN(RightSideDegrees);
+
+		bIsPitchValid = PitchDegrees >= Values.ClingMinPitchSurfaceAngle && PitchDegrees <= Values.ClingMaxPitchSurfaceAngle;
+		bIsYawValid = YawDegrees <= Values.ClingMaxYawSurfaceAngle;
+		bIsHoldingRightSide = RightSideDegrees >= Values.ClingMaxYawSurfaceAngle && RightSideDegrees <= 90.f;
+	}
+};
+
+/* The Cling angle settings the sweep is run with, the defaults and an few that put the bounds at the ends of their ranges. */
+static TArray<FDWallJumpTuningValues> GetClingAngleSweepTunings()
+{
+	const float AngleSets[][3] =
+	{
+		{ 44.f, 135.f, 45.f },
+		{ 80.f, 100.f, 60.f },
+		{ 0.f, 180.f, 90.f },
+		{ 90.f, 90.f, 0.f },
+		{ 30.f, 150.f, 180.f }
+	};
+
+	TArray<FDWallJumpTuningValues> Tunings;
+	for (const float* Angles : AngleSets)
+	{
+		FDWallJumpTuningValues& Values = Tunings.AddDefaulted_GetRef();
+		Values.ClingMinPitchSurfaceAngle = Angles[0];
+		Values.ClingMaxPitchSurfaceAngle = Angles[1];
+		Values.ClingMaxYawSurfaceAngle = Angles[2];
+		Values.UpdateDerivedValues();
+	}
+
+	return Tunings;
+}
+
+/* Normals over the whole sphere and Character facings around the whole circle, Steps of each. */
+static void GetClingAngleSweepVectors(int32 Steps, TArray<FVector>& OutNormals, TArray<FVector>& OutForwards)
+{
+	for (int32 PitchStep = 0; PitchStep <= Steps; PitchStep++)
+	{
+		for (int32 YawStep = 0; YawStep < Steps; YawStep++)
+		{
+			OutNormals.Add(FRotator(-90.f + 180.f * PitchStep / Steps, 360.f * YawStep / Steps, 0.f).Vector());
+		}
+	}
+
+	for (int32 YawStep = 0; YawStep < Steps; YawStep++)
+	{
+		OutForwards.Add(FRotator(0.f, 360.f * YawStep / Steps, 0.f).Vector());
+	}
+}
+
+static FAutoConsoleCommand CmdWallJumpClingAngleEquivalence(
+	TEXT("dignity.WallJump.ClingAngleEquivalence"),
+	TEXT("Sweeps Surface normals and Character facings, default 90 steps of each, and checks the Cosine bound Cling checks accept and reject exactly what the old degree checks did. ")
+	TEXT("Hits the old checks rejected because their Acos was NaN are counted as intended differences. Also logs the cost of each."),
+	FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+	{
+		const int32 Steps = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 4, 720) : 90;
+
+		// Acos and Cos round differently, an angle this close to an bound may land either side of it with either check.
+		const float BoundaryDegrees = 0.01f;
+
+		const TArray<FDWallJumpTuningValues> Tunings = GetClingAngleSweepTunings();
+		TArray<FVector> Normals;
+		TArray<FVector> Forwards;
+		GetClingAngleSweepVectors(Steps, Normals, Forwards);
+
+		int64 NumChecks = 0;
+		int64 NumBoundaryDifferences = 0;
+		int64 NumNaNDifferences = 0;
+		int64 NumDifferences = 0;
+
+		for (const FDWallJumpTuningValues& Values : Tunings)
+		{
+			for (const FVector& Normal : Normals)
+			{
+				for (const FVector& Forward : Forwards)
+				{
+					const FDWallClingDegreeChecks Degrees(Values, FVector::UpVector, Forward, Normal);
+
+					FDWallHitCandidate Candidate;
+					Candidate.SurfaceNormal = Normal;
+					Candidate.CharacterForward = Forward;
+					Candidate.MinPitchSurfaceAngleCos = Values.ClingMinPitchSurfaceAngleCos;
+					Candidate.MaxPitchSurfaceAngleCos = Values.ClingMaxPitchSurfaceAngleCos;
+					Candidate.MaxYawSurfaceAngleCos = Values.ClingMaxYawSurfaceAngleCos;
+					const FDWallHitEvaluation Evaluation = FDWallJumpCore::EvaluateCandidate(Candidate);
+
+					float RightSideCos;
+					const bool bIsHoldingRightSide = FDWallJumpCore::IsHoldingWallRightSide(Forward, Normal, Values.ClingMaxYawSurfaceAngleCos, RightSideCos);
+
+					const bool bIsOnPitchBound = FMath::Abs(Degrees.PitchDegrees - Values.ClingMinPitchSurfaceAngle) < BoundaryDegrees || FMath::Abs(Degrees.PitchDegrees - Values.ClingMaxPitchSurfaceAngle) < BoundaryDegrees;
+					const bool bIsOnYawBound = FMath::Abs(Degrees.YawDegrees - Values.ClingMaxYawSurfaceAngle) < BoundaryDegrees;
+					const bool bIsOnSideBound = FMath::Abs(Degrees.RightSideDegrees - Values.ClingMaxYawSurfaceAngle) < BoundaryDegrees || FMath::Abs(Degrees.RightSideDegrees - 90.f) < BoundaryDegrees;
+
+					const bool bChecks[3][4] =
+					{
+						{ (bool)Evaluation.bIsPitchValid, Degrees.bIsPitchValid, bIsOnPitchBound, Degrees.bIsPitchNaN },
+						{ (bool)Evaluation.bIsYawValid, Degrees.bIsYawValid, bIsOnYawBound, Degrees.bIsYawNaN },
+						{ bIsHoldingRightSide, Degrees.bIsHoldingRightSide, bIsOnSideBound, Degrees.bIsRightSideNaN }
+					};
+
+					for (const bool* Check : bChecks)
+					{
+						NumChecks++;
+						if (Check[0] != Check[1])
+						{
+							// The Cosine bounds accept what the old checks wrongly rejected straight on to an axis.
+							if (Check[3])
+							{
+								if (NumNaNDifferences++ == 0)
+								{
+									UE_LOG(LogDWallJump, Log, TEXT("ClingAngleEquivalence: first intended difference, the old checks got NaN with Normal %s, Forward %s."), *Normal.ToString(), *Forward.ToString());
+								}
+							}
+							else if (Check[2])
+							{
+								NumBoundaryDifferences++;
+							}
+							else if (NumDifferences++ == 0)
+							{
+								UE_LOG(LogDWallJump, Error, TEXT("ClingAngleEquivalence: first difference with Normal %s, Forward %s, Pitch %.3f, Yaw %.3f, Side %.3f."),
+									*Normal.ToString(), *Forward.ToString(), Degrees.PitchDegrees, Degrees.YawDegrees, Degrees.RightSideDegrees);
+							}
+						}
+					}
+				}
+			}
+		}
+
+		// Time both over the default Tuning, summing the results so neither loop can be optimized away.
+		const FDWallJumpTuningValues& Values = Tunings[0];
+		int32 NumAccepted = 0;
+
+		double StartTime = FPlatformTime::Seconds();
+		for (const FVector& Normal : Normals)
+		{
+			for (const FVector& Forward : Forwards)
+			{
+				const FDWallClingDegreeChecks Degrees(Values, FVector::UpVector, Forward, Normal);
+				NumAccepted += (Degrees.bIsPitchValid && Degrees.bIsYawValid) + Degrees.bIsHoldingRightSide;
+			}
+		}
+		const double DegreeSeconds = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		for (const FVector& Normal : Normals)
+		{
+			for (const FVector& Forward : Forwards)
+			{
+				FDWallHitCandidate Candidate;
+				Candidate.SurfaceNormal = Normal;
+				Candidate.CharacterForward = Forward;
+				Candidate.MinPitchSurfaceAngleCos = Values.ClingMinPitchSurfaceAngleCos;
+				Candidate.MaxPitchSurfaceAngleCos = Values.ClingMaxPitchSurfaceAngleCos;
+				Candidate.MaxYawSurfaceAngleCos = Values.ClingMaxYawSurfaceAngleCos;
+				const FDWallHitEvaluation Evaluation = FDWallJumpCore::EvaluateCandidate(Candidate);
+
+				float RightSideCos;
+				NumAccepted += (Evaluation.bIsPitchValid && Evaluation.bIsYawValid) + FDWallJumpCore::IsHoldingWallRightSide(Forward, Normal, Values.ClingMaxYawSurfaceAngleCos, RightSideCos);
+			}
+		}
+		const double CosineSeconds = FPlatformTime::Seconds() - StartTime;
+
+		const double NumTimed = (double)Normals.Num() * Forwards.Num();
+		UE_LOG(LogDWallJump, Log, TEXT("ClingAngleEquivalence: %lld checks, %lld differences, %lld within %.2f degrees of an bound, %lld intended where the old checks got NaN. Degrees: %.2f ns, Cosines: %.2f ns per Hit (%d)."),
+			NumChecks, NumDifferences, NumBoundaryDifferences, BoundaryDegrees, NumNaNDifferences, DegreeSeconds * 1000000000.0 / NumTimed, CosineSeconds * 1000000000.0 / NumTimed, NumAccepted);
+	}));
+#endif //!UE_BUILD_SHIPPING && DIGNITY_DEVELOPMENT
@@ -1,530 +1,2022 @@
-#include "Dignity.h"
-#include "DWallJumpComponent.h"
-#include "GameFramework/Character.h"
-#include "CollisionQueryParams.h"
-#include "UnrealNetwork.h"
-#include "DUtility.h"
-
-UDWallJumpComponent::UDWallJumpComponent()
-{
-	PrimaryComponentTick.bCanEverTick = true;
-
-	SetIsReplicated(true);
-
-	bCanWallCling = true;
-	bCanWallJump = true;
-	bRequireClingToWallJump = false;
-
-	bDebugWallCling = false;
-	bDebugWallJump = false;
-
-	ClingDuration = 5.f;
-	ClingMinPitchSurfaceAngle = 44.f;
-	ClingMaxPitchSurfaceAngle = 135.f;
-	ClingMaxYawSurfaceAngle = 45.f;
-	ClingDamageReleaseThreshold = 10.f;
-	bHoldCharacterMeshPerpendicularToSurface = true;
-	CharacterWallClingForwardVector = FVector::ZeroVector;
-	CharacterWallClingRightVector = FVector::ZeroVector;
-	CharacterWallClingUpVector = FVector::ZeroVector;
-	bIsCharacterHoldingWallRightSide = false;
-	MinVelocityToWallCling = 300.f;
-	WallClingLookInputRestrictionMode = ERestrictLookInput::RLI_Both;
-	LookInputVerticalAngleRestriction = 45.f;
-	LookInputHorizontalAngleRestriction = 180.f;
-
-	CurrentWallClingCount = 0;
-	CurrentWallJumpCount = 0;
-	MaxSequentialWallClings = 1;
-	MaxSequentialWallJumps = 1;
-	bAttemptedWallJump = false;
-	WallJumpMagnitude = 1000.f;
-	WallJumpInterferenceGracePeriodDuration = 0.5f;
-
-	JumpActionName = "Jump";
-
-	OwningCharacter = Cast<ACharacter>(GetOwner());
-
-	bOriginalControllerRotationYawUseBeforeCling = OwningCharacter ? OwningCharacter->bUseControllerRotationYaw : true;
-
-	if (OwningCharacter)
-	{
-		OwningCharacter->GetCapsuleComponent()->OnComponentHit.AddDynamic(this, &UDWallJumpComponent::OnCharacterCapsuleHit);
-		OwningCharacter->LandedDelegate.AddDynamic(this, &UDWallJumpComponent::OnCharacterLanded);
-		OwningCharacter->OnTakeAnyDamage.AddDynamic(this, &UDWallJumpComponent::OnCharacterTookAnyDamage);
-	}
-}
-
-void UDWallJumpComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
-{
-	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-
-	DOREPLIFETIME(UDWallJumpComponent, CurrentWallJumpCount);
-	DOREPLIFETIME(UDWallJumpComponent, CurrentWallClingCount);
-	DOREPLIFETIME(UDWallJumpComponent, bIsClungToWall);
-	DOREPLIFETIME(UDWallJumpComponent, bAttemptedWallJump);
-}
-
-void UDWallJumpComponent::BeginPlay()
-{
-	Super::BeginPlay();
-}
-
-void UDWallJumpComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
-{
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-
-	CheckWallClingJump();
-}
-
-void UDWallJumpComponent::PostLoad()
-{
-	Super::PostLoad();
-
-	if (!GIsReconstructingBlueprintInstances)
-	{
-		ClingMaxPitchSurfaceAngle = FMath::Max3(0.f, ClingMaxPitchSurfaceAngle, ClingMinPitchSurfaceAngle);
-	}
-}
-
-#if WITH_EDITOR
-void UDWallJumpComponent::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
-{
-	const FName PropertyName = PropertyChangedEvent.Property ? PropertyChangedEvent.Property->GetFName() : NAME_None;
-
-	if (PropertyName == GET_MEMBER_NAME_CHECKED(UDWallJumpComponent, ClingMaxPitchSurfaceAngle))
-	{
-		ClingMaxPitchSurfaceAngle = FMath::Max3(0.f, ClingMaxPitchSurfaceAngle, ClingMinPitchSurfaceAngle);
-	}
-	else if (PropertyName == GET_MEMBER_NAME_CHECKED(UDWallJumpComponent, ClingMinPitchSurfaceAngle))
-	{
-		ClingMinPitchSurfaceAngle = FMath::Clamp(ClingMinPitchSurfaceAngle, 0.f, ClingMaxPitchSurfaceAngle);
-	}
-
-	Super::PostEditChangeProperty(PropertyChangedEvent);
-}
-#endif // WITH_EDITOR
-
-float UDWallJumpComponent::RemainingClingTime()
-{
-	if(GetOwner() && IsClungToWall())
-	{
-		return GetOwner()->GetWorldTimerManager().GetTimerRemaining(WallClingTimerHandle);
-	}
-
-	return -1;
-}
-
-void UDWallJumpComponent::OnCharacterCapsuleHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
-{
-	check(OwningCharacter);
-
-	if (OwningCharacter->Role == ROLE_AutonomousProxy || (OwningCharacter->Role == ROLE_Authority && OwningCharacter->GetRemoteRole() < ROLE_AutonomousProxy))
-	{
-		// Check if the Hit is an Surface we can Cling to as long as we arent already clinging to an wall and we havent exceeded our maximum number of wall jumps allowed.
-		if (OwningCharacter && OwningCharacter->GetCharacterMovement()->MovementMode == EMovementMode::MOVE_Falling && OtherComp->GetCollisionObjectType() == ECC_WorldStatic)
-		{
-			// Find out if our Player is still holding down the "Jump" Action key.
-			APlayerController* OwningPlayerController = Cast<APlayerController>(OwningCharacter->GetController());
-			FKey JumpKey = UDUtility::GetKeysForActionMapping(nullptr, JumpActionName)[0].Key;
-			bool bJumpKeyDown = OwningPlayerController ? OwningPlayerController->IsInputKeyDown(JumpKey) : false; // An WallCling is determined to be that if the Player is still holding "Jump" while hitting the Surface.
-			bool bJumpJustPressed = OwningPlayerController ? OwningPlayerController->WasInputKeyJustPressed(JumpKey) : false; // An WallJump is determined to be that if the Player is against an surface an presses the "Jump" key.
-
-			if (bCanWallJump && CurrentWallJumpCount < MaxSequentialWallJumps && bJumpJustPressed)
-			{
-				// If we need an Cling in order to WallJump and we just attempted an WallJump we need to stop that from happening.
-				// This will usually default us to an Cling instead since the chance that another Hit occurs in the next couple of frames is highly likely and bJumpJustPressed shouldnt be valid then
-				// thus passing through to the WallCling() evaluation.
-				if (bRequireClingToWallJump)
-				{
-					return;
-				}
-
-				WallClingHitResult = Hit;
-
-				WallJump();
-			}
-			else if (bCanWallCling && !IsClungToWall() && CurrentWallClingCount < MaxSequentialWallClings && bJumpKeyDown/* && !bAttemptedWallJump*/)
-			{
-				WallClingHitResult = Hit;
-				
-				WallCling();
-			}
-		}
-	}
-}
-
-void UDWallJumpComponent::OnCharacterLanded(const FHitResult& Hit)
-{
-	// Reset our jump and cling counters when we land on an walkable surface.
-	CurrentWallJumpCount = 0;
-	CurrentWallClingCount = 0;
-	bAttemptedWallJump = false;
-}
-
-void UDWallJumpComponent::OnCharacterTookAnyDamage(AActor* DamagedActor, float Damage, const UDamageType* DamageType, AController* InstigatedBy, AActor* DamageCauser)
-{
-	if (IsClungToWall() && Damage >= ClingDamageReleaseThreshold)
-	{
-		ReleaseWallCling(true);
-	}
-}
-
-void UDWallJumpComponent::PerformCharacterWallJump_Server_Implementation(const FVector& LaunchVelocity, const bool bRightSideJump /*= true*/)
-{
-	check(OwningCharacter);
-
-	CurrentWallJumpCount++;
-	bAttemptedWallJump = true;
-	OwningCharacter->GetWorldTimerManager().SetTimer(WallJumpInterferenceGracePeriodTimerHandle, this, &UDWallJumpComponent::ResetAttemptedWallJump, WallJumpInterferenceGracePeriodDuration, false);
-
-	// If we are already clung to an wall then we need to make sure to reset the CMCs gravity and movement locks.
-	if (IsClungToWall())
-	{
-		ReleaseWallCling(false);
-	}
-
-	OwningCharacter->LaunchCharacter(LaunchVelocity, true, true);
-	OnJumpedFromWallDelegate.Broadcast();
-}
-
-bool UDWallJumpComponent::PerformCharacterWallJump_Server_Validate(const FVector& LaunchVelocity, const bool bRightSideJump /*= true*/)
-{
-	return true;
-}
-
-void UDWallJumpComponent::PerformCharacterWallCling_Server_Implementation(const bool bRightSideCling /*= true*/)
-{
-	check(OwningCharacter);
-
-	CurrentWallClingCount++;
-	bIsClungToWall = true;
-	bAttemptedWallJump = false;
-
-	// Dont release an WallCling as this is considered an infinite cling.
-	if (ClingDuration > 0)
-	{
-		FTimerDelegate ReleaseWallClingTimerDelegate;
-		ReleaseWallClingTimerDelegate.BindUFunction(this, FName("ReleaseWallCling"), true);
-		OwningCharacter->GetWorldTimerManager().SetTimer(WallClingTimerHandle, ReleaseWallClingTimerDelegate, ClingDuration, false);
-	}
-
-	SetClingMovementMode(true);
-	OnClungToWallDelegate.Broadcast(WallClingHitResult);
-
-	AlignCharacterMeshForCling();
-	ApplyWallClingLookInputRestrictions();
-}
-
-bool UDWallJumpComponent::PerformCharacterWallCling_Server_Validate(const bool bRightSideCling /*= true*/)
-{
-	// Good candidate for checking validity would be to pass the CameraLocation and Rotation to the Server and do the Angle checks again.
-	// This would have to be timestamped in order to ensure concurrency.
-	return true;
-}
-
-void UDWallJumpComponent::SetClingMovementMode(bool bEnable /*= true*/)
-{
-	check(OwningCharacter);
-
-	UCharacterMovementComponent* DefaultCMC = Cast<UCharacterMovementComponent>(OwningCharacter->GetCharacterMovement()->GetClass()->GetDefaultObject());
-
-	if (bEnable)
-	{
-		OwningCharacter->GetCharacterMovement()->DisableMovement();
-		OwningCharacter->GetCharacterMovement()->GravityScale = 0;
-		OwningCharacter->GetCharacterMovement()->Velocity = FVector::ZeroVector;
-		bIsClungToWall = true;
-	}
-	else
-	{
-		OwningCharacter->GetCharacterMovement()->SetMovementMode(MOVE_Falling);
-		OwningCharacter->GetCharacterMovement()->GravityScale = DefaultCMC ? DefaultCMC->GravityScale : 1.f;
-		bIsClungToWall = false;
-	}
-}
-
-void UDWallJumpComponent::ReleaseWallCling(bool bFell /*= true*/)
-{
-	check(OwningCharacter);
-
-	SetClingMovementMode(false);
-
-	// Invalidate the WallClingTimerHandle since we are already releasing from the Cling.
-	OwningCharacter->GetWorldTimerManager().SetTimer(WallClingTimerHandle, nullptr, -1.f, false);
-
-	if (bFell)
-	{
-		OnFellFromWallClingDelegate.Broadcast();
-	}
-
-	// When we initially Clung we hold the Characters Rotation in place and ignore user input, so we need to set it back to its original value.
-	OwningCharacter->SetActorRotation(OriginalActorMeshRotationBeforeCling);
-	OwningCharacter->bUseControllerRotationYaw = bOriginalControllerRotationYawUseBeforeCling;
-
-	// Reset any Look Input Restrictions that may have been applied.
-	ADignityCharacter* DignityCharacter = Cast<ADignityCharacter>(OwningCharacter);
-	if (DignityCharacter)
-	{
-		DignityCharacter->RestrictCameraViewAngles(ERestrictLookInput::RLI_None, FVector2D::ZeroVector, FVector2D::ZeroVector);
-	}
-}
-
-void UDWallJumpComponent::WallJump()
-{
-	check(OwningCharacter);
-
-	FHitResult Hit = WallClingHitResult;
-	FVector RicochetVelocity = FVector::ZeroVector;
-
-	APlayerController* OwningPlayerController = Cast<APlayerController>(OwningCharacter->GetController());
-	if (OwningPlayerController)
-	{
-		APlayerCameraManager* OwningPlayerCameraManager = OwningPlayerController->PlayerCameraManager;
-		if (OwningPlayerCameraManager)
-		{
-			FVector Start = OwningPlayerCameraManager->GetCameraLocation();
-			FVector End = Start + (OwningPlayerCameraManager->GetCameraRotation().Vector() * WallJumpMagnitude);
-			RicochetVelocity = (End - Start).MirrorByVector(Hit.ImpactNormal);
-		}
-	}
-
-	// Tell the Server we are jumping and update the jump information locally if needed.
-	PerformCharacterWallJump_Server(RicochetVelocity);
-	if (OwningCharacter->Role <= ROLE_AutonomousProxy)
-	{
-		OnJumpedFromWallDelegate.Broadcast();
-		CurrentWallJumpCount++;
-		bAttemptedWallJump = true;
-		OwningCharacter->GetWorldTimerManager().SetTimer(WallJumpInterferenceGracePeriodTimerHandle, this, &UDWallJumpComponent::ResetAttemptedWallJump, WallJumpInterferenceGracePeriodDuration, false);
-	}
-
-#if !UE_BUILD_SHIPPING && DIGNITY_DEVELOPMENT
-	if (bDebugWallJump)
-	{
-		FVector RicochetDirection = RicochetVelocity;
-		RicochetDirection.Normalize();
-		RicochetDirection = (Hit.ImpactPoint + Hit.Normal) + (RicochetDirection * 100.f);
-
-		DrawDebugDirectionalArrow(GetWorld(), Hit.ImpactPoint, RicochetDirection, 5.f, FColor::Red, true, -1.f, 0.f, 1.f);
-
-		DrawDebugString(GetWorld(), Hit.ImpactPoint, "Jump Velocity: " + RicochetVelocity.ToString(), NULL, FColor::Red, -1.f, true);
-	}
-#endif //!UE_BUILD_SHIPPING && DIGNITY_DEVELOPMENT
-}
-
-void UDWallJumpComponent::CheckWallClingJump()
-{
-	if (OwningCharacter && OwningCharacter->Role == ROLE_AutonomousProxy || (OwningCharacter->Role == ROLE_Authority && OwningCharacter->GetRemoteRole() < ROLE_AutonomousProxy))
-	{
-		if (IsClungToWall() && bCanWallJump)
-		{
-			// Hack for detecting if we are Jumping while in an Cling, unfortunately ActionMappings are single bind delegates and wont allow multiple subscribers so we need to detect this ourselves.
-			// If the Character class exposed an OnJumped delegate then this wouldnt be an issue but it doesnt so it is.
-			APlayerController* OwningPlayerController = Cast<APlayerController>(OwningCharacter->GetController());
-			FKey JumpKey = UDUtility::GetKeysForActionMapping(nullptr, JumpActionName)[0].Key;
-			bool bJumpJustPressed = OwningPlayerController ? OwningPlayerController->WasInputKeyJustPressed(JumpKey) : false; // An WallJump can occur from an Cling position if we press "Jump" Action Key.
-
-			if (OwningPlayerController && bJumpJustPressed)
-			{
-				APlayerCameraManager* OwningPlayerCameraManager = OwningPlayerController->PlayerCameraManager;
-				if (OwningPlayerCameraManager)
-				{
-					FVector Start = OwningPlayerCameraManager->GetCameraLocation();
-					FVector End = Start + (OwningPlayerCameraManager->GetCameraRotation().Vector() * WallJumpMagnitude);
-					End = (End - OwningCharacter->GetActorLocation());
-
-					// Tell the Server we are jumping and update the jump information locally if needed.
-					PerformCharacterWallJump_Server(End);
-					if (OwningCharacter->Role <= ROLE_AutonomousProxy)
-					{
-						CurrentWallJumpCount++;
-						bAttemptedWallJump = true;
-						ReleaseWallCling(false);
-						OnJumpedFromWallDelegate.Broadcast();
-					}
-
-#if !UE_BUILD_SHIPPING && DIGNITY_DEVELOPMENT
-					if (bDebugWallJump)
-					{
-						FVector RicochetDirection = End;
-						RicochetDirection.Normalize();
-						RicochetDirection = OwningCharacter->GetActorLocation() + (RicochetDirection * 100.f);
-
-						DrawDebugDirectionalArrow(GetWorld(), OwningCharacter->GetActorLocation(), RicochetDirection, 5.f, FColor::Green, true, -1.f, 0.f, 1.f);
-
-						DrawDebugString(GetWorld(), OwningCharacter->GetActorLocation(), "Jump Velocity: " + RicochetDirection.ToString(), NULL, FColor::Green, -1.f, true);
-					}
-#endif //!UE_BUILD_SHIPPING && DIGNITY_DEVELOPMENT
-				}
-			}
-		}
-	}
-}
-
-void UDWallJumpComponent::WallCling()
-{
-	check(OwningCharacter);
-
-	const FHitResult Hit = WallClingHitResult;
-	const FVector InverseSurfaceNormal = Hit.ImpactNormal * -1.f;
-
-	CharacterWallClingForwardVector = OwningCharacter->GetActorForwardVector();
-	CharacterWallClingRightVector = OwningCharacter->GetActorRightVector();
-	CharacterWallClingUpVector = OwningCharacter->GetActorUpVector();
-
-	// Calculate that the approach angle of the Character and the Surface angle are within the appropriate tolerances
-	const float ClingPitchImpactDot = FVector::DotProduct(CharacterWallClingUpVector, Hit.ImpactNormal);
-	const float ClingPitchImpactDegree = (180.f) / PI * FMath::Acos(ClingPitchImpactDot);
-	const float ClingYawImpactDot = FVector::DotProduct(CharacterWallClingForwardVector, InverseSurfaceNormal);
-	const float ClingYawImpactDegree = (180.f) / PI * FMath::Acos(CharacterWallClingForwardVector.CosineAngle2D(InverseSurfaceNormal));
-
-	// Before we use it make sure our ClingMaxPitch isnt exceeding our Min required value or its Max value.
-	ClingMaxPitchSurfaceAngle = FMath::Clamp(ClingMaxPitchSurfaceAngle, ClingMinPitchSurfaceAngle, 180.f);
-
-	// If the calculated angles are within our tolerances then we have an valid surface.
-	const bool bIsClingPitchImpactDegreeValid = UDUtility::FloatInRange(ClingPitchImpactDegree, ClingMinPitchSurfaceAngle, ClingMaxPitchSurfaceAngle, true, true);
-	const bool bIsClingYawImpactDegreeValid = ClingYawImpactDegree <= ClingMaxYawSurfaceAngle;
-
-	const float CharacterVelocity = OwningCharacter->GetVelocity().Size();
-
-	if (bIsClingPitchImpactDegreeValid && bIsClingYawImpactDegreeValid && (CharacterVelocity >= MinVelocityToWallCling) && !bAttemptedWallJump)
-	{
-		// Tell the Server we are clinging and update cling information locally if needed.
-		PerformCharacterWallCling_Server();
-		if (OwningCharacter->Role <= ROLE_AutonomousProxy)
-		{
-			CurrentWallClingCount++;
-			bIsClungToWall = true;
-			OnClungToWallDelegate.Broadcast(WallClingHitResult);
-
-			AlignCharacterMeshForCling();
-			ApplyWallClingLookInputRestrictions();
-
-			//Locally apply the cling timer so we can get the OnFell broadcast.
-			if (ClingDuration > 0)
-			{
-				FTimerDelegate ReleaseWallClingTimerDelegate;
-				ReleaseWallClingTimerDelegate.BindUFunction(this, FName("ReleaseWallCling"), true);
-				OwningCharacter->GetWorldTimerManager().SetTimer(WallClingTimerHandle, ReleaseWallClingTimerDelegate, ClingDuration, false);
-			}
-		}
-	}
-
-#if !UE_BUILD_SHIPPING && DIGNITY_DEVELOPMENT
-	if (bDebugWallCling)
-	{
-		FString ClingPitchImpactDegreeString = "Pitch: " + FString::SanitizeFloat(ClingPitchImpactDegree);
-		FString ClingImpactYawDegreeString = "Yaw: " + FString::SanitizeFloat(ClingYawImpactDegree);
-		FString ClingIsValidString = (bIsClingPitchImpactDegreeValid && bIsClingYawImpactDegreeValid) ? "Valid Cling Surface" : "Invalid Cling Surface";
-		FVector ImpactPointExtended = (Hit.ImpactNormal * 50.f) + Hit.ImpactPoint;
-		FVector ImpactPointExtendedUp = FVector(ImpactPointExtended.X, ImpactPointExtended.Y, ImpactPointExtended.Z + 50.f);
-		FVector CharacterForwardVectorExtended = (CharacterWallClingForwardVector * 50.f) + ImpactPointExtended;
-		FVector InverseSurfaceNormalExtended = (InverseSurfaceNormal * 50.f) + Hit.ImpactPoint;
-
-		DrawDebugLine(GetWorld(), Hit.ImpactPoint, ImpactPointExtended, FColor::Green, true, -1.f, 0.f, .5f);
-		DrawDebugLine(GetWorld(), ImpactPointExtended, ImpactPointExtendedUp, FColor::Blue, true, -1.f, 0.f, .5f);
-		DrawDebugLine(GetWorld(), ImpactPointExtended, CharacterForwardVectorExtended, FColor::Red, true, -1.f, 0.f, .5f);
-		DrawDebugLine(GetWorld(), Hit.ImpactPoint, InverseSurfaceNormalExtended, FColor::Yellow, true, -1.f, 0.f, .5f);
-
-		DrawDebugString(GetWorld(), ImpactPointExtended, ClingPitchImpactDegreeString, NULL, FColor::Green, -1.f, true);
-		DrawDebugString(GetWorld(), CharacterForwardVectorExtended, ClingImpactYawDegreeString, NULL, FColor::Red, -1.f, true);
-		DrawDebugString(GetWorld(), ImpactPointExtendedUp, ClingIsValidString, NULL, FColor::Blue, -1.f, true);
-		DrawDebugString(GetWorld(), InverseSurfaceNormalExtended, ("Inverse Normal: " + InverseSurfaceNormal.ToString()), NULL, FColor::Yellow, -1.f, true);
-
-		DrawDebugCircle(GetWorld(), ImpactPointExtended, 25.f, 50.f, FColor::Red, true, -1.f, 0.f, .5f, CharacterWallClingRightVector, CharacterWallClingForwardVector, true);
-		DrawDebugCircle(GetWorld(), ImpactPointExtended, 25.f, 50.f, FColor::Green, true, -1.f, 0.f, .5f, FVector::CrossProduct(CharacterWallClingRightVector, InverseSurfaceNormal), InverseSurfaceNormal, true);
-	}
-#endif //!UE_BUILD_SHIPPING && DIGNITY_DEVELOPMENT
-}
-
-void UDWallJumpComponent::AlignCharacterMeshForCling()
-{
-	check(OwningCharacter);
-
-	if (IsClungToWall())
-	{
-		FVector SurfaceNormalUpVector;
-		FVector SurfaceNormalForwardVector = WallClingHitResult.ImpactNormal;
-		FVector SurfaceNormalLeftVector;
-
-		// Grab the Surface normal axes vectors so we can use them to figure out what side the Character is facing.
-		WallClingHitResult.ImpactNormal.FindBestAxisVectors(SurfaceNormalUpVector, SurfaceNormalLeftVector);
-
-		FVector SurfaceNormalRightVector = SurfaceNormalLeftVector * -1.f;
-
-		// Calculate the angle between the ForwardVector when we hit the surface and that of the Right and Left vectors of the surface normal
-		// so we can determine what side the Character is facing.
-		float CharacterForwardVectorDot = FVector::DotProduct(CharacterWallClingForwardVector, SurfaceNormalRightVector);
-		float CharacterRightSideNormalAngle = (180.f) / PI * FMath::Acos(CharacterWallClingForwardVector.CosineAngle2D(SurfaceNormalRightVector));
-		float CharacterLeftSideNormalAngle = (180.f) / PI * FMath::Acos(CharacterWallClingForwardVector.CosineAngle2D(SurfaceNormalLeftVector));
-
-		bIsCharacterHoldingWallRightSide = UDUtility::FloatInRange(CharacterRightSideNormalAngle, ClingMaxYawSurfaceAngle, 90.f, true, true);
-
-		// Hold the Character in the Rotation that is parallel to the Surface we Clung to or the against the SurfaceNormal.
-		// This is released in ReleaseCling().
-		OriginalActorMeshRotationBeforeCling = OwningCharacter->GetActorRotation();
-		OwningCharacter->SetActorRotation(bHoldCharacterMeshPerpendicularToSurface ? (bIsCharacterHoldingWallRightSide ? SurfaceNormalRightVector.Rotation() : SurfaceNormalLeftVector.Rotation()) : SurfaceNormalForwardVector.Rotation());
-		bOriginalControllerRotationYawUseBeforeCling = OwningCharacter->bUseControllerRotationYaw;
-		OwningCharacter->bUseControllerRotationYaw = false;
-
-
-#if !UE_BUILD_SHIPPING && DIGNITY_DEVELOPMENT
-		if (bDebugWallCling)
-		{
-			FVector ImpactPointExtended = WallClingHitResult.ImpactPoint + (WallClingHitResult.ImpactNormal * 50.f);
-			ImpactPointExtended.Z = ImpactPointExtended.Z + 50.f;
-
-			FVector SurfaceNormalUpExtended = ImpactPointExtended + (SurfaceNormalUpVector * 50.f);
-			FVector SurfaceNormalLeftExtended = ImpactPointExtended + (SurfaceNormalLeftVector * 50.f);
-			FVector SurfaceNormalRightExtended = ImpactPointExtended + (SurfaceNormalRightVector * 50.f);
-
-			DrawDebugLine(GetWorld(), ImpactPointExtended, SurfaceNormalUpExtended, FColor::Blue, true, -1.f, 0.f, .5f);
-			DrawDebugLine(GetWorld(), ImpactPointExtended, SurfaceNormalLeftExtended, FColor::Green, true, -1.f, 0.f, .5f);
-			DrawDebugLine(GetWorld(), ImpactPointExtended, SurfaceNormalRightExtended, FColor::Red, true, -1.f, 0.f, .5f);
-
-			DrawDebugString(GetWorld(), SurfaceNormalUpExtended, "Normal Up", NULL, FColor::Blue, -1.f, true);
-			DrawDebugString(GetWorld(), SurfaceNormalLeftExtended, "Normal Left: " + FString::SanitizeFloat(CharacterLeftSideNormalAngle) + " | " + (!bIsCharacterHoldingWallRightSide ? "True" : "False"), NULL, FColor::Green, -1.f, true);
-			DrawDebugString(GetWorld(), SurfaceNormalRightExtended, "Normal Right: " + FString::SanitizeFloat(CharacterRightSideNormalAngle) + " | " + (bIsCharacterHoldingWallRightSide ? "True" : "False"), NULL, FColor::Red, -1.f, true);
-		}
-#endif //!UE_BUILD_SHIPPING && DIGNITY_DEVELOPMENT
-	}
-}
-
-void UDWallJumpComponent::ResetAttemptedWallJump()
-{
-	bAttemptedWallJump = false;
-	OnWallClingCooldownExpiredDelegate.Broadcast();
-}
-
-void UDWallJumpComponent::ApplyWallClingLookInputRestrictions()
-{
-	check(OwningCharacter);
-
-	// We dont need to bother calculating restrictions if they wont ever be applied or they exceed sensible default constraints.
-	if (WallClingLookInputRestrictionMode == ERestrictLookInput::RLI_None || (LookInputVerticalAngleRestriction < -90.f || LookInputVerticalAngleRestriction > 90.f) || (LookInputHorizontalAngleRestriction < 0.f || LookInputHorizontalAngleRestriction > 360.f))
-	{
-		return;
-	}
-
-	ADignityCharacter* DignityCharacter = Cast<ADignityCharacter>(OwningCharacter);
-	if(DignityCharacter && IsClungToWall())
-	{
-		const FVector SurfaceNormal = WallClingHitResult.Normal.GetSafeNormal();
-
-		FVector2D ConstrainedPitchDegrees;
-
-		ConstrainedPitchDegrees.X = -90.f + LookInputVerticalAngleRestriction;
-		ConstrainedPitchDegrees.Y = 90.f - LookInputVerticalAngleRestriction;
-
-		FVector2D ConstrainedYawDegrees;
-
-		float NegativeSin = FMath::RadiansToDegrees(FMath::Acos(FVector::DotProduct(FVector(-0.707f, 0.f, 0.f).GetSafeNormal(), SurfaceNormal)));
-		float PositiveSin = FMath::RadiansToDegrees(FMath::Acos(FVector::DotProduct(SurfaceNormal, FVector(0.707f, 0.f, 0.f).GetSafeNormal())));
-
-		ConstrainedYawDegrees.X = SurfaceNormal.Y > 0.f ? PositiveSin + (LookInputHorizontalAngleRestriction / 2.f) + 180.f : NegativeSin + (LookInputHorizontalAngleRestriction / 2.f);
-		ConstrainedYawDegrees.Y = SurfaceNormal.Y > 0.f ? PositiveSin - (LookInputHorizontalAngleRestriction / 2.f) + 180.f : NegativeSin - (LookInputHorizontalAngleRestriction / 2.f);
-
-		DignityCharacter->RestrictCameraViewAngles(WallClingLookInputRestrictionMode, ConstrainedPitchDegrees, ConstrainedYawDegrees);
-	}
-}
+#include "Dignity.h"
+#include "DWallJumpComponent.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/GameInstance.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SceneComponent.h"
+#include "CollisionQueryParams.h"
+#include "UnrealNetwork.h"
+#include "DUtility.h"
+#include "DWallJumpSubsystem.h"
+#include "DWallJumpCore.h"
+#include "DWallSurfaceCache.h"
+#include "DWallJumpMovementComponent.h"
+#include "DWallJumpStats.h"
+
+uint32 UDWallJumpComponent::JumpKeysGeneration = 1;
+
+UDWallJumpComponent::UDWallJumpComponent()
+{
+	// We only need to Tick while Clung to an wall to detect the Jump from the Cling, everything else is driven by the Capsule Hit event.
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+
+	SetIsReplicated(true);
+
+	bCanWallCling = true;
+	bCanWallJump = true;
+	bRequireClingToWallJump = false;
+
+	bDebugWallCling = false;
+	bDebugWallJump = false;
+
+	Tuning = nullptr;
+#if WITH_EDITORONLY_DATA
+	ResetDeprecatedTuning();
+#endif // WITH_EDITORONLY_DATA
+
+	bHoldCharacterMeshPerpendicularToSurface = true;
+	bSweepClingRotation = true;
+	bIsReleasingWallCling = false;
+	ClingPoseStartRotation = FQuat::Identity;
+	ClingPoseTargetRotation = FQuat::Identity;
+	ClingPoseBlendAlpha = 1.f;
+	bIsCharacterHoldingWallRightSide = false;
+
+	WallClingReleaseTime = 0.f;
+	WallJumpGracePeriodEndTime = 0.f;
+	LastServerWallMoveTimestamp = -1.f;
+	ServerClientMoveTimestamp = 0.f;
+
+	JumpActionName = "Jump";
+	WallJumpMovement = nullptr;
+	CachedJumpKeysActionName = NAME_None;
+	CachedJumpKeysGeneration = 0;
+
+	bHasPendingWallHit = false;
+	PendingWallHitTime = 0.f;
+
+	FMemory::Memzero(LastWallJumpEventFrames);
+
+	bPredictWallCling = false;
+	PredictedClingNormal = FVector::ZeroVector;
+	PredictedClingSpeed = 0.f;
+	PredictedClingExpireTime = 0.f;
+	bIsClingSpeedPredicted = false;
+	ClingSurfaceLocation = FVector::ZeroVector;
+
+	Significance = EDWallJumpSignificance::High;
+	bIsMeshAlignedForCling = false;
+
+	Archetype = EDWallJumpArchetype::Dynamic;
+	PolicyArchetype = EDWallJumpArchetype::Dynamic;
+
+	// Our Owner isnt known until we are registered with it, see OnRegister().
+	OwningCharacter = nullptr;
+	WallJumpMovement = nullptr;
+	bOriginalControllerRotationYawUseBeforeCling = true;
+}
+
+void UDWallJumpComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	OwningCharacter = Cast<ACharacter>(GetOwner());
+}
+
+void UDWallJumpComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	// Only the owning Client needs the counters, everyone else only needs to know how we are Clung.
+	DOREPLIFETIME_CONDITION(UDWallJumpComponent, OwnerState, COND_OwnerOnly);
+	DOREPLIFETIME_CONDITION(UDWallJumpComponent, ClingPose, COND_SimulatedOnly);
+}
+
+void UDWallJumpComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	OwningCharacter = Cast<ACharacter>(GetOwner());
+	RefreshOwnerReferences();
+
+	// Bound here rather than in the constructor, where Components added in Blueprints or at runtime have no Owner yet.
+	if (OwningCharacter)
+	{
+		bOriginalControllerRotationYawUseBeforeCling = OwningCharacter->bUseControllerRotationYaw;
+
+		OwningCharacter->GetCapsuleComponent()->OnComponentHit.AddUniqueDynamic(this, &UDWallJumpComponent::OnCharacterCapsuleHit);
+		OwningCharacter->LandedDelegate.AddUniqueDynamic(this, &UDWallJumpComponent::OnCharacterLanded);
+		OwningCharacter->OnTakeAnyDamage.AddUniqueDynamic(this, &UDWallJumpComponent::OnCharacterTookAnyDamage);
+
+		if (UGameInstance* GameInstance = GetWorld()->GetGameInstance())
+		{
+			GameInstance->GetOnPawnControllerChanged().AddUniqueDynamic(this, &UDWallJumpComponent::OnPawnControllerChanged);
+		}
+	}
+
+	// Components spawned at runtime dont go through PostLoad() so make sure we are using the Tuning we were spawned with.
+	ResolveTuning();
+
+	SelectWallJumpPolicy();
+
+	if (UDWallJumpSubsystem* WallJumpSubsystem = GetWorld()->GetSubsystem<UDWallJumpSubsystem>())
+	{
+		WallJumpSubsystem->RegisterWallJumpComponent(this);
+
+		if (bPredictWallCling)
+		{
+			WallJumpSubsystem->RegisterWallClingProbe(this);
+		}
+	}
+}
+
+void UDWallJumpComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (OwningCharacter)
+	{
+		OwningCharacter->GetCapsuleComponent()->OnComponentHit.RemoveDynamic(this, &UDWallJumpComponent::OnCharacterCapsuleHit);
+		OwningCharacter->LandedDelegate.RemoveDynamic(this, &UDWallJumpComponent::OnCharacterLanded);
+		OwningCharacter->OnTakeAnyDamage.RemoveDynamic(this, &UDWallJumpComponent::OnCharacterTookAnyDamage);
+	}
+
+	if (UGameInstance* GameInstance = GetWorld()->GetGameInstance())
+	{
+		GameInstance->GetOnPawnControllerChanged().RemoveDynamic(this, &UDWallJumpComponent::OnPawnControllerChanged);
+	}
+
+	if (UDWallJumpSubsystem* WallJumpSubsystem = GetWorld()->GetSubsystem<UDWallJumpSubsystem>())
+	{
+		WallJumpSubsystem->UnregisterWallJumpComponent(this);
+		WallJumpSubsystem->UnregisterWallClingProbe(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UDWallJumpComponent::RefreshOwnerReferences()
+{
+	OwnerReferences = FDWallJumpOwnerReferences();
+	WallJumpMovement = nullptr;
+
+	if (!OwningCharacter)
+	{
+		return;
+	}
+
+	OwnerReferences.DignityCharacter = Cast<ADignityCharacter>(OwningCharacter);
+
+	// If the Character uses our CharacterMovementComponent then Clings and Jumps are predicted through it.
+	OwnerReferences.CharacterMovement = OwningCharacter->GetCharacterMovement();
+	if (OwnerReferences.CharacterMovement)
+	{
+		OwnerReferences.DefaultCharacterMovement = OwnerReferences.CharacterMovement->GetClass()->GetDefaultObject<UCharacterMovementComponent>();
+		WallJumpMovement = Cast<UDWallJumpMovementComponent>(OwnerReferences.CharacterMovement);
+		if (WallJumpMovement)
+		{
+			WallJumpMovement->SetWallJumpComponent(this);
+		}
+	}
+
+	APlayerController* PlayerController = Cast<APlayerController>(OwningCharacter->GetController());
+	OwnerReferences.PlayerController = PlayerController;
+	OwnerReferences.PlayerCameraManager = PlayerController ? PlayerController->PlayerCameraManager : nullptr;
+}
+
+void UDWallJumpComponent::OnPawnControllerChanged(APawn* Pawn, AController* Controller)
+{
+	if (Pawn == OwningCharacter)
+	{
+		RefreshOwnerReferences();
+	}
+}
+
+void UDWallJumpComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	UpdateWallJumpDeadlines();
+
+	CheckWallClingJump();
+
+	if (ClingPoseBlendAlpha < 1.f)
+	{
+		BlendToClingPose(DeltaTime);
+	}
+
+	UpdateWallClingTickState();
+
+	// At Low significance our Tick interval covers several frames, count the ones we didnt Tick on as saved.
+	FDWallJumpStats& Stats = FDWallJumpStats::Get();
+	if (Significance == EDWallJumpSignificance::High)
+	{
+		Stats.RecordWorkCost(EDWallJumpSkippableWork::Tick, FPlatformTime::Seconds() - StartTime);
+	}
+	else
+	{
+		const float FrameDeltaTime = FMath::Max(GetWorld()->GetDeltaSeconds(), SMALL_NUMBER);
+		Stats.RecordSkippedWork(EDWallJumpSkippableWork::Tick, FMath::RoundToInt(DeltaTime / FrameDeltaTime) - 1);
+	}
+}
+
+void UDWallJumpComponent::SetSignificance(EDWallJumpSignificance NewSignificance, float LowSignificanceTickInterval)
+{
+	if (Significance == NewSignificance)
+	{
+		return;
+	}
+
+	Significance = NewSignificance;
+	SetComponentTickInterval(Significance == EDWallJumpSignificance::High ? 0.f : LowSignificanceTickInterval);
+}
+
+void UDWallJumpComponent::SetCapsuleHitHandlingEnabled(bool bEnabled)
+{
+	UCapsuleComponent* Capsule = OwningCharacter ? OwningCharacter->GetCapsuleComponent() : nullptr;
+	if (!Capsule)
+	{
+		return;
+	}
+
+	const bool bIsBound = Capsule->OnComponentHit.IsAlreadyBound(this, &UDWallJumpComponent::OnCharacterCapsuleHit);
+	if (bEnabled && !bIsBound)
+	{
+		Capsule->OnComponentHit.AddDynamic(this, &UDWallJumpComponent::OnCharacterCapsuleHit);
+	}
+	else if (!bEnabled && bIsBound)
+	{
+		Capsule->OnComponentHit.RemoveDynamic(this, &UDWallJumpComponent::OnCharacterCapsuleHit);
+	}
+}
+
+bool UDWallJumpComponent::IsCapsuleHitHandlingEnabled()
+{
+	UCapsuleComponent* Capsule = OwningCharacter ? OwningCharacter->GetCapsuleComponent() : nullptr;
+	return Capsule && Capsule->OnComponentHit.IsAlreadyBound(this, &UDWallJumpComponent::OnCharacterCapsuleHit);
+}
+
+void UDWallJumpComponent::UpdateWallClingTickState()
+{
+	// Only keep ticking while we are Clung or waiting on an deadline, the Tick is used to detect an Jump from the Cling and to expire the deadlines.
+	// Remote Characters on the Server never read their Jump input here so they only need to Tick for the deadlines.
+	// Simulated Proxies only Tick to turn to their ClingPose.
+	const bool bShouldTick = (IsClungToWall() && IsWallJumpInputLocal()) || WallClingReleaseTime > 0.f || WallJumpGracePeriodEndTime > 0.f || ClingPoseBlendAlpha < 1.f;
+	if (IsComponentTickEnabled() != bShouldTick)
+	{
+		SetComponentTickEnabled(bShouldTick);
+	}
+}
+
+void UDWallJumpComponent::StartWallClingDuration()
+{
+	const FDWallJumpTuningValues& TuningValues = GetTuning();
+
+	// Dont release an WallCling as this is considered an infinite cling.
+	if (TuningValues.ClingDuration > 0)
+	{
+		WallClingReleaseTime = GetWorld()->GetTimeSeconds() + TuningValues.ClingDuration;
+		UpdateWallClingTickState();
+	}
+}
+
+void UDWallJumpComponent::StartWallJumpGracePeriod()
+{
+	WallJumpGracePeriodEndTime = GetWorld()->GetTimeSeconds() + GetTuning().WallJumpInterferenceGracePeriodDuration;
+	UpdateWallClingTickState();
+}
+
+void UDWallJumpComponent::UpdateWallJumpDeadlines()
+{
+	const float WorldTime = GetWorld()->GetTimeSeconds();
+
+	if (WallJumpGracePeriodEndTime > 0.f && WorldTime >= WallJumpGracePeriodEndTime)
+	{
+		WallJumpGracePeriodEndTime = 0.f;
+		ResetAttemptedWallJump();
+	}
+
+	if (WallClingReleaseTime > 0.f && WorldTime >= WallClingReleaseTime)
+	{
+		WallClingReleaseTime = 0.f;
+		ReleaseWallCling(EDWallClingReleaseReason::Fell);
+	}
+}
+
+bool UDWallJumpComponent::IsWallJumpInputLocal() const
+{
+	return OwningCharacter && (OwningCharacter->Role == ROLE_AutonomousProxy || (OwningCharacter->Role == ROLE_Authority && OwningCharacter->GetRemoteRole() < ROLE_AutonomousProxy));
+}
+
+void UDWallJumpComponent::SetIsClungToWall(bool bClung)
+{
+	bIsClungToWall = bClung;
+	OwnerState.bIsClungToWall = bClung;
+	UpdateClingPose();
+	UpdateWallClingTickState();
+
+	// Only the machines that can release the Cling need to know if its Surface goes away.
+	if (bClung && OwningCharacter && OwningCharacter->Role >= ROLE_AutonomousProxy)
+	{
+		UPrimitiveComponent* Surface = WallClingContext.Surface.Get();
+		ClingSurfaceLocation = Surface ? Surface->GetComponentLocation() : FVector::ZeroVector;
+
+		if (UDWallJumpSubsystem* WallJumpSubsystem = GetWorld()->GetSubsystem<UDWallJumpSubsystem>())
+		{
+			WallJumpSubsystem->RegisterClingPersistence(this);
+		}
+	}
+}
+
+void UDWallJumpComponent::OnRep_ClingPose()
+{
+	bIsClungToWall = ClingPose.bIsClung;
+	bIsCharacterHoldingWallRightSide = ClingPose.bIsHoldingRightSide;
+
+	// The replicated movement brings the Rotation back on release, only the turn to the wall arrives ahead of it.
+	if (bIsClungToWall && OwningCharacter && Significance != EDWallJumpSignificance::Low)
+	{
+		ClingPoseStartRotation = OwningCharacter->GetActorQuat();
+		ClingPoseTargetRotation = GetClingRotation(ClingPose.GetNormal(), ClingPose.bIsHoldingRightSide, ClingPose.bIsHeldPerpendicular).Quaternion();
+		ClingPoseBlendAlpha = 0.f;
+		BlendToClingPose(0.f);
+	}
+	else
+	{
+		ClingPoseBlendAlpha = 1.f;
+	}
+
+	UpdateWallClingTickState();
+}
+
+void UDWallJumpComponent::UpdateClingPose()
+{
+	if (!OwningCharacter || OwningCharacter->Role == ROLE_SimulatedProxy)
+	{
+		return;
+	}
+
+	// Only an new Cling touches the rest, so an release leaves it as it was and costs nothing but the flag.
+	ClingPose.bIsClung = bIsClungToWall;
+	if (bIsClungToWall)
+	{
+		ClingPose.bIsHoldingRightSide = bIsCharacterHoldingWallRightSide;
+		ClingPose.bIsHeldPerpendicular = bHoldCharacterMeshPerpendicularToSurface;
+		ClingPose.SetNormal(WallClingContext.GetImpactNormal());
+		ClingPose.Anchor = OwningCharacter->GetActorLocation();
+	}
+}
+
+void UDWallJumpComponent::BlendToClingPose(float DeltaTime)
+{
+	const FDWallJumpTuningValues& TuningValues = GetTuning();
+
+	if (!OwningCharacter)
+	{
+		ClingPoseBlendAlpha = 1.f;
+		return;
+	}
+
+	ClingPoseBlendAlpha = TuningValues.ClingPoseBlendTime > 0.f ? FMath::Min(ClingPoseBlendAlpha + DeltaTime / TuningValues.ClingPoseBlendTime, 1.f) : 1.f;
+
+	// Proxies dont move themselves, there is nothing for an sweep to stop.
+	OwningCharacter->SetActorRotation(FQuat::Slerp(ClingPoseStartRotation, ClingPoseTargetRotation, ClingPoseBlendAlpha));
+
+	if (ClingPoseBlendAlpha >= 1.f)
+	{
+		UpdateWallClingTickState();
+	}
+}
+
+FRotator UDWallJumpComponent::GetClingRotation(const FVector& SurfaceNormal, bool bHoldingRightSide, bool bHeldPerpendicular)
+{
+	if (!bHeldPerpendicular)
+	{
+		return SurfaceNormal.Rotation();
+	}
+
+	FVector SurfaceNormalUpVector;
+	FVector SurfaceNormalLeftVector;
+	SurfaceNormal.FindBestAxisVectors(SurfaceNormalUpVector, SurfaceNormalLeftVector);
+
+	return bHoldingRightSide ? (SurfaceNormalLeftVector * -1.f).Rotation() : SurfaceNormalLeftVector.Rotation();
+}
+
+UAnimSequence* UDWallJumpComponent::GetClingAnimation() const
+{
+	if (!bIsClungToWall)
+	{
+		return nullptr;
+	}
+
+	const UDWallJumpTuning* AnimTuning = Tuning ? Tuning : GetDefault<UDWallJumpTuning>();
+
+	if (!ClingPose.bIsHeldPerpendicular)
+	{
+		return AnimTuning->ClingAnimForward;
+	}
+
+	return ClingPose.bIsHoldingRightSide ? AnimTuning->ClingAnimRight : AnimTuning->ClingAnimLeft;
+}
+
+void UDWallJumpComponent::OnRep_OwnerState()
+{
+	// The Server released us, or never accepted the Cling we predicted, so undo everything the Cling set up rather than only the flag.
+	if (bIsClungToWall && !OwnerState.bIsClungToWall && OwningCharacter)
+	{
+		ReleaseWallCling(EDWallClingReleaseReason::Fell);
+	}
+
+	bIsClungToWall = OwnerState.bIsClungToWall;
+	UpdateWallClingTickState();
+}
+
+void UDWallJumpComponent::OnWallClingMovementModeLeft()
+{
+	if (IsClungToWall() && !bIsReleasingWallCling && OwningCharacter)
+	{
+		ReleaseWallCling(EDWallClingReleaseReason::Fell);
+	}
+}
+
+void UDWallJumpComponent::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	// Copies made from an template dont go through PostLoad(), and the CDO is read for its Tuning by the DWallClingNav commandlet.
+	ResolveTuning();
+}
+
+void UDWallJumpComponent::PostLoad()
+{
+	Super::PostLoad();
+
+#if WITH_EDITORONLY_DATA
+	MigrateDeprecatedTuning();
+#endif // WITH_EDITORONLY_DATA
+
+	ResolveTuning();
+}
+
+#if WITH_EDITORONLY_DATA
+void UDWallJumpComponent::ResetDeprecatedTuning()
+{
+	const FDWallJumpTuningValues& Defaults = FDWallJumpTuningValues::GetDefaults();
+	ClingDuration_DEPRECATED = Defaults.ClingDuration;
+	WallJumpInterferenceGracePeriodDuration_DEPRECATED = Defaults.WallJumpInterferenceGracePeriodDuration;
+	ClingMinPitchSurfaceAngle_DEPRECATED = Defaults.ClingMinPitchSurfaceAngle;
+	ClingMaxPitchSurfaceAngle_DEPRECATED = Defaults.ClingMaxPitchSurfaceAngle;
+	ClingMaxYawSurfaceAngle_DEPRECATED = Defaults.ClingMaxYawSurfaceAngle;
+	ClingDamageReleaseThreshold_DEPRECATED = Defaults.ClingDamageReleaseThreshold;
+	MaxSequentialWallClings_DEPRECATED = Defaults.MaxSequentialWallClings;
+	MaxSequentialWallJumps_DEPRECATED = Defaults.MaxSequentialWallJumps;
+	MinVelocityToWallCling_DEPRECATED = Defaults.MinVelocityToWallCling;
+	WallClingPredictionFrames_DEPRECATED = Defaults.WallClingPredictionFrames;
+	WallClingLookInputRestrictionMode_DEPRECATED = Defaults.WallClingLookInputRestrictionMode;
+	LookInputVerticalAngleRestriction_DEPRECATED = Defaults.LookInputVerticalAngleRestriction;
+	LookInputHorizontalAngleRestriction_DEPRECATED = Defaults.LookInputHorizontalAngleRestriction;
+	WallJumpMagnitude_DEPRECATED = Defaults.WallJumpMagnitude;
+	ServerClingAngleTolerance_DEPRECATED = Defaults.ServerClingAngleTolerance;
+	ClingPoseBlendTime_DEPRECATED = Defaults.ClingPoseBlendTime;
+
+	ClingAnimLeft_DEPRECATED = nullptr;
+	ClingAnimRight_DEPRECATED = nullptr;
+	ClingAnimForward_DEPRECATED = nullptr;
+}
+
+void UDWallJumpComponent::MigrateDeprecatedTuning()
+{
+	// Gather the saved values the same way the Tuning stores them so they can be compared against the defaults one by one.
+	FDWallJumpTuningValues SavedTuning;
+	SavedTuning.ClingDuration = ClingDuration_DEPRECATED;
+	SavedTuning.WallJumpInterferenceGracePeriodDuration = WallJumpInterferenceGracePeriodDuration_DEPRECATED;
+	SavedTuning.ClingMinPitchSurfaceAngle = ClingMinPitchSurfaceAngle_DEPRECATED;
+	SavedTuning.ClingMaxPitchSurfaceAngle = ClingMaxPitchSurfaceAngle_DEPRECATED;
+	SavedTuning.ClingMaxYawSurfaceAngle = ClingMaxYawSurfaceAngle_DEPRECATED;
+	SavedTuning.ClingDamageReleaseThreshold = ClingDamageReleaseThreshold_DEPRECATED;
+	SavedTuning.MaxSequentialWallClings = MaxSequentialWallClings_DEPRECATED;
+	SavedTuning.MaxSequentialWallJumps = MaxSequentialWallJumps_DEPRECATED;
+	SavedTuning.MinVelocityToWallCling = MinVelocityToWallCling_DEPRECATED;
+	SavedTuning.WallClingPredictionFrames = WallClingPredictionFrames_DEPRECATED;
+	SavedTuning.WallClingLookInputRestrictionMode = WallClingLookInputRestrictionMode_DEPRECATED;
+	SavedTuning.LookInputVerticalAngleRestriction = LookInputVerticalAngleRestriction_DEPRECATED;
+	SavedTuning.LookInputHorizontalAngleRestriction = LookInputHorizontalAngleRestriction_DEPRECATED;
+	SavedTuning.WallJumpMagnitude = WallJumpMagnitude_DEPRECATED;
+	SavedTuning.ServerClingAngleTolerance = ServerClingAngleTolerance_DEPRECATED;
+	SavedTuning.ClingPoseBlendTime = ClingPoseBlendTime_DEPRECATED;
+
+	const FDWallJumpTuningValues& Defaults = FDWallJumpTuningValues::GetDefaults();
+
+	for (uint8 ValueIndex = 0; ValueIndex < (uint8)EDWallJumpTuningValue::Num; ValueIndex++)
+	{
+		const EDWallJumpTuningValue Value = (EDWallJumpTuningValue)ValueIndex;
+		const float SavedAmount = SavedTuning.GetValue(Value);
+
+		if (SavedAmount == Defaults.GetValue(Value))
+		{
+			continue;
+		}
+
+		// Instances of an template that was migrated already have its overrides, but an instance may have saved its own value on top of the templates.
+		// Either way the value saved on this WJC is the one it was using, so it replaces whatever the template handed down.
+		FDWallJumpTuningOverride* ExistingOverride = TuningOverrides.FindByPredicate([Value](const FDWallJumpTuningOverride& Override) { return Override.Value == Value; });
+		if (ExistingOverride)
+		{
+			ExistingOverride->Amount = SavedAmount;
+		}
+		else
+		{
+			TuningOverrides.Emplace(Value, SavedAmount);
+		}
+	}
+
+	if ((ClingAnimLeft_DEPRECATED || ClingAnimRight_DEPRECATED || ClingAnimForward_DEPRECATED) && !Tuning)
+	{
+		// Saved within our own package, so resaving keeps the animations until the WJC is pointed at an shared Tuning instead.
+		Tuning = NewObject<UDWallJumpTuning>(this, NAME_None, RF_Public);
+		Tuning->ClingAnimLeft = ClingAnimLeft_DEPRECATED;
+		Tuning->ClingAnimRight = ClingAnimRight_DEPRECATED;
+		Tuning->ClingAnimForward = ClingAnimForward_DEPRECATED;
+	}
+	else if (Tuning && (ClingAnimLeft_DEPRECATED || ClingAnimRight_DEPRECATED || ClingAnimForward_DEPRECATED))
+	{
+		const bool bAnimsMatch = Tuning->ClingAnimLeft == ClingAnimLeft_DEPRECATED && Tuning->ClingAnimRight == ClingAnimRight_DEPRECATED && Tuning->ClingAnimForward == ClingAnimForward_DEPRECATED;
+		UE_CLOG(!bAnimsMatch, LogDWallJump, Warning, TEXT("%s has Cling animations saved from before UDWallJumpTuning, the ones in its Tuning %s are used instead."), *GetPathName(), *Tuning->GetName());
+	}
+
+	// They arent saved again, but the same object can be loaded more than once in the editor.
+	ResetDeprecatedTuning();
+}
+#endif // WITH_EDITORONLY_DATA
+
+#if WITH_EDITOR
+void UDWallJumpComponent::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	ResolveTuning();
+
+	// The flags can be edited on an WJC that is already Playing, templates pick their version in BeginPlay.
+	if (HasBegunPlay())
+	{
+		SelectWallJumpPolicy();
+	}
+
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+}
+#endif // WITH_EDITOR
+
+void UDWallJumpComponent::SetClingPitchSurfaceAngles(float MinAngle, float MaxAngle)
+{
+	// Both at once, ResolveTuning() clamps the Max against the Min.
+	SetTuningOverrideValue(EDWallJumpTuningValue::ClingMinPitchSurfaceAngle, FMath::Clamp(MinAngle, 0.f, 180.f));
+	SetTuningOverrideValue(EDWallJumpTuningValue::ClingMaxPitchSurfaceAngle, MaxAngle);
+
+	ResolveTuning();
+}
+
+void UDWallJumpComponent::SetClingMaxYawSurfaceAngle(float MaxAngle)
+{
+	SetTuningOverride(EDWallJumpTuningValue::ClingMaxYawSurfaceAngle, FMath::Clamp(MaxAngle, 0.f, 180.f));
+}
+
+void UDWallJumpComponent::SetCanWallCling(bool bCanCling)
+{
+	bCanWallCling = bCanCling;
+	SelectWallJumpPolicy();
+}
+
+void UDWallJumpComponent::SetCanWallJump(bool bCanJump)
+{
+	bCanWallJump = bCanJump;
+	SelectWallJumpPolicy();
+}
+
+void UDWallJumpComponent::SetRequireClingToWallJump(bool bRequireCling)
+{
+	bRequireClingToWallJump = bRequireCling;
+	SelectWallJumpPolicy();
+}
+
+void UDWallJumpComponent::SetTuning(UDWallJumpTuning* NewTuning)
+{
+	Tuning = NewTuning;
+
+	ResolveTuning();
+}
+
+void UDWallJumpComponent::SetTuningOverride(EDWallJumpTuningValue Value, float Amount)
+{
+	SetTuningOverrideValue(Value, Amount);
+
+	ResolveTuning();
+}
+
+void UDWallJumpComponent::SetTuningOverrideValue(EDWallJumpTuningValue Value, float Amount)
+{
+	for (FDWallJumpTuningOverride& Override : TuningOverrides)
+	{
+		if (Override.Value == Value)
+		{
+			Override.Amount = Amount;
+			return;
+		}
+	}
+
+	TuningOverrides.Emplace(Value, Amount);
+}
+
+void UDWallJumpComponent::ClearTuningOverride(EDWallJumpTuningValue Value)
+{
+	const int32 NumRemoved = TuningOverrides.RemoveAll([Value](const FDWallJumpTuningOverride& Override)
+	{
+		return Override.Value == Value;
+	});
+
+	if (NumRemoved > 0)
+	{
+		ResolveTuning();
+	}
+}
+
+float UDWallJumpComponent::GetTuningValue(EDWallJumpTuningValue Value) const
+{
+	return GetTuning().GetValue(Value);
+}
+
+void UDWallJumpComponent::ResolveTuning()
+{
+	// Without overrides GetTuning() reads the shared values directly, which is what keeps every WJC using an profile from needing its own copy.
+	// Reading them through the Tuning each time means an Tuning swapped or garbage collected out from under us is never left dangling.
+	if (TuningOverrides.Num() == 0)
+	{
+		OverriddenTuning.Reset();
+		return;
+	}
+
+	const FDWallJumpTuningValues& SharedTuning = Tuning ? Tuning->Values : FDWallJumpTuningValues::GetDefaults();
+
+	if (!OverriddenTuning.IsValid())
+	{
+		OverriddenTuning = MakeUnique<FDWallJumpTuningValues>();
+	}
+
+	*OverriddenTuning = SharedTuning;
+	for (const FDWallJumpTuningOverride& Override : TuningOverrides)
+	{
+		OverriddenTuning->SetValue(Override.Value, Override.Amount);
+	}
+	OverriddenTuning->UpdateDerivedValues();
+}
+
+float UDWallJumpComponent::RemainingClingTime()
+{
+	if(GetOwner() && IsClungToWall())
+	{
+		return WallClingReleaseTime > 0.f ? FMath::Max(WallClingReleaseTime - GetWorld()->GetTimeSeconds(), 0.f) : -1.f;
+	}
+
+	return -1;
+}
+
+void UDWallJumpComponent::NotifyInputBindingsChanged()
+{
+	JumpKeysGeneration++;
+}
+
+const TArray<FKey>& UDWallJumpComponent::GetJumpKeys()
+{
+	if (CachedJumpKeysGeneration != JumpKeysGeneration || CachedJumpKeysActionName != JumpActionName)
+	{
+		CachedJumpKeys.Reset();
+
+		for (const FInputActionKeyMapping& JumpMapping : UDUtility::GetKeysForActionMapping(nullptr, JumpActionName))
+		{
+			CachedJumpKeys.AddUnique(JumpMapping.Key);
+		}
+
+		CachedJumpKeysActionName = JumpActionName;
+		CachedJumpKeysGeneration = JumpKeysGeneration;
+	}
+
+	return CachedJumpKeys;
+}
+
+bool UDWallJumpComponent::IsJumpKeyDown(const APlayerController* PlayerController)
+{
+	if (PlayerController)
+	{
+		for (const FKey& JumpKey : GetJumpKeys())
+		{
+			if (PlayerController->IsInputKeyDown(JumpKey))
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+bool UDWallJumpComponent::WasJumpKeyJustPressed(const APlayerController* PlayerController)
+{
+	if (PlayerController)
+	{
+		for (const FKey& JumpKey : GetJumpKeys())
+		{
+			if (PlayerController->WasInputKeyJustPressed(JumpKey))
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+void UDWallJumpComponent::OnCharacterCapsuleHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
+{
+	DWALLJUMP_SCOPE_CYCLE_COUNTER(STAT_DWallJump_CapsuleHit);
+	check(OwningCharacter);
+
+	FDWallJumpStats& Stats = FDWallJumpStats::Get();
+
+	HitStats.HitsReceived++;
+	Stats.Increment(EDWallJumpCounter::HitsReceived);
+
+	// Reject as much as we can with the cheapest checks first, an Character sliding along geometry can raise dozens of these per movement update.
+	// Only static surfaces can be Clung to or Jumped from, and only if we havent exhausted both our Clings and Jumps.
+	if (!OtherComp || OtherComp->GetCollisionObjectType() != ECC_WorldStatic)
+	{
+		HitStats.HitsRejected++;
+		Stats.Increment(EDWallJumpCounter::RejectedSurfaceType);
+		return;
+	}
+
+	if (!CanHitStartWallJump() && !CanHitStartWallCling())
+	{
+		HitStats.HitsRejected++;
+		Stats.Increment(EDWallJumpCounter::RejectedExhausted);
+		return;
+	}
+
+	if (!IsWallJumpInputLocal())
+	{
+		HitStats.HitsRejected++;
+		Stats.Increment(EDWallJumpCounter::RejectedNotLocal);
+		return;
+	}
+
+	if (OwningCharacter->GetCharacterMovement()->MovementMode != EMovementMode::MOVE_Falling)
+	{
+		HitStats.HitsRejected++;
+		Stats.Increment(EDWallJumpCounter::RejectedNotFalling);
+		return;
+	}
+
+	UDWallJumpSubsystem* WallJumpSubsystem = GetWorld()->GetSubsystem<UDWallJumpSubsystem>();
+	if (!WallJumpSubsystem)
+	{
+		return;
+	}
+
+	// Repeated Hits against the same face of an wall are answered by the cache without looking at the Surface again.
+	// The cached Pitch check assumes the Characters Up is the World Up, anything else is left to the full evaluation.
+	FDWallSurfaceCacheEntry& Surface = WallJumpSubsystem->GetSurfaceCache().FindOrAdd(OtherComp, Hit, WallJumpSubsystem->GetSurfaceRules());
+	const bool bIsCharacterUpright = OwningCharacter->GetActorUpVector().Z >= 1.f - KINDA_SMALL_NUMBER;
+	const bool bSurfaceCanStartWallCling = Surface.AllowsCling() && CanHitStartWallCling();
+	const bool bSurfaceCanStartWallJump = Surface.AllowsJump() && CanHitStartWallJump();
+
+	if (!bSurfaceCanStartWallJump && (!bSurfaceCanStartWallCling || (bIsCharacterUpright && !Surface.IsPitchEligible(GetTuning().ClingMinPitchSurfaceAngleCos, GetTuning().ClingMaxPitchSurfaceAngleCos))))
+	{
+		// Only blame the Surface if it refused an Cling we could have made, otherwise the counts or an attempted WallJump ruled the Cling out.
+		HitStats.HitsRejected++;
+		Stats.Increment(bSurfaceCanStartWallCling ? EDWallJumpCounter::RejectedPitch : (CanHitStartWallCling() ? EDWallJumpCounter::RejectedSurfaceType : EDWallJumpCounter::RejectedCount));
+		return;
+	}
+
+	// Only keep the best Hit we receive this frame, it is evaluated by the UDWallJumpSubsystem once every CharacterMovementComponent has finished moving.
+	if (bHasPendingWallHit)
+	{
+		if (IsBetterWallHit(Hit, PendingWallHit, PendingWallHitTime))
+		{
+			PendingWallHit.SetFromHit(Hit);
+			PendingWallHit.SurfaceFlags = Surface.Flags;
+			PendingWallHitTime = Hit.Time;
+		}
+
+		HitStats.HitsCoalesced++;
+		Stats.Increment(EDWallJumpCounter::HitsCoalesced);
+		return;
+	}
+
+	PendingWallHit.SetFromHit(Hit);
+	PendingWallHit.SurfaceFlags = Surface.Flags;
+	PendingWallHitTime = Hit.Time;
+	bHasPendingWallHit = true;
+	WallJumpSubsystem->QueueWallHitEvaluation(this);
+}
+
+template<typename Policy>
+bool UDWallJumpComponent::GatherWallHitCandidate(FDWallHitCandidate& OutCandidate)
+{
+	check(OwningCharacter);
+
+	const FDWallJumpTuningValues& TuningValues = GetTuning();
+
+	bHasPendingWallHit = false;
+	HitStats.HitsEvaluated++;
+
+	// The Cling or Jump counts may have changed or we may have landed since the Hit was queued.
+	if (!IsWallJumpInputLocal() || OwningCharacter->GetCharacterMovement()->MovementMode != EMovementMode::MOVE_Falling)
+	{
+		return false;
+	}
+
+	// Find out if our Player is still holding down the "Jump" Action key.
+	APlayerController* OwningPlayerController = OwnerReferences.PlayerController.Get();
+	bool bJumpKeyDown = IsJumpKeyDown(OwningPlayerController); // An WallCling is determined to be that if the Player is still holding "Jump" while hitting the Surface.
+	bool bJumpJustPressed = WasJumpKeyJustPressed(OwningPlayerController); // An WallJump is determined to be that if the Player is against an surface an presses the "Jump" key.
+
+	// The Surface may not allow everything we otherwise could do.
+	FDWallJumpCoreSettings Settings = GetCoreSettings();
+	Settings.bSurfaceAllowsCling = (PendingWallHit.SurfaceFlags & EDWallSurfaceFlags::NoCling) == 0;
+	Settings.bSurfaceAllowsJump = (PendingWallHit.SurfaceFlags & EDWallSurfaceFlags::NoJump) == 0;
+
+	EDWallHitIntent Intent;
+	if (!FDWallJumpCore::DecideHitIntent<Policy>(Settings, GetCoreState(), bJumpKeyDown, bJumpJustPressed, Intent))
+	{
+		return false;
+	}
+
+	OutCandidate.Intent = Intent;
+
+	if (Intent == EDWallHitIntent::Jump)
+	{
+		APlayerCameraManager* OwningPlayerCameraManager = OwnerReferences.PlayerCameraManager.Get();
+		if (OwningPlayerCameraManager)
+		{
+			OutCandidate.LaunchVelocity = OwningPlayerCameraManager->GetCameraRotation().Vector() * TuningValues.WallJumpMagnitude;
+		}
+	}
+	else
+	{
+		PendingWallHit.SetCharacterYaw(OwningCharacter->GetActorRotation().Yaw);
+
+		OutCandidate.CharacterUp = OwningCharacter->GetActorUpVector();
+		OutCandidate.CharacterForward = OwningCharacter->GetActorForwardVector();
+		OutCandidate.CharacterSpeed = GetWallClingApproachSpeed();
+		OutCandidate.MinPitchSurfaceAngleCos = TuningValues.ClingMinPitchSurfaceAngleCos;
+		OutCandidate.MaxPitchSurfaceAngleCos = TuningValues.ClingMaxPitchSurfaceAngleCos;
+		OutCandidate.MaxYawSurfaceAngleCos = TuningValues.ClingMaxYawSurfaceAngleCos;
+		OutCandidate.MinSpeed = TuningValues.MinVelocityToWallCling;
+	}
+
+	WallClingContext.SetSurfaceFrom(PendingWallHit);
+	OutCandidate.SurfaceNormal = WallClingContext.GetImpactNormal();
+
+	return true;
+}
+
+template<typename Policy>
+void UDWallJumpComponent::GatherWallHitCandidates(EDWallJumpArchetype InPolicyArchetype, const TArray<TWeakObjectPtr<UDWallJumpComponent>>& Components, FDWallHitBatch& Batch, TArray<UDWallJumpComponent*>& BatchComponents)
+{
+	for (const TWeakObjectPtr<UDWallJumpComponent>& WeakComponent : Components)
+	{
+		UDWallJumpComponent* WallJumpComponent = WeakComponent.Get();
+		FDWallHitCandidate Candidate;
+
+		if (WallJumpComponent && WallJumpComponent->PolicyArchetype == InPolicyArchetype && WallJumpComponent->GatherWallHitCandidate<Policy>(Candidate))
+		{
+			Batch.Add(Candidate);
+			BatchComponents.Add(WallJumpComponent);
+		}
+	}
+}
+
+void UDWallJumpComponent::GatherWallHitCandidates(const TArray<TWeakObjectPtr<UDWallJumpComponent>>& Components, FDWallHitBatch& Batch, TArray<UDWallJumpComponent*>& BatchComponents)
+{
+	// An pass over the WJCs for each policy, so the decision is inlined into the loop rather than called through an pointer for every Hit.
+	// Every WJC has exactly one PolicyArchetype, so each is still gathered once.
+	GatherWallHitCandidates<FDWallJumpDynamicPolicy>(EDWallJumpArchetype::Dynamic, Components, Batch, BatchComponents);
+	GatherWallHitCandidates<FDWallJumpClingAndJumpPolicy>(EDWallJumpArchetype::ClingAndJump, Components, Batch, BatchComponents);
+	GatherWallHitCandidates<FDWallJumpClingThenJumpPolicy>(EDWallJumpArchetype::ClingThenJump, Components, Batch, BatchComponents);
+	GatherWallHitCandidates<FDWallJumpClingOnlyPolicy>(EDWallJumpArchetype::ClingOnly, Components, Batch, BatchComponents);
+	GatherWallHitCandidates<FDWallJumpJumpOnlyPolicy>(EDWallJumpArchetype::JumpOnly, Components, Batch, BatchComponents);
+}
+
+void UDWallJumpComponent::SelectWallJumpPolicy()
+{
+	const FDWallJumpCoreSettings Settings = GetCoreSettings();
+	bool bMatches = true;
+
+	switch (Archetype)
+	{
+	case EDWallJumpArchetype::ClingAndJump:
+		bMatches = FDWallJumpClingAndJumpPolicy::Matches(Settings);
+		break;
+	case EDWallJumpArchetype::ClingThenJump:
+		bMatches = FDWallJumpClingThenJumpPolicy::Matches(Settings);
+		break;
+	case EDWallJumpArchetype::ClingOnly:
+		bMatches = FDWallJumpClingOnlyPolicy::Matches(Settings);
+		break;
+	case EDWallJumpArchetype::JumpOnly:
+		bMatches = FDWallJumpJumpOnlyPolicy::Matches(Settings);
+		break;
+	default:
+		break;
+	}
+
+	UE_CLOG(!bMatches, LogDWallJump, Warning, TEXT("%s: the Cling and Jump flags dont match the Archetype, falling back to the Dynamic archetype."), *GetPathName());
+	PolicyArchetype = bMatches ? Archetype : EDWallJumpArchetype::Dynamic;
+}
+
+FDWallJumpCoreSettings UDWallJumpComponent::GetCoreSettings() const
+{
+	const FDWallJumpTuningValues& TuningValues = GetTuning();
+
+	FDWallJumpCoreSettings Settings;
+	Settings.bCanWallCling = bCanWallCling;
+	Settings.bCanWallJump = bCanWallJump;
+	Settings.bRequireClingToWallJump = bRequireClingToWallJump;
+	Settings.MaxSequentialWallClings = TuningValues.MaxSequentialWallClings;
+	Settings.MaxSequentialWallJumps = TuningValues.MaxSequentialWallJumps;
+	Settings.ClingDuration = TuningValues.ClingDuration;
+	Settings.WallJumpGracePeriodDuration = TuningValues.WallJumpInterferenceGracePeriodDuration;
+	Settings.WallJumpMagnitude = TuningValues.WallJumpMagnitude;
+	Settings.ClingDamageReleaseThreshold = TuningValues.ClingDamageReleaseThreshold;
+	Settings.MinPitchSurfaceAngleCos = TuningValues.ClingMinPitchSurfaceAngleCos;
+	Settings.MaxPitchSurfaceAngleCos = TuningValues.ClingMaxPitchSurfaceAngleCos;
+	Settings.MaxYawSurfaceAngleCos = TuningValues.ClingMaxYawSurfaceAngleCos;
+	Settings.MinSpeed = TuningValues.MinVelocityToWallCling;
+	return Settings;
+}
+
+FDWallJumpCoreState UDWallJumpComponent::GetCoreState() const
+{
+	FDWallJumpCoreState State;
+	State.WallClingCount = OwnerState.WallClingCount;
+	State.WallJumpCount = OwnerState.WallJumpCount;
+	State.bAttemptedWallJump = OwnerState.bAttemptedWallJump;
+	State.bIsClungToWall = bIsClungToWall;
+	State.WallClingReleaseTime = WallClingReleaseTime;
+	State.WallJumpGracePeriodEndTime = WallJumpGracePeriodEndTime;
+	State.ClingSurfaceNormal = WallClingContext.GetImpactNormal();
+	return State;
+}
+
+bool UDWallJumpComponent::GatherWallClingProbe(FDWallClingProbeRequest& OutRequest) const
+{
+	check(OwningCharacter);
+
+	// There is nothing worth predicting if we couldnt Cling to whatever is ahead of us, or are already too slow to.
+	if (!bPredictWallCling || !CanHitStartWallCling() || !IsWallJumpInputLocal())
+	{
+		return false;
+	}
+
+	const UCharacterMovementComponent* CharacterMovement = OwningCharacter->GetCharacterMovement();
+	if (CharacterMovement->MovementMode != EMovementMode::MOVE_Falling)
+	{
+		return false;
+	}
+
+	const FVector Velocity = CharacterMovement->Velocity;
+	const float Speed = Velocity.Size();
+	if (Speed < FMath::Max(GetTuning().MinVelocityToWallCling, KINDA_SMALL_NUMBER))
+	{
+		return false;
+	}
+
+	const UCapsuleComponent* Capsule = OwningCharacter->GetCapsuleComponent();
+
+	OutRequest.Start = Capsule->GetComponentLocation();
+	OutRequest.End = OutRequest.Start + Velocity * (GetWorld()->GetDeltaSeconds() * GetTuning().WallClingPredictionFrames);
+	OutRequest.Rotation = Capsule->GetComponentQuat();
+	OutRequest.Shape = Capsule->GetCollisionShape();
+	OutRequest.Channel = Capsule->GetCollisionObjectType();
+	OutRequest.Params = FCollisionQueryParams(SCENE_QUERY_STAT(DWallClingProbe), false, OwningCharacter);
+	OutRequest.ResponseParams = FCollisionResponseParams();
+	Capsule->InitSweepCollisionParams(OutRequest.Params, OutRequest.ResponseParams);
+	OutRequest.Speed = Speed;
+
+	return true;
+}
+
+void UDWallJumpComponent::ApplyWallClingProbe(const FHitResult& Hit, float ProbeSpeed)
+{
+	UPrimitiveComponent* Surface = Hit.GetComponent();
+	if (!Surface || Surface->GetCollisionObjectType() != ECC_WorldStatic)
+	{
+		return;
+	}
+
+	UDWallJumpSubsystem* WallJumpSubsystem = GetWorld()->GetSubsystem<UDWallJumpSubsystem>();
+	if (!WallJumpSubsystem)
+	{
+		return;
+	}
+
+	// Looking the Surface up now also means the Hit when we reach it is answered by the cache.
+	const FDWallSurfaceCacheEntry& Entry = WallJumpSubsystem->GetSurfaceCache().FindOrAdd(Surface, Hit, WallJumpSubsystem->GetSurfaceRules());
+	if (!Entry.AllowsCling())
+	{
+		return;
+	}
+
+	PredictedClingSurface = Surface;
+	PredictedClingNormal = Hit.ImpactNormal;
+	PredictedClingSpeed = ProbeSpeed;
+
+	// The probe looked WallClingPredictionFrames ahead, give the Character that long to reach the Surface plus the frame the result took to arrive.
+	PredictedClingExpireTime = GetWorld()->GetTimeSeconds() + GetWorld()->GetDeltaSeconds() * (GetTuning().WallClingPredictionFrames + 1);
+}
+
+bool UDWallJumpComponent::CheckWallClingPersistence(float MoveTolerance, bool& bOutNeedsProbe)
+{
+	bOutNeedsProbe = false;
+
+	// An destroyed wall is gone for good, there is nothing to probe for.
+	UPrimitiveComponent* Surface = WallClingContext.Surface.Get();
+	if (!Surface || Surface->IsPendingKill() || !Surface->IsCollisionEnabled())
+	{
+		ReleaseWallCling(EDWallClingReleaseReason::SurfaceLost);
+		return false;
+	}
+
+	// An moving platform may be carrying the Surface away from us.
+	bOutNeedsProbe = FVector::DistSquared(Surface->GetComponentLocation(), ClingSurfaceLocation) > FMath::Square(MoveTolerance);
+	return true;
+}
+
+bool UDWallJumpComponent::GatherClingPersistenceProbe(FDWallClingProbeRequest& OutRequest, float ProbeDistance)
+{
+	check(OwningCharacter);
+
+	const FVector SurfaceNormal = WallClingContext.GetImpactNormal();
+	if (SurfaceNormal.IsNearlyZero())
+	{
+		return false;
+	}
+
+	if (UPrimitiveComponent* Surface = WallClingContext.Surface.Get())
+	{
+		ClingSurfaceLocation = Surface->GetComponentLocation();
+	}
+
+	const UCapsuleComponent* Capsule = OwningCharacter->GetCapsuleComponent();
+
+	// An line through where the Capsule touched the Surface, from just off it to just into it. The Cling holds the Character in place so that is where the Surface has to still be.
+	// From the middle of the Capsule the line would miss an Surface that isnt vertical, which the Capsule touches with one of its hemispheres.
+	OutRequest.Start = WallClingContext.ImpactPoint + SurfaceNormal * ProbeDistance;
+	OutRequest.End = WallClingContext.ImpactPoint - SurfaceNormal * ProbeDistance;
+	OutRequest.Shape = FCollisionShape();
+	OutRequest.Channel = Capsule->GetCollisionObjectType();
+	OutRequest.Params = FCollisionQueryParams(SCENE_QUERY_STAT(DWallClingPersistence), false, OwningCharacter);
+	OutRequest.ResponseParams = FCollisionResponseParams();
+	Capsule->InitSweepCollisionParams(OutRequest.Params, OutRequest.ResponseParams);
+
+	return true;
+}
+
+bool UDWallJumpComponent::ApplyClingPersistenceProbe(const FHitResult* Hit)
+{
+	// We may have Jumped or Fallen while the probe was running.
+	if (!IsClungToWall())
+	{
+		return true;
+	}
+
+	if (!Hit)
+	{
+		ReleaseWallCling(EDWallClingReleaseReason::SurfaceLost);
+		return false;
+	}
+
+	return true;
+}
+
+float UDWallJumpComponent::GetWallClingApproachSpeed()
+{
+	check(OwningCharacter);
+
+	const float Speed = OwningCharacter->GetVelocity().Size();
+	bIsClingSpeedPredicted = false;
+
+	if (PredictedClingExpireTime <= 0.f)
+	{
+		return Speed;
+	}
+
+	// Hitting the Surface has already slowed us down, if we saw it coming then use the Speed we approached it with.
+	// The normal is compared loosely since the probe may have hit an neighbouring face of the same Surface.
+	const bool bIsPredictedSurface = PredictedClingSurface.IsValid() && PredictedClingSurface == PendingWallHit.Surface
+		&& (PredictedClingNormal | PendingWallHit.GetImpactNormal()) >= 0.95f && GetWorld()->GetTimeSeconds() <= PredictedClingExpireTime;
+
+	PredictedClingSurface.Reset();
+	PredictedClingExpireTime = 0.f;
+
+	if (bIsPredictedSurface && PredictedClingSpeed > Speed)
+	{
+		bIsClingSpeedPredicted = Speed < GetTuning().MinVelocityToWallCling;
+		return PredictedClingSpeed;
+	}
+
+	return Speed;
+}
+
+void UDWallJumpComponent::ApplyWallHitEvaluation(const FDWallHitEvaluation& Evaluation)
+{
+	if (Evaluation.Intent == EDWallHitIntent::Jump)
+	{
+		WallJump(Evaluation.RicochetVelocity);
+	}
+	else
+	{
+		WallCling(Evaluation);
+	}
+}
+
+bool UDWallJumpComponent::RequestAIWallMove(const FHitResult& Hit, bool bJump, FVector LaunchDirection)
+{
+	check(OwningCharacter);
+
+	const FDWallJumpTuningValues& TuningValues = GetTuning();
+
+	// Players decide with their Jump key in OnCharacterCapsuleHit(), the Server decides for its own AI.
+	if (OwningCharacter->Role != ROLE_Authority || OwningCharacter->IsPlayerControlled())
+	{
+		return false;
+	}
+
+	UDWallJumpSubsystem* WallJumpSubsystem = GetWorld()->GetSubsystem<UDWallJumpSubsystem>();
+	if (!WallJumpSubsystem)
+	{
+		return false;
+	}
+
+	const bool bIsFalling = OwningCharacter->GetCharacterMovement()->MovementMode == EMovementMode::MOVE_Falling;
+
+	FDWallAIMoveRequest Request;
+	Request.Component = this;
+	Request.bFromCling = bJump && IsClungToWall();
+
+	FDWallHitCandidate Candidate;
+	Candidate.Intent = bJump ? EDWallHitIntent::Jump : EDWallHitIntent::Cling;
+
+	if (Request.bFromCling)
+	{
+		if (!bCanWallJump || OwnerState.WallJumpCount >= TuningValues.MaxSequentialWallJumps)
+		{
+			return false;
+		}
+
+		Request.LaunchVelocity = LaunchDirection.GetSafeNormal() * TuningValues.WallJumpMagnitude;
+		Candidate.SurfaceNormal = WallClingContext.GetImpactNormal();
+		Candidate.LaunchVelocity = Request.LaunchVelocity;
+	}
+	else
+	{
+		if (!bIsFalling || (bJump ? !CanHitStartWallJump() : !CanHitStartWallCling()))
+		{
+			return false;
+		}
+
+		UPrimitiveComponent* Surface = Hit.GetComponent();
+		if (!Surface || Surface->GetCollisionObjectType() != ECC_WorldStatic)
+		{
+			return false;
+		}
+
+		const FDWallSurfaceCacheEntry& Entry = WallJumpSubsystem->GetSurfaceCache().FindOrAdd(Surface, Hit, WallJumpSubsystem->GetSurfaceRules());
+		if (bJump ? !Entry.AllowsJump() : !Entry.AllowsCling())
+		{
+			return false;
+		}
+
+		Request.Surface.SetFromHit(Hit);
+		Request.Surface.SurfaceFlags = Entry.Flags;
+		Request.Surface.SetCharacterYaw(OwningCharacter->GetActorRotation().Yaw);
+
+		Candidate.SurfaceNormal = Request.Surface.GetImpactNormal();
+
+		if (bJump)
+		{
+			Candidate.LaunchVelocity = LaunchDirection.GetSafeNormal() * TuningValues.WallJumpMagnitude;
+		}
+		else
+		{
+			Candidate.CharacterUp = OwningCharacter->GetActorUpVector();
+			Candidate.CharacterForward = OwningCharacter->GetActorForwardVector();
+			Candidate.CharacterSpeed = OwningCharacter->GetVelocity().Size();
+			Candidate.MinPitchSurfaceAngleCos = TuningValues.ClingMinPitchSurfaceAngleCos;
+			Candidate.MaxPitchSurfaceAngleCos = TuningValues.ClingMaxPitchSurfaceAngleCos;
+			Candidate.MaxYawSurfaceAngleCos = TuningValues.ClingMaxYawSurfaceAngleCos;
+			Candidate.MinSpeed = TuningValues.MinVelocityToWallCling;
+		}
+	}
+
+	WallJumpSubsystem->QueueAIWallMove(Request, Candidate);
+	FDWallJumpStats::Get().Increment(EDWallJumpCounter::AIRequests);
+
+	return true;
+}
+
+void UDWallJumpComponent::ApplyAIWallMove(const FDWallAIMoveRequest& Request, const FDWallHitEvaluation& Evaluation)
+{
+	check(OwningCharacter);
+
+	const bool bJump = Evaluation.Intent == EDWallHitIntent::Jump;
+	bool bAccepted = false;
+
+	// The request spent an frame on the worker threads, anything could have happened to the Character since it was made.
+	if (Request.bFromCling)
+	{
+		if (IsClungToWall() && bCanWallJump && OwnerState.WallJumpCount < GetTuning().MaxSequentialWallJumps)
+		{
+			WallJump(Request.LaunchVelocity);
+			bAccepted = true;
+		}
+	}
+	else if (OwningCharacter->GetCharacterMovement()->MovementMode == EMovementMode::MOVE_Falling)
+	{
+		if (bJump && CanHitStartWallJump())
+		{
+			WallClingContext.SetSurfaceFrom(Request.Surface);
+			WallJump(Evaluation.RicochetVelocity);
+			bAccepted = true;
+		}
+		else if (!bJump && CanHitStartWallCling())
+		{
+			WallClingContext.SetSurfaceFrom(Request.Surface);
+			bAccepted = FDWallJumpCore::IsClingAccepted(Evaluation, OwnerState.bAttemptedWallJump);
+			WallCling(Evaluation);
+		}
+	}
+
+	OnAIWallMoveDecidedDelegate.Broadcast(bJump, bAccepted);
+}
+
+bool UDWallJumpComponent::CanHitStartWallJump() const
+{
+	// An Hit never starts an WallJump if we are required to Cling first, that is handled by CheckWallClingJump().
+	return bCanWallJump && !bRequireClingToWallJump && OwnerState.WallJumpCount < GetTuning().MaxSequentialWallJumps;
+}
+
+bool UDWallJumpComponent::CanHitStartWallCling() const
+{
+	// WallCling() rejects the Cling while bAttemptedWallJump is set, so there is no need to consider the Hit.
+	return bCanWallCling && !bIsClungToWall && !OwnerState.bAttemptedWallJump && OwnerState.WallClingCount < GetTuning().MaxSequentialWallClings;
+}
+
+bool UDWallJumpComponent::IsBetterWallHit(const FHitResult& Candidate, const FDWallClingContext& Current, float CurrentTime)
+{
+	// Prefer the most vertical surface since that is what we are looking to Cling to, otherwise prefer whatever we hit first along the move.
+	// The Current normal is quantized so compare with an tolerance that covers its precision.
+	const float CandidateSlope = FMath::Abs(Candidate.ImpactNormal.Z);
+	const float CurrentSlope = FMath::Abs(Current.GetImpactNormalZ());
+
+	if (!FMath::IsNearlyEqual(CandidateSlope, CurrentSlope, 1.f / MAX_int16))
+	{
+		return CandidateSlope < CurrentSlope;
+	}
+
+	return Candidate.Time < CurrentTime;
+}
+
+void UDWallJumpComponent::ResetHitStats()
+{
+	HitStats = FDWallJumpHitStats();
+}
+
+void UDWallJumpComponent::OnCharacterLanded(const FHitResult& Hit)
+{
+	// Reset our jump and cling counters when we land on an walkable surface.
+	OwnerState.WallJumpCount = 0;
+	OwnerState.WallClingCount = 0;
+	OwnerState.bAttemptedWallJump = false;
+}
+
+void UDWallJumpComponent::OnCharacterTookAnyDamage(AActor* DamagedActor, float Damage, const UDamageType* DamageType, AController* InstigatedBy, AActor* DamageCauser)
+{
+	if (IsClungToWall() && Damage >= GetTuning().ClingDamageReleaseThreshold)
+	{
+		ReleaseWallCling(EDWallClingReleaseReason::Damaged);
+	}
+}
+
+void UDWallJumpComponent::PerformCharacterWallMove_Server_Implementation(const FDWallJumpMovePacket& WallMove)
+{
+	// The packet is Unreliable so it can arrive out of order or be duplicated, anything older than what we have already applied is stale.
+	if (WallMove.Timestamp <= LastServerWallMoveTimestamp)
+	{
+		return;
+	}
+
+	LastServerWallMoveTimestamp = WallMove.Timestamp;
+
+	// The actions are for the Clients move with MoveTimestamp, if we have already performed that move they came too late to apply to it.
+	if (WallJumpMovement && WallMove.MoveTimestamp > 0.f && WallJumpMovement->HasClientMovePassed(WallMove.MoveTimestamp))
+	{
+		return;
+	}
+
+	// Whatever we perform below is approved for that move only, see PerformCharacterWallJump() and SetClingMovementMode().
+	TGuardValue<float> ClientMoveGuard(ServerClientMoveTimestamp, WallMove.MoveTimestamp);
+
+	// An Jump and an Cling in the same frame can only happen in this order, since an Cling cant start during the WallJump grace period.
+	// Rebuild the launch from the direction rather than trusting an velocity from the Client, every WallJump launches at exactly WallJumpMagnitude.
+	if (WallMove.HasAction(EDWallJumpMoveFlags::Jump) && IsServerWallJumpValid(WallMove.JumpDirection))
+	{
+		PerformCharacterWallJump(WallMove.JumpDirection * GetTuning().WallJumpMagnitude);
+	}
+
+	FHitResult SurfaceHit;
+	uint8 SurfaceFlags = 0;
+	if (WallMove.HasAction(EDWallJumpMoveFlags::Cling) && IsServerWallClingValid(WallMove.ClingSurfaceNormal, SurfaceHit, SurfaceFlags))
+	{
+		// The Server never sees the Clients Capsule Hit, so Cling to the Surface it found itself with the normal from the packet.
+		WallClingContext.Surface = SurfaceHit.GetComponent();
+		WallClingContext.ImpactPoint = SurfaceHit.ImpactPoint;
+		WallClingContext.SurfaceFlags = SurfaceFlags;
+		WallClingContext.SetImpactNormal(WallMove.ClingSurfaceNormal);
+		WallClingContext.SetCharacterYaw(OwningCharacter->GetActorRotation().Yaw);
+
+		PerformCharacterWallCling();
+	}
+}
+
+bool UDWallJumpComponent::PerformCharacterWallMove_Server_Validate(const FDWallJumpMovePacket& WallMove)
+{
+	// Only reject packets that could never have come from an valid Client, anything that just disagrees with our state is dropped in the implementation.
+	return FMath::IsFinite(WallMove.Timestamp) && !WallMove.JumpDirection.ContainsNaN() && !WallMove.ClingSurfaceNormal.ContainsNaN();
+}
+
+FVector UDWallJumpComponent::GetCapsuleContactPoint(const FVector& SurfaceNormal) const
+{
+	check(OwningCharacter);
+
+	const UCapsuleComponent* Capsule = OwningCharacter->GetCapsuleComponent();
+	const FVector CapsuleUp = Capsule->GetUpVector();
+
+	// An Surface facing up is touched by the bottom hemisphere and one facing down by the top, an vertical one anywhere along the middle.
+	const float HemisphereSide = FMath::Sign(FVector::DotProduct(CapsuleUp, SurfaceNormal));
+	const FVector HemisphereCenter = Capsule->GetComponentLocation() - CapsuleUp * (Capsule->GetScaledCapsuleHalfHeight_WithoutHemisphere() * HemisphereSide);
+
+	return HemisphereCenter - SurfaceNormal * Capsule->GetScaledCapsuleRadius();
+}
+
+bool UDWallJumpComponent::IsServerWallJumpValid(const FVector& JumpDirection) const
+{
+	check(OwningCharacter);
+
+	if (!bCanWallJump || OwnerState.WallJumpCount >= GetTuning().MaxSequentialWallJumps)
+	{
+		return false;
+	}
+
+	// The direction arrives quantized, anything far from unit length wasnt made by GetSafeNormal() on an Client.
+	return FMath::IsNearlyEqual(JumpDirection.SizeSquared(), 1.f, 0.01f);
+}
+
+bool UDWallJumpComponent::IsServerWallClingValid(const FVector& SurfaceNormal, FHitResult& OutSurfaceHit, uint8& OutSurfaceFlags) const
+{
+	check(OwningCharacter);
+
+	const FDWallJumpTuningValues& TuningValues = GetTuning();
+
+	if (!bCanWallCling || IsClungToWall() || OwnerState.bAttemptedWallJump || OwnerState.WallClingCount >= TuningValues.MaxSequentialWallClings)
+	{
+		return false;
+	}
+
+	// Redo the Cling angle checks against where the Server thinks the Character is, widened by ServerClingAngleTolerance.
+	const float ClingPitchImpactDot = FVector::DotProduct(OwningCharacter->GetActorUpVector(), SurfaceNormal);
+	const float ClingYawImpactCos = OwningCharacter->GetActorForwardVector().CosineAngle2D(SurfaceNormal * -1.f);
+
+	if (ClingPitchImpactDot < TuningValues.ServerClingMaxPitchSurfaceAngleCos || ClingPitchImpactDot > TuningValues.ServerClingMinPitchSurfaceAngleCos || ClingYawImpactCos < TuningValues.ServerClingMaxYawSurfaceAngleCos)
+	{
+		return false;
+	}
+
+	// The angles only tell us the Client could have Clung to something, make sure there really is an Surface behind the normal within ServerClingSurfaceTolerance of the Capsule.
+	const UCapsuleComponent* Capsule = OwningCharacter->GetCapsuleComponent();
+	const float CapsuleRadius = Capsule->GetScaledCapsuleRadius();
+	const FVector Start = GetCapsuleContactPoint(SurfaceNormal) + SurfaceNormal * CapsuleRadius;
+	const FVector End = Start - SurfaceNormal * (CapsuleRadius + TuningValues.ServerClingSurfaceTolerance);
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(DWallClingServerCheck), false, OwningCharacter);
+	FCollisionResponseParams ResponseParams;
+	Capsule->InitSweepCollisionParams(Params, ResponseParams);
+	Params.bReturnPhysicalMaterial = true;
+
+	if (!GetWorld()->LineTraceSingleByChannel(OutSurfaceHit, Start, End, Capsule->GetCollisionObjectType(), Params, ResponseParams))
+	{
+		return false;
+	}
+
+	// The same rules as an Capsule Hit on the Client, see OnCharacterCapsuleHit().
+	UPrimitiveComponent* Surface = OutSurfaceHit.GetComponent();
+	if (!Surface || Surface->GetCollisionObjectType() != ECC_WorldStatic)
+	{
+		return false;
+	}
+
+	UDWallJumpSubsystem* WallJumpSubsystem = GetWorld()->GetSubsystem<UDWallJumpSubsystem>();
+	if (!WallJumpSubsystem)
+	{
+		return false;
+	}
+
+	const FDWallSurfaceCacheEntry& Entry = WallJumpSubsystem->GetSurfaceCache().FindOrAdd(Surface, OutSurfaceHit, WallJumpSubsystem->GetSurfaceRules());
+	OutSurfaceFlags = Entry.Flags;
+	return Entry.AllowsCling();
+}
+
+void UDWallJumpComponent::PerformCharacterWallJump(const FVector& LaunchVelocity)
+{
+	check(OwningCharacter);
+
+	FDWallJumpStats::Get().Increment(EDWallJumpCounter::Jumps);
+
+	OwnerState.IncrementWallJumpCount();
+	OwnerState.bAttemptedWallJump = true;
+	StartWallJumpGracePeriod();
+
+	// If we are already clung to an wall then we need to make sure to reset the CMCs gravity and movement locks.
+	if (IsClungToWall())
+	{
+		ReleaseWallCling(EDWallClingReleaseReason::Jumped);
+	}
+
+	if (WallJumpMovement)
+	{
+		WallJumpMovement->RequestWallJump(LaunchVelocity, ServerClientMoveTimestamp);
+	}
+	else
+	{
+		OwningCharacter->LaunchCharacter(LaunchVelocity, true, true);
+	}
+
+	FDWallJumpEvent JumpedEvent(EDWallJumpEventType::Jumped);
+	JumpedEvent.Location = OwningCharacter->GetActorLocation();
+	JumpedEvent.LaunchVelocity = LaunchVelocity;
+	BroadcastWallJumpEvent(JumpedEvent);
+}
+
+void UDWallJumpComponent::PerformCharacterWallCling()
+{
+	DWALLJUMP_SCOPE_CYCLE_COUNTER(STAT_DWallJump_ClingTransition);
+	check(OwningCharacter);
+
+	// Move the Character once for the whole Cling, see ReleaseWallCling().
+	FScopedMovementUpdate ScopedClingUpdate(OwningCharacter->GetRootComponent(), EScopedUpdate::DeferredUpdates);
+
+	FDWallJumpStats::Get().Increment(EDWallJumpCounter::Clings);
+
+	OwnerState.IncrementWallClingCount();
+	SetIsClungToWall(true);
+	OwnerState.bAttemptedWallJump = false;
+
+	StartWallClingDuration();
+
+	SetClingMovementMode(true);
+	BroadcastClungToWallEvent();
+
+	AlignCharacterMeshForCling();
+	ApplyWallClingLookInputRestrictions();
+}
+
+void UDWallJumpComponent::SendWallJump(const FVector& LaunchVelocity)
+{
+	check(OwningCharacter);
+
+	// The Server doesnt need to send itself anything.
+	if (OwningCharacter->Role == ROLE_Authority)
+	{
+		PerformCharacterWallJump(LaunchVelocity);
+		return;
+	}
+
+	PendingWallMove.Flags |= EDWallJumpMoveFlags::Jump;
+	PendingWallMove.JumpDirection = LaunchVelocity.GetSafeNormal();
+
+	// The saved move that carries the Jump sends the packet with its TimeStamp, see FSavedMove_DWallJump::SetMoveFor().
+	if (!WallJumpMovement)
+	{
+		QueueWallMoveFlush();
+	}
+}
+
+void UDWallJumpComponent::SendWallCling()
+{
+	check(OwningCharacter);
+
+	if (OwningCharacter->Role == ROLE_Authority)
+	{
+		PerformCharacterWallCling();
+		return;
+	}
+
+	PendingWallMove.Flags |= EDWallJumpMoveFlags::Cling;
+	PendingWallMove.ClingSurfaceNormal = WallClingContext.GetImpactNormal();
+
+	if (!WallJumpMovement)
+	{
+		QueueWallMoveFlush();
+	}
+}
+
+void UDWallJumpComponent::QueueWallMoveFlush()
+{
+	// Everything we do this frame goes out in one packet once every Character has been evaluated.
+	UDWallJumpSubsystem* WallJumpSubsystem = GetWorld()->GetSubsystem<UDWallJumpSubsystem>();
+	if (WallJumpSubsystem)
+	{
+		WallJumpSubsystem->QueueWallMoveFlush(this);
+	}
+	else
+	{
+		FlushWallMove();
+	}
+}
+
+void UDWallJumpComponent::FlushWallMove(float MoveTimestamp /*= 0.f*/)
+{
+	if (PendingWallMove.Flags != EDWallJumpMoveFlags::None)
+	{
+		PendingWallMove.Timestamp = GetWorld()->GetTimeSeconds();
+		PendingWallMove.MoveTimestamp = MoveTimestamp;
+		PerformCharacterWallMove_Server(PendingWallMove);
+		PendingWallMove = FDWallJumpMovePacket();
+	}
+}
+
+void UDWallJumpComponent::SetClingMovementMode(bool bEnable /*= true*/)
+{
+	check(OwningCharacter);
+
+	// Nothing tells us when the CharacterMovementComponent is swapped, but it is cheap to notice here.
+	if (OwnerReferences.CharacterMovement != OwningCharacter->GetCharacterMovement())
+	{
+		RefreshOwnerReferences();
+	}
+
+	// The UDWallJumpMovementComponent has its own movement mode for Clinging that is predicted and replayed with the rest of the Characters movement.
+	if (WallJumpMovement)
+	{
+		if (bEnable)
+		{
+			WallJumpMovement->RequestWallCling(ServerClientMoveTimestamp);
+		}
+		else
+		{
+			WallJumpMovement->RequestWallClingRelease();
+		}
+
+		SetIsClungToWall(bEnable);
+		return;
+	}
+
+	const UCharacterMovementComponent* DefaultCMC = OwnerReferences.DefaultCharacterMovement;
+
+	if (bEnable)
+	{
+		OwningCharacter->GetCharacterMovement()->DisableMovement();
+		OwningCharacter->GetCharacterMovement()->GravityScale = 0;
+		OwningCharacter->GetCharacterMovement()->Velocity = FVector::ZeroVector;
+		SetIsClungToWall(true);
+	}
+	else
+	{
+		OwningCharacter->GetCharacterMovement()->SetMovementMode(MOVE_Falling);
+		OwningCharacter->GetCharacterMovement()->GravityScale = DefaultCMC ? DefaultCMC->GravityScale : 1.f;
+		SetIsClungToWall(false);
+	}
+}
+
+void UDWallJumpComponent::ReleaseWallCling(EDWallClingReleaseReason Reason /*= EDWallClingReleaseReason::Fell*/)
+{
+	DWALLJUMP_SCOPE_CYCLE_COUNTER(STAT_DWallJump_ClingTransition);
+	check(OwningCharacter);
+
+	// Everything below that touches the Characters transform is applied together when this goes out of scope,
+	// so the attached Components are moved and their overlaps updated once.
+	FScopedMovementUpdate ScopedClingUpdate(OwningCharacter->GetRootComponent(), EScopedUpdate::DeferredUpdates);
+
+	// The Server leaves the Cling mode immediately below, which would otherwise call back into OnWallClingMovementModeLeft().
+	TGuardValue<bool> ReleasingGuard(bIsReleasingWallCling, true);
+
+	SetClingMovementMode(false);
+
+	// Clear the Cling deadline since we are already releasing from the Cling.
+	WallClingReleaseTime = 0.f;
+
+	// Each release is counted once, an Jump is counted by whatever Launched the Character.
+	switch (Reason)
+	{
+	case EDWallClingReleaseReason::Fell:
+		FDWallJumpStats::Get().Increment(EDWallJumpCounter::Falls);
+		break;
+	case EDWallClingReleaseReason::Damaged:
+		FDWallJumpStats::Get().Increment(EDWallJumpCounter::DamageReleases);
+		break;
+	case EDWallClingReleaseReason::SurfaceLost:
+		FDWallJumpStats::Get().Increment(EDWallJumpCounter::ClingsLost);
+		break;
+	default:
+		break;
+	}
+
+	if (Reason != EDWallClingReleaseReason::Jumped)
+	{
+		FDWallJumpEvent FellEvent(EDWallJumpEventType::Fell);
+		FellEvent.SurfaceNormal = WallClingContext.GetImpactNormal();
+		FellEvent.Location = OwningCharacter->GetActorLocation();
+		BroadcastWallJumpEvent(FellEvent);
+	}
+
+	// When we initially Clung we hold the Characters Rotation in place and ignore user input, so we need to set it back to its original value.
+	if (bIsMeshAlignedForCling)
+	{
+		SetClingRotation(WallClingContext.GetOriginalRotation());
+		OwningCharacter->bUseControllerRotationYaw = bOriginalControllerRotationYawUseBeforeCling;
+		bIsMeshAlignedForCling = false;
+	}
+
+	// Reset any Look Input Restrictions that may have been applied.
+	ADignityCharacter* DignityCharacter = OwnerReferences.DignityCharacter;
+	if (DignityCharacter)
+	{
+		DignityCharacter->RestrictCameraViewAngles(ERestrictLookInput::RLI_None, FVector2D::ZeroVector, FVector2D::ZeroVector);
+	}
+}
+
+void UDWallJumpComponent::WallJump(const FVector& RicochetVelocity)
+{
+	DWALLJUMP_SCOPE_CYCLE_COUNTER(STAT_DWallJump_WallJump);
+	check(OwningCharacter);
+
+	const FDWallClingContext& ClingContext = WallClingContext;
+
+	// Tell the Server we are jumping and update the jump information locally if needed.
+	SendWallJump(RicochetVelocity);
+	if (OwningCharacter->Role <= ROLE_AutonomousProxy)
+	{
+		FDWallJumpStats::Get().Increment(EDWallJumpCounter::Jumps);
+
+		FDWallJumpEvent JumpedEvent(EDWallJumpEventType::Jumped);
+		JumpedEvent.SurfaceNormal = ClingContext.GetImpactNormal();
+		JumpedEvent.Location = ClingContext.ImpactPoint;
+		JumpedEvent.LaunchVelocity = RicochetVelocity;
+		BroadcastWallJumpEvent(JumpedEvent);
+		OwnerState.IncrementWallJumpCount();
+		OwnerState.bAttemptedWallJump = true;
+
+		if (WallJumpMovement)
+		{
+			WallJumpMovement->RequestWallJump(RicochetVelocity);
+		}
+
+		StartWallJumpGracePeriod();
+	}
+
+#if !UE_BUILD_SHIPPING && DIGNITY_DEVELOPMENT
+	if (bDebugWallJump)
+	{
+		FDWallJumpDebugRecord DebugRecord;
+		DebugRecord.Action = EDWallJumpDebugAction::Jump;
+		DebugRecord.bAccepted = true;
+		DebugRecord.Location = ClingContext.ImpactPoint;
+		DebugRecord.Normal = ClingContext.GetImpactNormal();
+		DebugRecord.Direction = RicochetVelocity;
+		RecordWallJumpDebug(DebugRecord);
+	}
+#endif //!UE_BUILD_SHIPPING && DIGNITY_DEVELOPMENT
+}
+
+void UDWallJumpComponent::CheckWallClingJump()
+{
+	DWALLJUMP_SCOPE_CYCLE_COUNTER(STAT_DWallJump_CheckWallClingJump);
+
+	if (IsWallJumpInputLocal())
+	{
+		if (IsClungToWall() && bCanWallJump)
+		{
+			// Hack for detecting if we are Jumping while in an Cling, unfortunately ActionMappings are single bind delegates and wont allow multiple subscribers so we need to detect this ourselves.
+			// If the Character class exposed an OnJumped delegate then this wouldnt be an issue but it doesnt so it is.
+			APlayerController* OwningPlayerController = OwnerReferences.PlayerController.Get();
+			bool bJumpJustPressed = WasJumpKeyJustPressed(OwningPlayerController); // An WallJump can occur from an Cling position if we press "Jump" Action Key.
+
+			if (OwningPlayerController && bJumpJustPressed)
+			{
+				APlayerCameraManager* OwningPlayerCameraManager = OwnerReferences.PlayerCameraManager.Get();
+				if (OwningPlayerCameraManager)
+				{
+					// Launch along the Camera direction only, the Server rebuilds the same velocity from the direction in our packet.
+					const FVector LaunchVelocity = OwningPlayerCameraManager->GetCameraRotation().Vector() * GetTuning().WallJumpMagnitude;
+
+					// Tell the Server we are jumping and update the jump information locally if needed.
+					SendWallJump(LaunchVelocity);
+					if (OwningCharacter->Role <= ROLE_AutonomousProxy)
+					{
+						FDWallJumpStats::Get().Increment(EDWallJumpCounter::Jumps);
+						OwnerState.IncrementWallJumpCount();
+						OwnerState.bAttemptedWallJump = true;
+						ReleaseWallCling(EDWallClingReleaseReason::Jumped);
+
+						if (WallJumpMovement)
+						{
+							WallJumpMovement->RequestWallJump(LaunchVelocity);
+						}
+
+						FDWallJumpEvent JumpedEvent(EDWallJumpEventType::Jumped);
+						JumpedEvent.SurfaceNormal = WallClingContext.GetImpactNormal();
+						JumpedEvent.Location = OwningCharacter->GetActorLocation();
+						JumpedEvent.LaunchVelocity = LaunchVelocity;
+						BroadcastWallJumpEvent(JumpedEvent);
+					}
+
+#if !UE_BUILD_SHIPPING && DIGNITY_DEVELOPMENT
+					if (bDebugWallJump)
+					{
+						FDWallJumpDebugRecord DebugRecord;
+						DebugRecord.Action = EDWallJumpDebugAction::ClingJump;
+						DebugRecord.bAccepted = true;
+						DebugRecord.Location = OwningCharacter->GetActorLocation();
+						DebugRecord.Normal = WallClingContext.GetImpactNormal();
+						DebugRecord.Direction = LaunchVelocity;
+						RecordWallJumpDebug(DebugRecord);
+					}
+#endif //!UE_BUILD_SHIPPING && DIGNITY_DEVELOPMENT
+				}
+			}
+		}
+	}
+}
+
+void UDWallJumpComponent::WallCling(const FDWallHitEvaluation& Evaluation)
+{
+	DWALLJUMP_SCOPE_CYCLE_COUNTER(STAT_DWallJump_WallCling);
+	check(OwningCharacter);
+
+	const FDWallClingContext& ClingContext = WallClingContext;
+
+	// The approach angle of the Character and the Surface angle have already been checked against our tolerances by the UDWallJumpSubsystem.
+	// The tolerances are compared as cosines so we dont need to convert the angles back into degrees, see FDWallJumpTuningValues::UpdateDerivedValues().
+	const float ClingPitchImpactDot = Evaluation.PitchDot;
+	const float ClingYawImpactCos = Evaluation.YawCos;
+
+	// If the calculated angles are within our tolerances then we have an valid surface.
+	const bool bIsClingPitchImpactDegreeValid = Evaluation.bIsPitchValid;
+	const bool bIsClingYawImpactDegreeValid = Evaluation.bIsYawValid;
+
+	if (FDWallJumpCore::IsClingAccepted(Evaluation, OwnerState.bAttemptedWallJump))
+	{
+		// Tell the Server we are clinging and update cling information locally if needed.
+		SendWallCling();
+		if (OwningCharacter->Role <= ROLE_AutonomousProxy)
+		{
+			DWALLJUMP_SCOPE_CYCLE_COUNTER(STAT_DWallJump_ClingTransition);
+
+			// Move the Character once for the whole Cling, see ReleaseWallCling().
+			FScopedMovementUpdate ScopedClingUpdate(OwningCharacter->GetRootComponent(), EScopedUpdate::DeferredUpdates);
+
+			FDWallJumpStats::Get().Increment(EDWallJumpCounter::Clings);
+			OwnerState.IncrementWallClingCount();
+
+			// The prediction is what got us onto this wall.
+			if (bIsClingSpeedPredicted)
+			{
+				FDWallJumpStats::Get().Increment(EDWallJumpCounter::PredictedClings);
+			}
+
+			// Predict the Cling locally if our CharacterMovementComponent supports it, otherwise we wait for the Server to move us.
+			if (WallJumpMovement)
+			{
+				SetClingMovementMode(true);
+			}
+			else
+			{
+				SetIsClungToWall(true);
+			}
+
+			BroadcastClungToWallEvent();
+
+			AlignCharacterMeshForCling();
+			ApplyWallClingLookInputRestrictions();
+
+			//Locally apply the cling duration so we can get the OnFell broadcast.
+			StartWallClingDuration();
+		}
+	}
+	else
+	{
+		// Count the first reason the surface was rejected for.
+		FDWallJumpStats& Stats = FDWallJumpStats::Get();
+		if (!bIsClingPitchImpactDegreeValid)
+		{
+			Stats.Increment(EDWallJumpCounter::RejectedPitch);
+		}
+		else if (!bIsClingYawImpactDegreeValid)
+		{
+			Stats.Increment(EDWallJumpCounter::RejectedYaw);
+		}
+		else if (!Evaluation.bIsSpeedValid)
+		{
+			Stats.Increment(EDWallJumpCounter::RejectedSpeed);
+		}
+		else
+		{
+			Stats.Increment(EDWallJumpCounter::RejectedGracePeriod);
+		}
+	}
+
+#if !UE_BUILD_SHIPPING && DIGNITY_DEVELOPMENT
+	if (bDebugWallCling)
+	{
+		FDWallJumpDebugRecord DebugRecord;
+		DebugRecord.Action = EDWallJumpDebugAction::Cling;
+		DebugRecord.bAccepted = bIsClingPitchImpactDegreeValid && bIsClingYawImpactDegreeValid;
+		DebugRecord.Location = ClingContext.ImpactPoint;
+		DebugRecord.Normal = ClingContext.GetImpactNormal();
+		DebugRecord.Direction = ClingContext.GetCharacterForward();
+		DebugRecord.Right = ClingContext.GetCharacterRight();
+		DebugRecord.AngleA = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(ClingPitchImpactDot, -1.f, 1.f)));
+		DebugRecord.AngleB = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(ClingYawImpactCos, -1.f, 1.f)));
+		RecordWallJumpDebug(DebugRecord);
+	}
+#endif //!UE_BUILD_SHIPPING && DIGNITY_DEVELOPMENT
+}
+
+void UDWallJumpComponent::AlignCharacterMeshForCling()
+{
+	DWALLJUMP_SCOPE_CYCLE_COUNTER(STAT_DWallJump_AlignMesh);
+	check(OwningCharacter);
+
+	if (IsClungToWall())
+	{
+		const FVector SurfaceNormalForwardVector = WallClingContext.GetImpactNormal();
+
+		// Compare the ForwardVector when we hit the surface to the Right and Left vectors of the surface normal so we can determine what side the Character is facing.
+		float CharacterRightSideNormalCos;
+		bIsCharacterHoldingWallRightSide = FDWallJumpCore::IsHoldingWallRightSide(WallClingContext.GetCharacterForward(), SurfaceNormalForwardVector, GetTuning().ClingMaxYawSurfaceAngleCos, CharacterRightSideNormalCos);
+		UpdateClingPose();
+
+		// Nobody is close enough to see an Low significance Character turn to the wall, the side it holds is all its Animations need.
+		// The Server still has to turn it, its Rotation is what replicates to everyone else and what the Cling jump and release start from.
+		if (Significance == EDWallJumpSignificance::Low && OwningCharacter->Role < ROLE_Authority)
+		{
+			FDWallJumpStats::Get().RecordSkippedWork(EDWallJumpSkippableWork::AlignMesh);
+			return;
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+
+		// Hold the Character in the Rotation that is parallel to the Surface we Clung to or the against the SurfaceNormal.
+		// This is released in ReleaseCling().
+		WallClingContext.SetOriginalRotation(OwningCharacter->GetActorRotation());
+		SetClingRotation(GetClingRotation(SurfaceNormalForwardVector, bIsCharacterHoldingWallRightSide, bHoldCharacterMeshPerpendicularToSurface));
+		bOriginalControllerRotationYawUseBeforeCling = OwningCharacter->bUseControllerRotationYaw;
+		OwningCharacter->bUseControllerRotationYaw = false;
+		bIsMeshAlignedForCling = true;
+
+		FDWallJumpStats::Get().RecordWorkCost(EDWallJumpSkippableWork::AlignMesh, FPlatformTime::Seconds() - StartTime);
+
+#if !UE_BUILD_SHIPPING && DIGNITY_DEVELOPMENT
+		if (bDebugWallCling)
+		{
+			// The Left vector is the inverse of the Right so its cosine is too.
+			FDWallJumpDebugRecord DebugRecord;
+			DebugRecord.Action = EDWallJumpDebugAction::Align;
+			DebugRecord.bAccepted = bIsCharacterHoldingWallRightSide;
+			DebugRecord.Location = WallClingContext.ImpactPoint;
+			DebugRecord.Normal = SurfaceNormalForwardVector;
+			DebugRecord.AngleA = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(CharacterRightSideNormalCos, -1.f, 1.f)));
+			DebugRecord.AngleB = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(-CharacterRightSideNormalCos, -1.f, 1.f)));
+			RecordWallJumpDebug(DebugRecord);
+		}
+#endif //!UE_BUILD_SHIPPING && DIGNITY_DEVELOPMENT
+	}
+}
+
+void UDWallJumpComponent::SetClingRotation(const FRotator& Rotation)
+{
+	USceneComponent* RootComponent = OwningCharacter->GetRootComponent();
+	if (RootComponent)
+	{
+		RootComponent->SetWorldRotation(Rotation, bSweepClingRotation);
+	}
+}
+
+void UDWallJumpComponent::RecordWallJumpDebug(FDWallJumpDebugRecord& DebugRecord)
+{
+	if (Significance == EDWallJumpSignificance::Low)
+	{
+		return;
+	}
+
+	UDWallJumpSubsystem* WallJumpSubsystem = GetWorld()->GetSubsystem<UDWallJumpSubsystem>();
+	if (WallJumpSubsystem)
+	{
+		DebugRecord.WorldTime = GetWorld()->GetTimeSeconds();
+		DebugRecord.CharacterName = OwningCharacter ? OwningCharacter->GetFName() : NAME_None;
+		WallJumpSubsystem->GetDebugBuffer().Add(DebugRecord);
+	}
+}
+
+void UDWallJumpComponent::BroadcastClungToWallEvent()
+{
+	FDWallJumpEvent ClungEvent(EDWallJumpEventType::Clung);
+	ClungEvent.SurfaceNormal = WallClingContext.GetImpactNormal();
+	ClungEvent.Location = WallClingContext.ImpactPoint;
+	BroadcastWallJumpEvent(ClungEvent);
+}
+
+void UDWallJumpComponent::BroadcastWallJumpEvent(const FDWallJumpEvent& Event)
+{
+	// An action can reach us through both the local and the Server path in the same frame, only tell our listeners about it once.
+	uint64& LastEventFrame = LastWallJumpEventFrames[(int32)Event.Type];
+	if (LastEventFrame == GFrameCounter)
+	{
+		return;
+	}
+
+	LastEventFrame = GFrameCounter;
+
+	WallJumpEvent.Broadcast(Event);
+
+	// The dynamic delegates go through reflection for every listener, and the Clung one builds an FHitResult first, so skip them when nothing is listening.
+	switch (Event.Type)
+	{
+		case EDWallJumpEventType::Clung:
+			if (OnClungToWallDelegate.IsBound())
+			{
+				OnClungToWallDelegate.Broadcast(WallClingContext.ToHitResult());
+			}
+			break;
+		case EDWallJumpEventType::Jumped:
+			if (OnJumpedFromWallDelegate.IsBound())
+			{
+				OnJumpedFromWallDelegate.Broadcast();
+			}
+			break;
+		case EDWallJumpEventType::Fell:
+			if (OnFellFromWallClingDelegate.IsBound())
+			{
+				OnFellFromWallClingDelegate.Broadcast();
+			}
+			break;
+		case EDWallJumpEventType::CooldownExpired:
+			if (OnWallClingCooldownExpiredDelegate.IsBound())
+			{
+				OnWallClingCooldownExpiredDelegate.Broadcast();
+			}
+			break;
+		default:
+			break;
+	}
+}
+
+void UDWallJumpComponent::ResetAttemptedWallJump()
+{
+	OwnerState.bAttemptedWallJump = false;
+	BroadcastWallJumpEvent(FDWallJumpEvent(EDWallJumpEventType::CooldownExpired));
+}
+
+void UDWallJumpComponent::ApplyWallClingLookInputRestrictions()
+{
+	DWALLJUMP_SCOPE_CYCLE_COUNTER(STAT_DWallJump_LookRestrictions);
+	check(OwningCharacter);
+
+	const FDWallJumpTuningValues& TuningValues = GetTuning();
+
+	// We dont need to bother calculating restrictions if they wont ever be applied or they exceed sensible default constraints.
+	if (TuningValues.WallClingLookInputRestrictionMode == ERestrictLookInput::RLI_None || (TuningValues.LookInputVerticalAngleRestriction < -90.f || TuningValues.LookInputVerticalAngleRestriction > 90.f) || (TuningValues.LookInputHorizontalAngleRestriction < 0.f || TuningValues.LookInputHorizontalAngleRestriction > 360.f))
+	{
+		return;
+	}
+
+	ADignityCharacter* DignityCharacter = OwnerReferences.DignityCharacter;
+	if(DignityCharacter && IsClungToWall())
+	{
+		const FVector SurfaceNormal = WallClingContext.GetImpactNormal().GetSafeNormal();
+
+		FVector2D ConstrainedPitchDegrees;
+
+		ConstrainedPitchDegrees.X = -90.f + TuningValues.LookInputVerticalAngleRestriction;
+		ConstrainedPitchDegrees.Y = 90.f - TuningValues.LookInputVerticalAngleRestriction;
+
+		FVector2D ConstrainedYawDegrees;
+
+		float NegativeSin = FMath::RadiansToDegrees(FMath::Acos(FVector::DotProduct(FVector(-0.707f, 0.f, 0.f).GetSafeNormal(), SurfaceNormal)));
+		float PositiveSin = FMath::RadiansToDegrees(FMath::Acos(FVector::DotProduct(SurfaceNormal, FVector(0.707f, 0.f, 0.f).GetSafeNormal())));
+
+		ConstrainedYawDegrees.X = SurfaceNormal.Y > 0.f ? PositiveSin + (TuningValues.LookInputHorizontalAngleRestriction / 2.f) + 180.f : NegativeSin + (TuningValues.LookInputHorizontalAngleRestriction / 2.f);
+		ConstrainedYawDegrees.Y = SurfaceNormal.Y > 0.f ? PositiveSin - (TuningValues.LookInputHorizontalAngleRestriction / 2.f) + 180.f : NegativeSin - (TuningValues.LookInputHorizontalAngleRestriction / 2.f);
+
+		DignityCharacter->RestrictCameraViewAngles(TuningValues.WallClingLookInputRestrictionMode, ConstrainedPitchDegrees, ConstrainedYawDegrees);
+	}
+}
@@ -1,282 +1,738 @@
-#pragma once
-
-#include "CoreMinimal.h"
-#include "Components/ActorComponent.h"
-#include "DignityCharacter.h"
-#include "DWallJumpComponent.generated.h"
-
-struct FHitResult;
-class UDamageType;
-class UAnimSequence;
-
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnClungToWall, const FHitResult&, ClingHitResult);
-DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnJumpedFromWall);
-DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnFellFromWallCling);
-DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnWallClingCooldownExpired);
-
-/**
- * This WallMovementComponent describes the ability for the Character it is attached to, to be able to Cling and Jump from acceptable surfaces determined by the parameters outlined in this class.
- *
- * An surface can be Clung to if it is deemed acceptable and the Player possessing the OwningCharacter continues to hold the "Jump" Action key when colliding with the given surface.
- * An Wall Jump can be performed either immediately within an given time frame after colliding with an acceptable surface or after having Clung to an Surface.
- *
- * The OwningCharacters Capsule Component is used to detect "hits" that may result in acceptable Clingable/Jumpable surfaces, the OnCharacterCapsuleHit() function describes this.
- */
-UCLASS( ClassGroup = ("Dignity"), HideCategories = ("Variable", "Sockets", "Cooking", "Collision"), meta = (BlueprintSpawnableComponent, DisplayName = "WallMovementComponent") )
-class DIGNITY_API UDWallJumpComponent : public UActorComponent
-{
-	GENERATED_BODY()
-
-public:	
-
-	UDWallJumpComponent();
-
-	virtual void BeginPlay() override;
-
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
-
-	virtual void PostLoad() override;
-
-#if WITH_EDITOR
-	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
-#endif // WITH_EDITOR
-
-	/* Can the Character that owns this WJC Cling to walls. */
-	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = " Settings|Cling")
-	uint32 bCanWallCling : 1;
-
-	/* Can the Character that owns this WJC jump from walls. */
-	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = " Settings|Jump")
-	uint32 bCanWallJump : 1;
-
-	/* Readonly variable that contains if the Character is holding onto an Wall on the right or left side. */
-	UPROPERTY(BlueprintReadOnly, Category = " Settings|Cling")
-	uint32 bIsCharacterHoldingWallRightSide : 1;
-
-	/* Is the Character required to Cling to the Wall first before they can WallJump. */
-	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (EditCondition = "bCanWallCling"), Category = " Settings|Jump")
-	uint32 bRequireClingToWallJump : 1;
-
-	/* Enables/Disables the debugging info of WallCling. */
-	UPROPERTY(BlueprintReadWrite, EditAnywhere, AdvancedDisplay, Category = " Settings")
-	uint32 bDebugWallCling : 1;
-
-	/* Enables/Disables the debugging info of WallJump. */
-	UPROPERTY(BlueprintReadWrite, EditAnywhere, AdvancedDisplay, Category = " Settings")
-	uint32 bDebugWallJump : 1;
-
-	/* Whether or not to force the Character Mesh to always be perpendicular to the Surface that it is Clinging to. */
-	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = " Settings|Cling")
-	uint32 bHoldCharacterMeshPerpendicularToSurface : 1;
-
-	/* How long Clinging to an Wall will last before the Character is forced to fall off. Setting this to 0 will disable the effect. */
-	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ClampMin = 0, UIMin = 0), Category = "Settings|Cling")
-	float ClingDuration;
-
-	/* How long to wait for the ability to WallCling again. */
-	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ClampMin = 0, UIMin = 0), Category = "Settings|Cling")
-	float WallJumpInterferenceGracePeriodDuration;
-
-	/**
-	 * The Minimum Angle of the Surface normal that the Character can Cling to.
-	 * This cannot be greater than ClingMaxPitchSurfaceAngle. 
-	 */
-	UPROPERTY(BlueprintReadOnly, EditAnywhere, export, meta = (ClampMin = 0, UIMin = 0), Category = "Settings|Cling")
-	float ClingMinPitchSurfaceAngle;
-
-	/**
-	 * The Maximum Angle of the Surface normal that the Character can Cling to. 
-	 * This cannot be less than ClingMinPitchSurfaceAngle. 
-	 */
-	UPROPERTY(BlueprintReadOnly, EditAnywhere, export, meta = (ClampMin = 0, UIMin = 0, ClampMax = 180, UIMax = 180), Category = "Settings|Cling")
-	float ClingMaxPitchSurfaceAngle;
-
-	/* The Maximum Forward facing Angle that the Character can approach the Surface from in order to Cling.	*/
-	UPROPERTY(BlueprintReadOnly, EditAnywhere, export, meta = (ClampMin = 0, UIMin = 0, ClampMax = 180, UIMax = 180), Category = "Settings|Cling")
-	float ClingMaxYawSurfaceAngle;
-
-	/* How much damage needs to be applied in an single hit to force the Character to release an WallCling. */
-	UPROPERTY(BlueprintReadOnly, EditAnywhere, export, meta = (ClampMin = 0, UIMin = 0), Category = "Settings|Cling")
-	float ClingDamageReleaseThreshold;
-
-	/* The Maximum number of times this Character can Cling to an wall in an row without landing. */
-	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = " Settings|Cling")
-	int32 MaxSequentialWallClings;
-
-	/* The Maximum number of WallJumps that the Character can perform in an row without landing. */
-	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = " Settings|Jump")
-	int32 MaxSequentialWallJumps;
-
-	/* The minimum required velocity the Character must have in order to perform a WallCling. */
-	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ClampMin = 0, UIMin = 0), Category = "Settings|Cling")
-	float MinVelocityToWallCling;
-
-	/* The Look Input Restriction mode to use when Clung to a Wall. */
-	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Settings|Cling")
-	ERestrictLookInput WallClingLookInputRestrictionMode;
-
-	/* The Angle on the Vertical Axis to restrict look input to when Clung to a Wall. These angles will be applied to the view axis defined by WallClingLookInputRestrictionMode. */
-	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ClampMin = -90, UIMin = -90, ClampMax = 90, UIMax = 90), Category = "Settings|Cling")
-	float LookInputVerticalAngleRestriction;
-
-	/* The Angle on the Horizontal Axis to restrict look input to when Clung to a Wall. These angles will be applied to the view axis defined by WallClingLookInputRestrictionMode. */
-	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ClampMin = 0, UIMin = 0, ClampMax = 360, UIMax = 360), Category = "Settings|Cling")
-	float LookInputHorizontalAngleRestriction;
-
-	/* Controls the power of the WallJump. */
-	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ClampMin = 0, UIMin = 0), Category = "Settings|Jump")
-	float WallJumpMagnitude;
-
-	/* The name for the "Jump" Action Input Event. We use this to detect if the Player is holding Jump to Cling to an wall or pressing Jump again to WallJump. */
-	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = " Settings|Jump")
-	FName JumpActionName;
-
-	/* Delegate that will be called when the Character that owns this WJC clings to an wall. */
-	UPROPERTY(BlueprintAssignable, meta = (DisplayName = "On Clung To Wall"), Category = "Wall Cling")
-	FOnClungToWall OnClungToWallDelegate;
-
-	/* Delegate that will be called when the Character that owns this WJC jumps from an wall. */
-	UPROPERTY(BlueprintAssignable, meta = (DisplayName = "On Jumped From Wall"), Category = "Wall Jump")
-	FOnJumpedFromWall OnJumpedFromWallDelegate;
-
-	/* Delegate that will be called when the Character that owns this WJC fell from an wall they had clung to. */
-	UPROPERTY(BlueprintAssignable, meta = (DisplayName = "On Fell From Wall"), Category = "Wall Cling")
-	FOnFellFromWallCling OnFellFromWallClingDelegate;
-
-	/* Delegate that will be called when the Character that owns this WJC has its WallCling cooldown expire. */
-	UPROPERTY(BlueprintAssignable, meta = (DisplayName = "On Wall Cling Cooldown Expired"), Category = "Wall Cling")
-	FOnWallClingCooldownExpired OnWallClingCooldownExpiredDelegate;
-
-	/* The animation to play when Clinging to the Left. This is only an convenience variable, this component doesnt play any Anims. */
-	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = " Settings|Cling")
-	UAnimSequence* ClingAnimLeft;
-
-	/* The animation to play when Clinging to the Right. This is only an convenience variable, this component doesnt play any Anims. */
-	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = " Settings|Cling")
-	UAnimSequence* ClingAnimRight;
-
-	/* The animation to play when not Clinging to the Wall perpendicular but holding the Mesh forward. This is only an convenience variable, this component doesnt play any Anims. */
-	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = " Settings|Cling")
-	UAnimSequence* ClingAnimForward;
-
-	/* Returns if this Character that owns the WJC is currently clinging to an Wall. */
-	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Wall Cling")
-	FORCEINLINE bool IsClungToWall() { return bIsClungToWall; }
-
-	/**
-	 * Returns how long the Character that owns this WJC has left before they will fall from the wall they are clinging to.
-	 *
-	 * @return	This returns -1 if they are not currently clinging to an wall.
-	 */
-	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Wall Cling")
-	float RemainingClingTime();
-
-protected:
-
-	/* The Character that owns this WJC. */
-	ACharacter* OwningCharacter;
-
-	/* The HitResult returned from the Character Capsule Component we use to determine if its an viable Cling surface. */
-	FHitResult WallClingHitResult;
-
-	/* The current amount of WallClings that have been performed in an row without landing. */
-	UPROPERTY(Replicated)
-	int32 CurrentWallClingCount;
-
-	/* The current amount of WallJumps that have been performed in an row without landing. */
-	UPROPERTY(Replicated)
-	int32 CurrentWallJumpCount;
-
-	/* True if the Character has just WallJumped, this is used to stop us from Clinging to the same wall in the same frame. */
-	UPROPERTY(Replicated)
-	bool bAttemptedWallJump;
-
-	/* Called when the OwningCharacters Collision Capsule registers an Hit event. */
-	UFUNCTION()
-	virtual void OnCharacterCapsuleHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
-
-	/* Called when the OwningCharacter has Landed on an Walkable surface. */
-	UFUNCTION()
-	virtual void OnCharacterLanded(const FHitResult& Hit);
-
-	/* Called when the OwningCharacter has taken any damage, used to check if we need to Uncling from an wall. */
-	UFUNCTION()
-	virtual void OnCharacterTookAnyDamage(AActor* DamagedActor, float Damage, const UDamageType* DamageType, AController* InstigatedBy, AActor* DamageCauser);
-
-	/** 
-	 * RPC called to the Server in order to perform an WallJump with the provided Velocity. 
-	 *
-	 * @param	LaunchVelocity	The Velocity to Launch the Character with.
-	 * @param	bRightSideJump	True if the surface the Character jumped from was on their RightHand side.
-	 */
-	UFUNCTION(Server, Reliable, WithValidation)
-	void PerformCharacterWallJump_Server(const FVector& LaunchVelocity, const bool bRightSideJump = true);
-
-	/**
-	 * RPC called to the Server in order to Set if the Character is Clinging to an Wall or to release them from an Wall Cling. 
-	 * 
-	 * @param	bRightSideCling	True if the surface the Character clung to is on the RightHand side.
-	 */
-	UFUNCTION(Server, Reliable, WithValidation)
-	void PerformCharacterWallCling_Server(const bool bRightSideCling = true);
-
-	/**
-	 * Sets up the CharacterMovementComponent to support the WallCling, if passing false it will return the CMC back to its original state and into an Falling movement mode. 
-	 *
-	 * @param	bEnable	Sets the Mode to enable or disable.
-	 */
-	void SetClingMovementMode(bool bEnable = true);
-
-	/**
-	 * Releases the Character from an WallCling. 
-	 *
-	 * @param	bFell	Used to tell if the Release was due to the ClingDuration causing the Character to fall or the Character jumped during the Cling.
-	 */
-	UFUNCTION()
-	void ReleaseWallCling(bool bFell = true);
-
-private:
-
-	/* The Timer Handle used to trigger and forced fall from an wall cling. */
-	FTimerHandle WallClingTimerHandle;
-
-	/* The Timer Handle used to ensure that an Cling wont occur in the few frames after attempting to WallJump. */
-	FTimerHandle WallJumpInterferenceGracePeriodTimerHandle;
-
-	/* Holds the Characters Forward Vector when they Clung to an Wall. */
-	FVector CharacterWallClingForwardVector;
-
-	/* Holds the Characters Right Vector when they Clung to an Wall. */
-	FVector CharacterWallClingRightVector;
-
-	/* Holds the Characters Up Vector when they Clung to an Wall. */
-	FVector CharacterWallClingUpVector;
-
-	/* Temp var for holding the original bUseControllerRotationYaw value before we override it when we Cling. */
-	bool bOriginalControllerRotationYawUseBeforeCling;
-
-	/* The original Mesh rotation before Clinging to the surface, we cache this so we can return it to its original value when unclinging. */
-	FRotator OriginalActorMeshRotationBeforeCling;
-
-	/* True if this Character is considered to be clinging to an wall, false otherwise. */
-	UPROPERTY(Replicated)
-	bool bIsClungToWall;
-
-	/* Logic for handling an Wall Jump that isnt after an Cling. */
-	void WallJump();
-
-	/* Logic for jumping when already Clung to an wall. */
-	void CheckWallClingJump();
-
-	/* Logic for Clinging to an Wall we have hit. */
-	void WallCling();
-
-	/* Forcefully aligns the Character mesh to the Cling surface during an WallCling. */
-	void AlignCharacterMeshForCling();
-
-	/* Resets bAttemptedWallJump back to false. */
-	void ResetAttemptedWallJump();
-
-	/* Sets the PlayerCameraManagers view restrictions based on the WallClingHit Normal. */
-	void ApplyWallClingLookInputRestrictions();
-};
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "DignityCharacter.h"
+#include "DWallJumpTuning.h"
+#include "DWallJumpTypes.h"
+#include "DWallJumpComponent.generated.h"
+
+struct FHitResult;
+struct FDWallHitCandidate;
+struct FDWallHitBatch;
+struct FDWallHitEvaluation;
+struct FDWallJumpCoreSettings;
+struct FDWallJumpCoreState;
+enum class EDWallHitIntent : uint8;
+struct FDWallJumpDebugRecord;
+struct FDWallClingProbeRequest;
+struct FDWallAIMoveRequest;
+class UDamageType;
+class UAnimSequence;
+class UDWallJumpMovementComponent;
+class UCharacterMovementComponent;
+class AController;
+class APawn;
+class APlayerController;
+class APlayerCameraManager;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnClungToWall, const FHitResult&, ClingHitResult);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnJumpedFromWall);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnFellFromWallCling);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnWallClingCooldownExpired);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnAIWallMoveDecided, bool, bJump, bool, bAccepted);
+
+/* Counters describing how many Capsule Hits the WJC received and what happened to them. */
+USTRUCT(BlueprintType)
+struct FDWallJumpHitStats
+{
+	GENERATED_BODY()
+
+	/* Every Capsule Hit received. */
+	UPROPERTY(BlueprintReadOnly, Category = "Wall Jump")
+	int32 HitsReceived;
+
+	/* Hits dropped before being considered, wrong surface type, exhausted Clings and Jumps or not Falling. */
+	UPROPERTY(BlueprintReadOnly, Category = "Wall Jump")
+	int32 HitsRejected;
+
+	/* Hits dropped because an better Hit was already pending for the same frame. */
+	UPROPERTY(BlueprintReadOnly, Category = "Wall Jump")
+	int32 HitsCoalesced;
+
+	/* Hits that went through the full Cling/Jump evaluation. */
+	UPROPERTY(BlueprintReadOnly, Category = "Wall Jump")
+	int32 HitsEvaluated;
+
+	FDWallJumpHitStats()
+		: HitsReceived(0)
+		, HitsRejected(0)
+		, HitsCoalesced(0)
+		, HitsEvaluated(0)
+	{
+	}
+};
+
+/**
+ * Everything about the OwningCharacter that the WJC would otherwise look up on every call, resolved in BeginPlay.
+ * It is rebuilt whenever the Character is possessed or unpossessed, and when its CharacterMovementComponent is found to have changed.
+ */
+struct FDWallJumpOwnerReferences
+{
+	/* The OwningCharacter as an ADignityCharacter, null if it isnt one. */
+	ADignityCharacter* DignityCharacter;
+
+	/* The CharacterMovementComponent the rest was resolved for. */
+	UCharacterMovementComponent* CharacterMovement;
+
+	/* The defaults of the CharacterMovementComponent, what its GravityScale is restored to after an Cling. */
+	const UCharacterMovementComponent* DefaultCharacterMovement;
+
+	/* The PlayerController possessing the OwningCharacter, null for AI and while unpossessed. */
+	TWeakObjectPtr<APlayerController> PlayerController;
+
+	TWeakObjectPtr<APlayerCameraManager> PlayerCameraManager;
+
+	FDWallJumpOwnerReferences()
+		: DignityCharacter(nullptr)
+		, CharacterMovement(nullptr)
+		, DefaultCharacterMovement(nullptr)
+	{
+	}
+};
+
+/**
+ * This WallMovementComponent describes the ability for the Character it is attached to, to be able to Cling and Jump from acceptable surfaces determined by the parameters outlined in this class.
+ *
+ * An surface can be Clung to if it is deemed acceptable and the Player possessing the OwningCharacter continues to hold the "Jump" Action key when colliding with the given surface.
+ * An Wall Jump can be performed either immediately within an given time frame after colliding with an acceptable surface or after having Clung to an Surface.
+ *
+ * The OwningCharacters Capsule Component is used to detect "hits" that may result in acceptable Clingable/Jumpable surfaces, the OnCharacterCapsuleHit() function describes this.
+ */
+UCLASS( ClassGroup = ("Dignity"), HideCategories = ("Variable", "Sockets", "Cooking", "Collision"), meta = (BlueprintSpawnableComponent, DisplayName = "WallMovementComponent") )
+class DIGNITY_API UDWallJumpComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+	friend class UDWallJumpSubsystem;
+	friend class UDWallJumpMovementComponent;
+
+public:	
+
+	UDWallJumpComponent();
+
+	virtual void OnRegister() override;
+
+	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	virtual void PostInitProperties() override;
+
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif // WITH_EDITOR
+
+	/* Can the Character that owns this WJC Cling to walls. Change it with SetCanWallCling() once we have begun play. */
+	UPROPERTY(BlueprintReadWrite, BlueprintSetter = SetCanWallCling, EditAnywhere, Category = " Settings|Cling")
+	uint32 bCanWallCling : 1;
+
+	/* Can the Character that owns this WJC jump from walls. Change it with SetCanWallJump() once we have begun play. */
+	UPROPERTY(BlueprintReadWrite, BlueprintSetter = SetCanWallJump, EditAnywhere, Category = " Settings|Jump")
+	uint32 bCanWallJump : 1;
+
+	/* Readonly variable that contains if the Character is holding onto an Wall on the right or left side. */
+	UPROPERTY(BlueprintReadOnly, Category = " Settings|Cling")
+	uint32 bIsCharacterHoldingWallRightSide : 1;
+
+	/* Is the Character required to Cling to the Wall first before they can WallJump. Change it with SetRequireClingToWallJump() once we have begun play. */
+	UPROPERTY(BlueprintReadWrite, BlueprintSetter = SetRequireClingToWallJump, EditAnywhere, meta = (EditCondition = "bCanWallCling"), Category = " Settings|Jump")
+	uint32 bRequireClingToWallJump : 1;
+
+	/* Enables/Disables the debugging info of WallCling. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, AdvancedDisplay, Category = " Settings")
+	uint32 bDebugWallCling : 1;
+
+	/* Enables/Disables the debugging info of WallJump. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, AdvancedDisplay, Category = " Settings")
+	uint32 bDebugWallJump : 1;
+
+	/* Whether or not to force the Character Mesh to always be perpendicular to the Surface that it is Clinging to. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = " Settings|Cling")
+	uint32 bHoldCharacterMeshPerpendicularToSurface : 1;
+
+	/**
+	 * Whether turning the Character to the Surface it Clung to, and back again when it is released, sweeps the Capsule.
+	 * The Capsule only turns in place so the sweep rarely finds anything, turning this off skips the collision query.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, AdvancedDisplay, Category = " Settings|Cling")
+	uint32 bSweepClingRotation : 1;
+
+	/**
+	 * Sweeps the Capsule along the Characters Velocity every frame to find the Surface it is about to hit, before the Hit slows it down.
+	 * An Cling against an predicted Surface checks MinVelocityToWallCling against the Speed the Character approached it with.
+	 * The sweeps are asynchronous and batched with every other WJC by the UDWallJumpSubsystem.
+	 */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, AdvancedDisplay, Category = "Settings|Cling")
+	uint32 bPredictWallCling : 1;
+
+	/**
+	 * Which of the Cling and Jump features this WJC uses, its Hits are evaluated by an version of the core compiled for just those.
+	 * Changing bCanWallCling, bCanWallJump or bRequireClingToWallJump through their setters picks the version again, an fixed archetype whose flags no longer match falls back to Dynamic.
+	 */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, AdvancedDisplay, Category = " Settings")
+	EDWallJumpArchetype Archetype;
+
+	/* The tuning profile this WJC shares with the other Characters of its archetype, the FDWallJumpTuningValues defaults are used if there is none. */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = " Settings")
+	UDWallJumpTuning* Tuning;
+
+	/* The few values this WJC uses instead of the ones in its Tuning, see SetTuningOverride(). */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = " Settings")
+	TArray<FDWallJumpTuningOverride> TuningOverrides;
+
+	/* The name for the "Jump" Action Input Event. We use this to detect if the Player is holding Jump to Cling to an wall or pressing Jump again to WallJump. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = " Settings|Jump")
+	FName JumpActionName;
+
+	/* Delegate that will be called when the Character that owns this WJC clings to an wall. */
+	UPROPERTY(BlueprintAssignable, meta = (DisplayName = "On Clung To Wall"), Category = "Wall Cling")
+	FOnClungToWall OnClungToWallDelegate;
+
+	/* Delegate that will be called when the Character that owns this WJC jumps from an wall. */
+	UPROPERTY(BlueprintAssignable, meta = (DisplayName = "On Jumped From Wall"), Category = "Wall Jump")
+	FOnJumpedFromWall OnJumpedFromWallDelegate;
+
+	/* Delegate that will be called when the Character that owns this WJC fell from an wall they had clung to. */
+	UPROPERTY(BlueprintAssignable, meta = (DisplayName = "On Fell From Wall"), Category = "Wall Cling")
+	FOnFellFromWallCling OnFellFromWallClingDelegate;
+
+	/* Delegate that will be called when the Character that owns this WJC has its WallCling cooldown expire. */
+	UPROPERTY(BlueprintAssignable, meta = (DisplayName = "On Wall Cling Cooldown Expired"), Category = "Wall Cling")
+	FOnWallClingCooldownExpired OnWallClingCooldownExpiredDelegate;
+
+	/* Delegate that will be called with the outcome of every RequestAIWallMove(). */
+	UPROPERTY(BlueprintAssignable, meta = (DisplayName = "On AI Wall Move Decided"), Category = "Wall Jump|AI")
+	FOnAIWallMoveDecided OnAIWallMoveDecidedDelegate;
+
+	/* Returns if this Character that owns the WJC is currently clinging to an Wall. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Wall Cling")
+	FORCEINLINE bool IsClungToWall() { return bIsClungToWall; }
+
+	/**
+	 * Returns which of the Tunings ClingAnimLeft, ClingAnimRight or ClingAnimForward suits the current Cling, on every machine. Null if we arent Clung.
+	 * Without an Tuning the UDWallJumpTuning class defaults are used, like the values are.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Wall Cling")
+	UAnimSequence* GetClingAnimation() const;
+
+	/* Returns where the Character was when it Clung to the current wall. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Wall Cling")
+	FORCEINLINE FVector GetClingAnchor() const { return ClingPose.Anchor; }
+
+	/* Returns how far the Character has turned to its Cling, always 1 unless it is an Simulated Proxy still turning to it. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Wall Cling")
+	FORCEINLINE float GetClingPoseBlendAlpha() const { return ClingPoseBlendAlpha; }
+
+	/**
+	 * Returns how long the Character that owns this WJC has left before they will fall from the wall they are clinging to.
+	 *
+	 * @return	This returns -1 if they are not currently clinging to an wall.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Wall Cling")
+	float RemainingClingTime();
+
+	/**
+	 * Tells every WJC that the Input bindings have changed so they re-resolve the keys bound to their JumpActionName.
+	 * This should be called after the Player rebinds their Action Mappings.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Wall Jump")
+	static void NotifyInputBindingsChanged();
+
+	/**
+	 * Sets the Minimum and Maximum Surface normal angles that the Character can Cling to.
+	 * The Maximum angle will be clamped so that it is never less than the Minimum angle.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Wall Cling")
+	void SetClingPitchSurfaceAngles(float MinAngle, float MaxAngle);
+
+	/* Sets the Maximum Forward facing Angle that the Character can approach the Surface from in order to Cling. */
+	UFUNCTION(BlueprintCallable, Category = "Wall Cling")
+	void SetClingMaxYawSurfaceAngle(float MaxAngle);
+
+	/* Sets bCanWallCling and picks the version of the core our Hits are evaluated by again. */
+	UFUNCTION(BlueprintSetter)
+	void SetCanWallCling(bool bCanCling);
+
+	/* Sets bCanWallJump and picks the version of the core our Hits are evaluated by again. */
+	UFUNCTION(BlueprintSetter)
+	void SetCanWallJump(bool bCanJump);
+
+	/* Sets bRequireClingToWallJump and picks the version of the core our Hits are evaluated by again. */
+	UFUNCTION(BlueprintSetter)
+	void SetRequireClingToWallJump(bool bRequireCling);
+
+	/* Changes the tuning profile this WJC uses, its TuningOverrides still apply on top of it. */
+	UFUNCTION(BlueprintCallable, Category = "Wall Jump|Tuning")
+	void SetTuning(UDWallJumpTuning* NewTuning);
+
+	/* Makes this WJC use Amount for the Value rather than what its Tuning has. */
+	UFUNCTION(BlueprintCallable, Category = "Wall Jump|Tuning")
+	void SetTuningOverride(EDWallJumpTuningValue Value, float Amount);
+
+	/* Goes back to using the Value from the Tuning. */
+	UFUNCTION(BlueprintCallable, Category = "Wall Jump|Tuning")
+	void ClearTuningOverride(EDWallJumpTuningValue Value);
+
+	/* Returns the Value this WJC is using, after its TuningOverrides. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Wall Jump|Tuning")
+	float GetTuningValue(EDWallJumpTuningValue Value) const;
+
+	/* The values this WJC is using, the ones from its Tuning unless it has TuningOverrides. */
+	FORCEINLINE const FDWallJumpTuningValues& GetTuning() const { return OverriddenTuning ? *OverriddenTuning : (Tuning ? Tuning->Values : FDWallJumpTuningValues::GetDefaults()); }
+
+	/* Rebuilds the OverriddenTuning from the Tuning and TuningOverrides, called when either of them change. */
+	void ResolveTuning();
+
+	/**
+	 * Asks for an WallCling to, or an WallJump from, the Surface that was Hit, for AI Characters that have no Jump key for the WJC to read.
+	 * The request is evaluated on the worker threads with every other AI request made this frame and applied at the start of the next UDWallJumpSubsystem tick,
+	 * OnAIWallMoveDecidedDelegate is broadcast with the outcome. Only the Server can make requests.
+	 *
+	 * @param	Hit				The Surface to Cling to or Jump from, ignored when Jumping from the current Cling.
+	 * @param	bJump			True to WallJump, false to WallCling.
+	 * @param	LaunchDirection	Where the Character is looking to Jump, an Jump from an Hit ricochets it off the Surface like an Players Camera direction.
+	 * @return	False if the request was rejected outright, OnAIWallMoveDecidedDelegate is only broadcast for requests that were queued.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Wall Jump|AI")
+	bool RequestAIWallMove(const FHitResult& Hit, bool bJump, FVector LaunchDirection);
+
+	/**
+	 * Native event channel for every Cling, Jump, Fall and Cooldown expiry of this WJC, raised at most once per action per frame.
+	 * The Blueprint delegates are broadcast alongside it whenever something is bound to them.
+	 */
+	FORCEINLINE FOnWallJumpEventNative& OnWallJumpEvent() { return WallJumpEvent; }
+
+	/* Returns the counters of how many Capsule Hits were received, rejected, coalesced and evaluated. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Wall Jump")
+	FORCEINLINE FDWallJumpHitStats GetHitStats() const { return HitStats; }
+
+	/* Resets the Capsule Hit counters back to zero. */
+	UFUNCTION(BlueprintCallable, Category = "Wall Jump")
+	void ResetHitStats();
+
+	/**
+	 * Re-resolves the PlayerController, Camera and CharacterMovementComponent of the OwningCharacter.
+	 * This happens by itself when the Character is possessed, only call it after changing them some other way.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Wall Jump")
+	void RefreshOwnerReferences();
+
+	/* How much of its work this WJC is currently doing. */
+	FORCEINLINE EDWallJumpSignificance GetSignificance() const { return Significance; }
+
+protected:
+
+	/* The Character that owns this WJC. */
+	ACharacter* OwningCharacter;
+
+	/* The OwningCharacters CharacterMovementComponent if it supports predicting WallClings and WallJumps, null otherwise. */
+	UDWallJumpMovementComponent* WallJumpMovement;
+
+	/* The rest of what we need from the OwningCharacter, see RefreshOwnerReferences(). */
+	FDWallJumpOwnerReferences OwnerReferences;
+
+	/* Refreshes the OwnerReferences when the OwningCharacter is possessed or unpossessed. */
+	UFUNCTION()
+	void OnPawnControllerChanged(APawn* Pawn, AController* Controller);
+
+	/* The Surface we are Clinging to, or last evaluated for an Cling or Jump, and how the Character was facing when they hit it. */
+	FDWallClingContext WallClingContext;
+
+	/* The Cling and Jump counters and flags, only replicated to the owning Client. */
+	UPROPERTY(ReplicatedUsing = OnRep_OwnerState)
+	FDWallJumpOwnerState OwnerState;
+
+	/* Applies the Cling state the Server sent to the owning Client. */
+	UFUNCTION()
+	void OnRep_OwnerState();
+
+	/* Called when the OwningCharacters Collision Capsule registers an Hit event. */
+	UFUNCTION()
+	virtual void OnCharacterCapsuleHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
+
+	/* Called when the OwningCharacter has Landed on an Walkable surface. */
+	UFUNCTION()
+	virtual void OnCharacterLanded(const FHitResult& Hit);
+
+	/* Called when the OwningCharacter has taken any damage, used to check if we need to Uncling from an wall. */
+	UFUNCTION()
+	virtual void OnCharacterTookAnyDamage(AActor* DamagedActor, float Damage, const UDamageType* DamageType, AController* InstigatedBy, AActor* DamageCauser);
+
+	/**
+	 * Unreliable RPC carrying every WallJump and WallCling the owning Client performed in an frame.
+	 * The Server discards packets older than the last one it applied and re-checks each action against its own state before performing it.
+	 *
+	 * @param	WallMove	The timestamped actions to perform.
+	 */
+	UFUNCTION(Server, Unreliable, WithValidation)
+	void PerformCharacterWallMove_Server(const FDWallJumpMovePacket& WallMove);
+
+	/**
+	 * Performs an WallJump with the provided Velocity on the Server.
+	 *
+	 * @param	LaunchVelocity	The Velocity to Launch the Character with.
+	 */
+	void PerformCharacterWallJump(const FVector& LaunchVelocity);
+
+	/* Sets the Character as Clinging to the Surface in WallClingContext on the Server. */
+	void PerformCharacterWallCling();
+
+	/* Where the Capsule touches an Surface with this normal, on the hemisphere nearest it unless the Surface is vertical. */
+	FVector GetCapsuleContactPoint(const FVector& SurfaceNormal) const;
+
+	/* Server side re-check of an Clients WallJump, false if it shouldnt be performed. The Server launches along JumpDirection at WallJumpMagnitude. */
+	bool IsServerWallJumpValid(const FVector& JumpDirection) const;
+
+	/* Server side re-check of an Clients WallCling, false if it shouldnt be performed. OutSurfaceHit is the Surface the Server found behind the Clients normal. */
+	bool IsServerWallClingValid(const FVector& SurfaceNormal, FHitResult& OutSurfaceHit, uint8& OutSurfaceFlags) const;
+
+	/**
+	 * Sets up the CharacterMovementComponent to support the WallCling, if passing false it will return the CMC back to its original state and into an Falling movement mode.
+	 * If the Character uses an UDWallJumpMovementComponent this requests its WallCling movement mode instead.
+	 *
+	 * @param	bEnable	Sets the Mode to enable or disable.
+	 */
+	void SetClingMovementMode(bool bEnable = true);
+
+	/**
+	 * Releases the Character from an WallCling. 
+	 *
+	 * @param	Reason	Why the Cling is released, everything but an Jump raises the Fell event.
+	 */
+	UFUNCTION()
+	void ReleaseWallCling(EDWallClingReleaseReason Reason = EDWallClingReleaseReason::Fell);
+
+private:
+
+	/* The actions performed this frame, waiting to be sent to the Server. */
+	FDWallJumpMovePacket PendingWallMove;
+
+	/* The Timestamp of the last FDWallJumpMovePacket the Server applied. */
+	float LastServerWallMoveTimestamp;
+
+	/* Server only, the MoveTimestamp of the FDWallJumpMovePacket being applied, the Clings and Jumps it performs are approved for that move only. */
+	float ServerClientMoveTimestamp;
+
+	/* Tells the Server we WallJumped, this is performed immediately if we are the Server. */
+	void SendWallJump(const FVector& LaunchVelocity);
+
+	/* Tells the Server we Clung to the Surface in WallClingContext, this is performed immediately if we are the Server. */
+	void SendWallCling();
+
+	/* Asks the UDWallJumpSubsystem to send PendingWallMove at the end of the frame. With an UDWallJumpMovementComponent the move that carries the actions sends it instead. */
+	void QueueWallMoveFlush();
+
+	/**
+	 * Sends PendingWallMove to the Server if it holds any actions.
+	 *
+	 * @param	MoveTimestamp	The TimeStamp of the saved move that carries the actions, 0 if they arent tied to an move.
+	 */
+	void FlushWallMove(float MoveTimestamp = 0.f);
+
+	/* The World time at which the current WallCling will force the Character to fall, 0 if there is no deadline. */
+	float WallClingReleaseTime;
+
+	/* The World time at which an Cling can occur again after attempting to WallJump, 0 if there is no grace period running. */
+	float WallJumpGracePeriodEndTime;
+
+	/* Starts the ClingDuration deadline for the current WallCling. */
+	void StartWallClingDuration();
+
+	/* Starts the WallJumpInterferenceGracePeriodDuration deadline, bAttemptedWallJump is reset when it expires. */
+	void StartWallJumpGracePeriod();
+
+	/* Expires the Cling and grace period deadlines that have passed, only called from the Tick while one is running. */
+	void UpdateWallJumpDeadlines();
+
+	/* An copy of the Tunings values with the TuningOverrides applied, only allocated if there are any. */
+	TUniquePtr<FDWallJumpTuningValues> OverriddenTuning;
+
+	/* Adds or changes the override of the Value without resolving the Tuning again, so several can be set at once. */
+	void SetTuningOverrideValue(EDWallJumpTuningValue Value, float Amount);
+
+#if WITH_EDITORONLY_DATA
+	/* The tuning WJCs saved before UDWallJumpTuning existed had, moved into the TuningOverrides by MigrateDeprecatedTuning(). */
+	UPROPERTY()
+	float ClingDuration_DEPRECATED;
+	UPROPERTY()
+	float WallJumpInterferenceGracePeriodDuration_DEPRECATED;
+	UPROPERTY()
+	float ClingMinPitchSurfaceAngle_DEPRECATED;
+	UPROPERTY()
+	float ClingMaxPitchSurfaceAngle_DEPRECATED;
+	UPROPERTY()
+	float ClingMaxYawSurfaceAngle_DEPRECATED;
+	UPROPERTY()
+	float ClingDamageReleaseThreshold_DEPRECATED;
+	UPROPERTY()
+	int32 MaxSequentialWallClings_DEPRECATED;
+	UPROPERTY()
+	int32 MaxSequentialWallJumps_DEPRECATED;
+	UPROPERTY()
+	float MinVelocityToWallCling_DEPRECATED;
+	UPROPERTY()
+	int32 WallClingPredictionFrames_DEPRECATED;
+	UPROPERTY()
+	ERestrictLookInput WallClingLookInputRestrictionMode_DEPRECATED;
+	UPROPERTY()
+	float LookInputVerticalAngleRestriction_DEPRECATED;
+	UPROPERTY()
+	float LookInputHorizontalAngleRestriction_DEPRECATED;
+	UPROPERTY()
+	float WallJumpMagnitude_DEPRECATED;
+	UPROPERTY()
+	float ServerClingAngleTolerance_DEPRECATED;
+	UPROPERTY()
+	float ClingPoseBlendTime_DEPRECATED;
+
+	/* The Cling animations WJCs had before UDWallJumpTuning existed, moved into an Tuning of their own by MigrateDeprecatedTuning(). */
+	UPROPERTY()
+	UAnimSequence* ClingAnimLeft_DEPRECATED;
+	UPROPERTY()
+	UAnimSequence* ClingAnimRight_DEPRECATED;
+	UPROPERTY()
+	UAnimSequence* ClingAnimForward_DEPRECATED;
+
+	/* Sets the deprecated tuning to the FDWallJumpTuningValues defaults, so only the values that were changed from them are migrated. */
+	void ResetDeprecatedTuning();
+
+	/**
+	 * Adds an TuningOverride for every deprecated value that isnt the default and isnt already overridden, which keeps the WJC behaving as it was saved.
+	 * Deprecated Cling animations have nowhere to go in the TuningOverrides, an WJC without an Tuning is given one of its own to hold them.
+	 */
+	void MigrateDeprecatedTuning();
+#endif // WITH_EDITORONLY_DATA
+
+	/* Temp var for holding the original bUseControllerRotationYaw value before we override it when we Cling. */
+	bool bOriginalControllerRotationYawUseBeforeCling;
+
+	/* True if this Character is considered to be clinging to an wall, false otherwise. Simulated Proxies receive it in ClingPose, the owning Client in OwnerState. */
+	bool bIsClungToWall;
+
+	/* The Cling as Simulated Proxies need to see it, only changed on an Cling transition so it is only replicated then. */
+	UPROPERTY(ReplicatedUsing = OnRep_ClingPose)
+	FDWallClingPose ClingPose;
+
+	/* Applies the Cling the Server sent, turning the Character to it over ClingPoseBlendTime. */
+	UFUNCTION()
+	void OnRep_ClingPose();
+
+	/* Fills out the ClingPose from the current Cling. */
+	void UpdateClingPose();
+
+	/* The Rotation an Simulated Proxy is turning from and to for its ClingPose. */
+	FQuat ClingPoseStartRotation;
+	FQuat ClingPoseTargetRotation;
+
+	/* How far the Simulated Proxy has turned to its ClingPose, 1 once it is there. */
+	float ClingPoseBlendAlpha;
+
+	/* Turns the Simulated Proxy towards its ClingPose, called from the Tick while ClingPoseBlendAlpha is below 1. */
+	void BlendToClingPose(float DeltaTime);
+
+	/* The Rotation an Character Clung to an Surface with the SurfaceNormal is held in. */
+	static FRotator GetClingRotation(const FVector& SurfaceNormal, bool bHoldingRightSide, bool bHeldPerpendicular);
+
+	/* Sets bIsClungToWall along with its copy in OwnerState and updates the Tick. */
+	void SetIsClungToWall(bool bClung);
+
+	/* Enables the Tick only while Clung to an wall, this is the only time we need to poll for an Jump. */
+	void UpdateWallClingTickState();
+
+	/* True if the Jump input for the OwningCharacter is read on this machine, either the owning Client or an Server controlled Character. */
+	bool IsWallJumpInputLocal() const;
+
+	/* The best Capsule Hit received this frame, waiting to be evaluated by the UDWallJumpSubsystem. */
+	FDWallClingContext PendingWallHit;
+
+	/* The Time along the move of PendingWallHit. */
+	float PendingWallHitTime;
+
+	/* True if PendingWallHit holds an Hit that hasnt been evaluated yet. */
+	bool bHasPendingWallHit;
+
+	/* Counters for the Capsule Hits we have received. */
+	FDWallJumpHitStats HitStats;
+
+	/* Cheap check for if an Hit could still start an WallJump. */
+	bool CanHitStartWallJump() const;
+
+	/* Cheap check for if an Hit could still start an WallCling. */
+	bool CanHitStartWallCling() const;
+
+	/* True if the Candidate Hit is an better Cling/Jump surface than the Current one. */
+	static bool IsBetterWallHit(const FHitResult& Candidate, const FDWallClingContext& Current, float CurrentTime);
+
+	/* Every Key that is bound to JumpActionName, resolved lazily and only refreshed when the bindings or JumpActionName change. */
+	TArray<FKey> CachedJumpKeys;
+
+	/* The JumpActionName that CachedJumpKeys was resolved for. */
+	FName CachedJumpKeysActionName;
+
+	/* The Input binding generation that CachedJumpKeys was resolved for. */
+	uint32 CachedJumpKeysGeneration;
+
+	/* Incremented by NotifyInputBindingsChanged() to invalidate the CachedJumpKeys of every WJC. */
+	static uint32 JumpKeysGeneration;
+
+	/* Returns the Keys bound to JumpActionName, re-resolving them only if they are out of date. This can be empty if nothing is bound. */
+	const TArray<FKey>& GetJumpKeys();
+
+	/* True if any Key bound to JumpActionName is held down by the PlayerController. */
+	bool IsJumpKeyDown(const APlayerController* PlayerController);
+
+	/* True if any Key bound to JumpActionName was pressed this frame by the PlayerController. */
+	bool WasJumpKeyJustPressed(const APlayerController* PlayerController);
+
+	/**
+	 * Decides if the best Hit received this frame should result in an WallJump or WallCling and fills out the data the UDWallJumpSubsystem needs to evaluate it.
+	 * Only called with the Policy of our PolicyArchetype.
+	 *
+	 * @return	False if the Hit doesnt need to be evaluated.
+	 */
+	template<typename Policy>
+	bool GatherWallHitCandidate(FDWallHitCandidate& OutCandidate);
+
+	/* Gathers the Candidates of every WJC in Components, adding them to the Batch with the WJC that submitted each to BatchComponents. Called by the UDWallJumpSubsystem. */
+	static void GatherWallHitCandidates(const TArray<TWeakObjectPtr<UDWallJumpComponent>>& Components, FDWallHitBatch& Batch, TArray<UDWallJumpComponent*>& BatchComponents);
+
+	/* GatherWallHitCandidates() for the WJCs of one PolicyArchetype, compiled with its Policy throughout. */
+	template<typename Policy>
+	static void GatherWallHitCandidates(EDWallJumpArchetype InPolicyArchetype, const TArray<TWeakObjectPtr<UDWallJumpComponent>>& Components, FDWallHitBatch& Batch, TArray<UDWallJumpComponent*>& BatchComponents);
+
+	/* The archetype our Hits are evaluated with, our Archetype unless our flags dont match it in which case Dynamic. */
+	EDWallJumpArchetype PolicyArchetype;
+
+	/* Picks the PolicyArchetype, falling back to Dynamic if our flags dont match our Archetype. */
+	void SelectWallJumpPolicy();
+
+	/* Copies the settings the FDWallJumpCore needs, with the Cling angles as their Cosine bounds. */
+	FDWallJumpCoreSettings GetCoreSettings() const;
+
+	/* Copies our counters, flags and deadlines into the form the FDWallJumpCore steps. */
+	FDWallJumpCoreState GetCoreState() const;
+
+	/* Called by the UDWallJumpSubsystem with the result of evaluating our Hit. */
+	void ApplyWallHitEvaluation(const FDWallHitEvaluation& Evaluation);
+
+	/* Called by the UDWallJumpSubsystem with the result of evaluating an RequestAIWallMove(), a frame after it was requested. */
+	void ApplyAIWallMove(const FDWallAIMoveRequest& Request, const FDWallHitEvaluation& Evaluation);
+
+	/* The Surface the last Cling probe found ahead of the Character. */
+	TWeakObjectPtr<UPrimitiveComponent> PredictedClingSurface;
+
+	FVector PredictedClingNormal;
+
+	/* The Speed the Character was approaching the PredictedClingSurface at. */
+	float PredictedClingSpeed;
+
+	/* The World time the prediction is too old to use, 0 if there is none. */
+	float PredictedClingExpireTime;
+
+	/* True if the Hit being evaluated is using the PredictedClingSpeed. */
+	bool bIsClingSpeedPredicted;
+
+	/**
+	 * Fills out the sweep the UDWallJumpSubsystem should run ahead of the Character this frame.
+	 *
+	 * @return	False if there is nothing worth predicting, the Character couldnt Cling to anything it finds.
+	 */
+	bool GatherWallClingProbe(FDWallClingProbeRequest& OutRequest) const;
+
+	/* Called by the UDWallJumpSubsystem with the Surface an Cling probe found, requested when the Character was moving at ProbeSpeed. */
+	void ApplyWallClingProbe(const FHitResult& Hit, float ProbeSpeed);
+
+	/* Where the Surface we are Clung to was when we Clung to it, or last probed it, to notice it moving away from us. */
+	FVector ClingSurfaceLocation;
+
+	/**
+	 * Checks the Surface we are Clung to is still there from what we already know about it, releasing the Cling if it isnt.
+	 * This runs every frame so it never traces, see GatherClingPersistenceProbe().
+	 *
+	 * @param	MoveTolerance	How far the Surface can move before it needs probing again.
+	 * @param	bOutNeedsProbe	Set if the Surface has moved and should be probed now rather than waiting for its turn.
+	 * @return	False if the Cling was released.
+	 */
+	bool CheckWallClingPersistence(float MoveTolerance, bool& bOutNeedsProbe);
+
+	/* Fills out the short line trace through where the Capsule touched the Surface, from ProbeDistance off it to ProbeDistance into it. */
+	bool GatherClingPersistenceProbe(FDWallClingProbeRequest& OutRequest, float ProbeDistance);
+
+	/**
+	 * Called by the UDWallJumpSubsystem with what the persistence probe found where the Character touched the Surface.
+	 *
+	 * @param	Hit		The Surface the probe found, null if there was nothing there.
+	 * @return	False if the Cling was released.
+	 */
+	bool ApplyClingPersistenceProbe(const FHitResult* Hit);
+
+	/* The Speed to check MinVelocityToWallCling against for the PendingWallHit, the predicted approach Speed if we saw the Surface coming. */
+	float GetWallClingApproachSpeed();
+
+	/* Logic for handling an Wall Jump that isnt after an Cling. */
+	void WallJump(const FVector& RicochetVelocity);
+
+	/* Logic for jumping when already Clung to an wall. */
+	void CheckWallClingJump();
+
+	/* Logic for Clinging to an Wall we have hit. */
+	void WallCling(const FDWallHitEvaluation& Evaluation);
+
+	/* Forcefully aligns the Character mesh to the Cling surface during an WallCling. */
+	void AlignCharacterMeshForCling();
+
+	/* Adds the DebugRecord to the UDWallJumpSubsystems debug buffer to be drawn and exported. */
+	void RecordWallJumpDebug(FDWallJumpDebugRecord& DebugRecord);
+
+	/* Set by the UDWallJumpSubsystem, see EDWallJumpSignificance. */
+	EDWallJumpSignificance Significance;
+
+	/* True if AlignCharacterMeshForCling() rotated the Character for the current Cling, and ReleaseWallCling() needs to rotate it back. */
+	bool bIsMeshAlignedForCling;
+
+	/* True while ReleaseWallCling() runs, the WallJumpMovement leaving the Cling mode because of it is not an new release. */
+	bool bIsReleasingWallCling;
+
+	/**
+	 * Called by the WallJumpMovement when the Character has left the Cling movement mode, once any correction from the Server has been replayed.
+	 * An Cling the Server rejected, or never received, is undone this way since the correction only puts the CharacterMovementComponent back in Falling.
+	 */
+	void OnWallClingMovementModeLeft();
+
+	/* Turns the Character to or from its Cling Rotation, sweeping the Capsule only if bSweepClingRotation is set. */
+	void SetClingRotation(const FRotator& Rotation);
+
+	/* Changes the Significance, adjusting our Tick rate to match. */
+	void SetSignificance(EDWallJumpSignificance NewSignificance, float LowSignificanceTickInterval);
+
+	/**
+	 * Binds or unbinds OnCharacterCapsuleHit() from the Capsule.
+	 * Characters whose Jump input isnt read on this machine can never act on an Hit so there is no need to receive them at all.
+	 */
+	void SetCapsuleHitHandlingEnabled(bool bEnabled);
+
+	bool IsCapsuleHitHandlingEnabled();
+
+	/* Listeners of the native event channel. */
+	FOnWallJumpEventNative WallJumpEvent;
+
+	/* The frame each EDWallJumpEventType was last broadcast on, used to only broadcast an action once. */
+	uint64 LastWallJumpEventFrames[(int32)EDWallJumpEventType::Num];
+
+	/* Broadcasts the Event to the native listeners and, if enabled, the matching Blueprint delegate. */
+	void BroadcastWallJumpEvent(const FDWallJumpEvent& Event);
+
+	/* Broadcasts an Clung event for the Surface in WallClingContext. */
+	void BroadcastClungToWallEvent();
+
+	/* Resets bAttemptedWallJump back to false. */
+	void ResetAttemptedWallJump();
+
+	/* Sets the PlayerCameraManagers view restrictions based on the WallClingHit Normal. */
+	void ApplyWallClingLookInputRestrictions();
+};
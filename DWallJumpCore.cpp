@@ -0,0 +1,174 @@
+#include "Dignity.h"
+#include "DWallJumpCore.h"
+#include "Async/ParallelFor.h"
+
+void FDWallHitBatch::Reset()
+{
+	Intents.Reset();
+
+	NormalX.Reset(); NormalY.Reset(); NormalZ.Reset();
+	UpX.Reset(); UpY.Reset(); UpZ.Reset();
+	ForwardX.Reset(); ForwardY.Reset();
+	Speed.Reset();
+	LaunchX.Reset(); LaunchY.Reset(); LaunchZ.Reset();
+	MinPitchCos.Reset(); MaxPitchCos.Reset(); MaxYawCos.Reset(); MinSpeed.Reset();
+
+	PitchDot.Reset(); YawCos.Reset();
+	RicochetX.Reset(); RicochetY.Reset(); RicochetZ.Reset();
+	PitchValid.Reset(); YawValid.Reset(); SpeedValid.Reset();
+}
+
+int32 FDWallHitBatch::Add(const FDWallHitCandidate& Candidate)
+{
+	const int32 Index = Intents.Add(Candidate.Intent);
+
+	NormalX.Add(Candidate.SurfaceNormal.X);
+	NormalY.Add(Candidate.SurfaceNormal.Y);
+	NormalZ.Add(Candidate.SurfaceNormal.Z);
+
+	UpX.Add(Candidate.CharacterUp.X);
+	UpY.Add(Candidate.CharacterUp.Y);
+	UpZ.Add(Candidate.CharacterUp.Z);
+
+	ForwardX.Add(Candidate.CharacterForward.X);
+	ForwardY.Add(Candidate.CharacterForward.Y);
+
+	Speed.Add(Candidate.CharacterSpeed);
+
+	LaunchX.Add(Candidate.LaunchVelocity.X);
+	LaunchY.Add(Candidate.LaunchVelocity.Y);
+	LaunchZ.Add(Candidate.LaunchVelocity.Z);
+
+	MinPitchCos.Add(Candidate.MinPitchSurfaceAngleCos);
+	MaxPitchCos.Add(Candidate.MaxPitchSurfaceAngleCos);
+	MaxYawCos.Add(Candidate.MaxYawSurfaceAngleCos);
+	MinSpeed.Add(Candidate.MinSpeed);
+
+	return Index;
+}
+
+void FDWallHitBatch::Evaluate()
+{
+	AllocateResults();
+	EvaluateRange(0, Num());
+}
+
+void FDWallHitBatch::EvaluateParallel(int32 MinBatchSize /*= 64*/)
+{
+	AllocateResults();
+
+	const int32 Count = Num();
+	const int32 RunSize = FMath::Max(MinBatchSize, 1);
+	const int32 NumRuns = FMath::DivideAndRoundUp(Count, RunSize);
+
+	// Every run writes to its own range of the result arrays, so they need no synchronization.
+	ParallelFor(NumRuns, [this, Count, RunSize](int32 RunIndex)
+	{
+		const int32 StartIndex = RunIndex * RunSize;
+		EvaluateRange(StartIndex, FMath::Min(StartIndex + RunSize, Count));
+	}, NumRuns <= 1);
+}
+
+void FDWallHitBatch::AllocateResults()
+{
+	const int32 Count = Num();
+
+	PitchDot.SetNumUninitialized(Count);
+	YawCos.SetNumUninitialized(Count);
+	RicochetX.SetNumUninitialized(Count);
+	RicochetY.SetNumUninitialized(Count);
+	RicochetZ.SetNumUninitialized(Count);
+	PitchValid.SetNumUninitialized(Count);
+	YawValid.SetNumUninitialized(Count);
+	SpeedValid.SetNumUninitialized(Count);
+}
+
+void FDWallHitBatch::EvaluateRange(int32 StartIndex, int32 EndIndex)
+{
+	// Pitch, the Dot between the Characters Up vector and the Surface normal has to sit within the Cosine bounds.
+	for (int32 Index = StartIndex; Index < EndIndex; Index++)
+	{
+		const float Dot = FDWallJumpCore::ComputePitchDot(UpX[Index], UpY[Index], UpZ[Index], NormalX[Index], NormalY[Index], NormalZ[Index]);
+		PitchDot[Index] = Dot;
+		PitchValid[Index] = (Dot >= MaxPitchCos[Index]) & (Dot <= MinPitchCos[Index]);
+	}
+
+	for (int32 Index = StartIndex; Index < EndIndex; Index++)
+	{
+		const float Cos = FDWallJumpCore::ComputeYawCos(ForwardX[Index], ForwardY[Index], NormalX[Index], NormalY[Index]);
+		YawCos[Index] = Cos;
+		YawValid[Index] = Cos >= MaxYawCos[Index];
+	}
+
+	for (int32 Index = StartIndex; Index < EndIndex; Index++)
+	{
+		SpeedValid[Index] = Speed[Index] >= MinSpeed[Index];
+	}
+
+	// Ricochet, the same as FVector::MirrorByVector() of the Launch velocity by the Surface normal.
+	for (int32 Index = StartIndex; Index < EndIndex; Index++)
+	{
+		const float LaunchDot = LaunchX[Index] * NormalX[Index] + LaunchY[Index] * NormalY[Index] + LaunchZ[Index] * NormalZ[Index];
+		RicochetX[Index] = LaunchX[Index] - NormalX[Index] * (2.f * LaunchDot);
+		RicochetY[Index] = LaunchY[Index] - NormalY[Index] * (2.f * LaunchDot);
+		RicochetZ[Index] = LaunchZ[Index] - NormalZ[Index] * (2.f * LaunchDot);
+	}
+}
+
+FDWallHitEvaluation FDWallHitBatch::GetEvaluation(int32 Index) const
+{
+	FDWallHitEvaluation Evaluation;
+	Evaluation.Intent = Intents[Index];
+	Evaluation.PitchDot = PitchDot[Index];
+	Evaluation.YawCos = YawCos[Index];
+	Evaluation.bIsPitchValid = PitchValid[Index] != 0;
+	Evaluation.bIsYawValid = YawValid[Index] != 0;
+	Evaluation.bIsSpeedValid = SpeedValid[Index] != 0;
+	Evaluation.RicochetVelocity = FVector(RicochetX[Index], RicochetY[Index], RicochetZ[Index]);
+	return Evaluation;
+}
+
+FDWallHitEvaluation FDWallJumpCore::EvaluateCandidate(const FDWallHitCandidate& Candidate)
+{
+	const FVector& Normal = Candidate.SurfaceNormal;
+	const FVector& Launch = Candidate.LaunchVelocity;
+
+	FDWallHitEvaluation Evaluation;
+	Evaluation.Intent = Candidate.Intent;
+	Evaluation.PitchDot = ComputePitchDot(Candidate.CharacterUp.X, Candidate.CharacterUp.Y, Candidate.CharacterUp.Z, Normal.X, Normal.Y, Normal.Z);
+	Evaluation.YawCos = ComputeYawCos(Candidate.CharacterForward.X, Candidate.CharacterForward.Y, Normal.X, Normal.Y);
+	Evaluation.bIsPitchValid = Evaluation.PitchDot >= Candidate.MaxPitchSurfaceAngleCos && Evaluation.PitchDot <= Candidate.MinPitchSurfaceAngleCos;
+	Evaluation.bIsYawValid = Evaluation.YawCos >= Candidate.MaxYawSurfaceAngleCos;
+	Evaluation.bIsSpeedValid = Candidate.CharacterSpeed >= Candidate.MinSpeed;
+
+	const float LaunchDot = Launch.X * Normal.X + Launch.Y * Normal.Y + Launch.Z * Normal.Z;
+	Evaluation.RicochetVelocity = FVector(Launch.X - Normal.X * (2.f * LaunchDot), Launch.Y - Normal.Y * (2.f * LaunchDot), Launch.Z - Normal.Z * (2.f * LaunchDot));
+
+	return Evaluation;
+}
+
+bool FDWallJumpCore::DecideHitIntent(const FDWallJumpCoreSettings& Settings, const FDWallJumpCoreState& State, bool bJumpKeyDown, bool bJumpJustPressed, EDWallHitIntent& OutIntent)
+{
+	return DecideHitIntent<FDWallJumpDynamicPolicy>(Settings, State, bJumpKeyDown, bJumpJustPressed, OutIntent);
+}
+
+bool FDWallJumpCore::IsHoldingWallRightSide(const FVector& CharacterForward, const FVector& SurfaceNormal, float MaxYawSurfaceAngleCos, float& OutRightSideCos)
+{
+	FVector SurfaceNormalUpVector;
+	FVector SurfaceNormalLeftVector;
+	SurfaceNormal.FindBestAxisVectors(SurfaceNormalUpVector, SurfaceNormalLeftVector);
+
+	// The Right side angle has to be between the Max Yaw angle and 90 degrees, which is an cosine between 0 and that of the Max Yaw angle.
+	OutRightSideCos = CharacterForward.CosineAngle2D(SurfaceNormalLeftVector * -1.f);
+	return OutRightSideCos >= 0.f && OutRightSideCos <= MaxYawSurfaceAngleCos;
+}
+
+FDWallJumpCoreStepResult FDWallJumpCore::Step(const FDWallJumpCoreSettings& Settings, FDWallJumpCoreState& State, const FDWallJumpCoreFrame& Frame)
+{
+	return Step<FDWallJumpDynamicPolicy>(Settings, State, Frame);
+}
+
+uint32 FDWallJumpCore::Replay(const FDWallJumpCoreSettings& Settings, const TArray<FDWallJumpCoreFrame>& Frames, TArray<FDWallJumpCoreStepResult>& OutResults)
+{
+	return Replay<FDWallJumpDynamicPolicy>(Settings, Frames, OutResults);
+}
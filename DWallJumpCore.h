@@ -0,0 +1,538 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/Crc.h"
+
+/**
+ * The Cling and Jump math and state machine of the WJC, with no dependency on Actors, Components, Controllers or the World.
+ * Everything the WJC reads from its Character, PlayerController and PlayerCameraManager is passed in, so the same logic can be
+ * driven by an scripted feed of frames and replayed deterministically outside of an running game.
+ */
+
+/* What an WJC wants to do with the Hit it has submitted for evaluation. */
+enum class EDWallHitIntent : uint8
+{
+	Cling,
+	Jump
+};
+
+/* The data an WJC submits for its best Hit of the frame, everything the Cling and Jump math needs is copied out of the Character beforehand. */
+struct FDWallHitCandidate
+{
+	EDWallHitIntent Intent;
+
+	/* The ImpactNormal of the Surface that was hit. */
+	FVector SurfaceNormal;
+
+	/* The Characters Up vector at the time of the Hit. */
+	FVector CharacterUp;
+
+	/* The Characters Forward vector at the time of the Hit. */
+	FVector CharacterForward;
+
+	/* The Characters Speed at the time of the Hit. */
+	float CharacterSpeed;
+
+	/* The Camera direction scaled by the WallJumpMagnitude, this is mirrored by the SurfaceNormal to get the Ricochet velocity. */
+	FVector LaunchVelocity;
+
+	/* The Cosine bounds of the WJCs Cling angles, see FDWallJumpTuningValues::UpdateDerivedValues(). */
+	float MinPitchSurfaceAngleCos;
+	float MaxPitchSurfaceAngleCos;
+	float MaxYawSurfaceAngleCos;
+
+	/* The WJCs MinVelocityToWallCling. */
+	float MinSpeed;
+
+	FDWallHitCandidate()
+		: Intent(EDWallHitIntent::Cling)
+		, SurfaceNormal(FVector::ZeroVector)
+		, CharacterUp(FVector::UpVector)
+		, CharacterForward(FVector::ForwardVector)
+		, CharacterSpeed(0.f)
+		, LaunchVelocity(FVector::ZeroVector)
+		, MinPitchSurfaceAngleCos(1.f)
+		, MaxPitchSurfaceAngleCos(-1.f)
+		, MaxYawSurfaceAngleCos(1.f)
+		, MinSpeed(0.f)
+	{
+	}
+};
+
+/* The result of evaluating an FDWallHitCandidate, handed back to the WJC that submitted it. */
+struct FDWallHitEvaluation
+{
+	EDWallHitIntent Intent;
+
+	/* Dot between the Characters Up vector and the Surface normal. */
+	float PitchDot;
+
+	/* 2D Cosine between the Characters Forward vector and the inverse Surface normal. */
+	float YawCos;
+
+	uint32 bIsPitchValid : 1;
+	uint32 bIsYawValid : 1;
+	uint32 bIsSpeedValid : 1;
+
+	/* The LaunchVelocity mirrored by the Surface normal. */
+	FVector RicochetVelocity;
+};
+
+/**
+ * Structure of Arrays holding every candidate submitted in an frame so the Cling angle tests and Ricochet math can run over contiguous data.
+ * The evaluation loops are branch free so the compiler can vectorize them, keeping the per WJC cost flat as the number of Characters grows.
+ * Candidates are identified by the index Add() returns, whoever fills the batch keeps track of who submitted them.
+ */
+struct DIGNITY_API FDWallHitBatch
+{
+	TArray<EDWallHitIntent> Intents;
+
+	TArray<float> NormalX, NormalY, NormalZ;
+	TArray<float> UpX, UpY, UpZ;
+	TArray<float> ForwardX, ForwardY;
+	TArray<float> Speed;
+	TArray<float> LaunchX, LaunchY, LaunchZ;
+	TArray<float> MinPitchCos, MaxPitchCos, MaxYawCos, MinSpeed;
+
+	TArray<float> PitchDot, YawCos;
+	TArray<float> RicochetX, RicochetY, RicochetZ;
+	TArray<uint8> PitchValid, YawValid, SpeedValid;
+
+	FORCEINLINE int32 Num() const { return Intents.Num(); }
+
+	/* Empties the batch while keeping its allocations for the next frame. */
+	void Reset();
+
+	/* Adds an candidate to the batch, returning its index. */
+	int32 Add(const FDWallHitCandidate& Candidate);
+
+	/* Runs the Cling and Jump math for every candidate in the batch. */
+	void Evaluate();
+
+	/**
+	 * Runs the same math as Evaluate() split across the task graph worker threads, returning once every candidate has been evaluated.
+	 * The candidates are evaluated in runs of at least MinBatchSize, fewer candidates than that are evaluated on the calling thread.
+	 */
+	void EvaluateParallel(int32 MinBatchSize = 64);
+
+	/* Returns the results for the candidate at Index, only valid after Evaluate(). */
+	FDWallHitEvaluation GetEvaluation(int32 Index) const;
+
+private:
+
+	/* Sizes the result arrays for every candidate in the batch. */
+	void AllocateResults();
+
+	/* Runs the Cling and Jump math for the candidates from StartIndex up to but not including EndIndex, the results have to be allocated already. */
+	void EvaluateRange(int32 StartIndex, int32 EndIndex);
+};
+
+/* The WJC settings the core needs, with the Cling angles already converted to their Cosine bounds. */
+struct FDWallJumpCoreSettings
+{
+	bool bCanWallCling;
+	bool bCanWallJump;
+	bool bRequireClingToWallJump;
+
+	int32 MaxSequentialWallClings;
+	int32 MaxSequentialWallJumps;
+
+	/* 0 for an infinite Cling. */
+	float ClingDuration;
+	float WallJumpGracePeriodDuration;
+	float WallJumpMagnitude;
+	float ClingDamageReleaseThreshold;
+
+	float MinPitchSurfaceAngleCos;
+	float MaxPitchSurfaceAngleCos;
+	float MaxYawSurfaceAngleCos;
+	float MinSpeed;
+
+	/* Whether the Surface being hit allows each feature, unlike the flags above these change from Hit to Hit so no policy can fix them. */
+	bool bSurfaceAllowsCling;
+	bool bSurfaceAllowsJump;
+
+	FDWallJumpCoreSettings()
+		: bCanWallCling(true)
+		, bCanWallJump(true)
+		, bRequireClingToWallJump(false)
+		, MaxSequentialWallClings(1)
+		, MaxSequentialWallJumps(1)
+		, ClingDuration(5.f)
+		, WallJumpGracePeriodDuration(0.5f)
+		, WallJumpMagnitude(1000.f)
+		, ClingDamageReleaseThreshold(10.f)
+		, MinPitchSurfaceAngleCos(1.f)
+		, MaxPitchSurfaceAngleCos(-1.f)
+		, MaxYawSurfaceAngleCos(1.f)
+		, MinSpeed(0.f)
+		, bSurfaceAllowsCling(true)
+		, bSurfaceAllowsJump(true)
+	{
+	}
+};
+
+/**
+ * Reads which of the Cling and Jump features are enabled from the Settings on every evaluation.
+ * The fallback for WJCs whose flags dont match an archetype, or that change them at runtime.
+ */
+struct FDWallJumpDynamicPolicy
+{
+	static FORCEINLINE bool CanWallCling(const FDWallJumpCoreSettings& Settings) { return Settings.bCanWallCling && Settings.bSurfaceAllowsCling; }
+	static FORCEINLINE bool CanWallJump(const FDWallJumpCoreSettings& Settings) { return Settings.bCanWallJump && Settings.bSurfaceAllowsJump; }
+	static FORCEINLINE bool RequiresClingToWallJump(const FDWallJumpCoreSettings& Settings) { return Settings.bRequireClingToWallJump; }
+
+	static FORCEINLINE bool Matches(const FDWallJumpCoreSettings& Settings) { return true; }
+};
+
+/**
+ * Fixes which of the Cling and Jump features an archetype uses at compile time, so the core is compiled without the branches it never takes.
+ * The flags in the Settings are never read, only Settings that Match() may be used. An feature that is compiled in can still be refused by the Surface being hit.
+ */
+template<bool bInCanWallCling, bool bInCanWallJump, bool bInRequireClingToWallJump>
+struct TDWallJumpStaticPolicy
+{
+	static FORCEINLINE bool CanWallCling(const FDWallJumpCoreSettings& Settings) { return bInCanWallCling && Settings.bSurfaceAllowsCling; }
+	static FORCEINLINE bool CanWallJump(const FDWallJumpCoreSettings& Settings) { return bInCanWallJump && Settings.bSurfaceAllowsJump; }
+	static FORCEINLINE bool RequiresClingToWallJump(const FDWallJumpCoreSettings& Settings) { return bInRequireClingToWallJump; }
+
+	/* True if the Settings were made for this policy, bRequireClingToWallJump doesnt matter to an archetype that cant Jump. */
+	static FORCEINLINE bool Matches(const FDWallJumpCoreSettings& Settings)
+	{
+		return Settings.bCanWallCling == bInCanWallCling && Settings.bCanWallJump == bInCanWallJump && (!bInCanWallJump || Settings.bRequireClingToWallJump == bInRequireClingToWallJump);
+	}
+};
+
+typedef TDWallJumpStaticPolicy<true, true, false> FDWallJumpClingAndJumpPolicy;
+typedef TDWallJumpStaticPolicy<true, true, true> FDWallJumpClingThenJumpPolicy;
+typedef TDWallJumpStaticPolicy<true, false, false> FDWallJumpClingOnlyPolicy;
+typedef TDWallJumpStaticPolicy<false, true, false> FDWallJumpJumpOnlyPolicy;
+
+/* The WJC state the core steps, the same counters and deadlines the WJC keeps. */
+struct FDWallJumpCoreState
+{
+	int32 WallClingCount;
+	int32 WallJumpCount;
+	bool bAttemptedWallJump;
+	bool bIsClungToWall;
+
+	/* The time the current Cling is released at, 0 if there is no deadline. */
+	float WallClingReleaseTime;
+
+	/* The time bAttemptedWallJump is reset at, 0 if there is no grace period running. */
+	float WallJumpGracePeriodEndTime;
+
+	/* The normal of the Surface we are Clung to. */
+	FVector ClingSurfaceNormal;
+
+	FDWallJumpCoreState()
+		: WallClingCount(0)
+		, WallJumpCount(0)
+		, bAttemptedWallJump(false)
+		, bIsClungToWall(false)
+		, WallClingReleaseTime(0.f)
+		, WallJumpGracePeriodEndTime(0.f)
+		, ClingSurfaceNormal(FVector::ZeroVector)
+	{
+	}
+};
+
+/* One frame of input to the core, everything the WJC would otherwise read from the Character, its Controller and its Camera. */
+struct FDWallJumpCoreFrame
+{
+	float Time;
+
+	/* True if the Character Landed on an walkable surface this frame. */
+	bool bLanded;
+
+	/* The largest single amount of damage taken this frame. */
+	float Damage;
+
+	bool bJumpKeyDown;
+	bool bJumpJustPressed;
+
+	bool bIsFalling;
+	FVector CharacterUp;
+	FVector CharacterForward;
+	float CharacterSpeed;
+
+	/* The Camera direction. */
+	FVector CameraDirection;
+
+	/* True if the Character hit an static surface this frame. */
+	bool bHasHit;
+	FVector HitNormal;
+
+	FDWallJumpCoreFrame()
+		: Time(0.f)
+		, bLanded(false)
+		, Damage(0.f)
+		, bJumpKeyDown(false)
+		, bJumpJustPressed(false)
+		, bIsFalling(true)
+		, CharacterUp(FVector::UpVector)
+		, CharacterForward(FVector::ForwardVector)
+		, CharacterSpeed(0.f)
+		, CameraDirection(FVector::ForwardVector)
+		, bHasHit(false)
+		, HitNormal(FVector::ZeroVector)
+	{
+	}
+};
+
+/* What happened during an FDWallJumpCore::Step(), more than one can happen in the same frame. */
+namespace EDWallJumpCoreEvents
+{
+	enum Type : uint8
+	{
+		None				= 0,
+		Clung				= 1 << 0,
+		ClingRejected		= 1 << 1,
+		Jumped				= 1 << 2,
+		JumpedFromCling		= 1 << 3,
+		Fell				= 1 << 4,
+		DamageReleased		= 1 << 5,
+		CooldownExpired		= 1 << 6,
+		Landed				= 1 << 7,
+	};
+}
+
+/* The result of stepping the core through one frame. */
+struct FDWallJumpCoreStepResult
+{
+	/* EDWallJumpCoreEvents that happened this frame. */
+	uint8 Events;
+
+	/* The Launch velocity of an Jump this frame. */
+	FVector LaunchVelocity;
+
+	/* The evaluation of the Cling surface, if there was one this frame. */
+	float PitchDot;
+	float YawCos;
+
+	FDWallJumpCoreStepResult()
+		: Events(EDWallJumpCoreEvents::None)
+		, LaunchVelocity(FVector::ZeroVector)
+		, PitchDot(0.f)
+		, YawCos(0.f)
+	{
+	}
+};
+
+/* The pure Cling and Jump logic shared by the WJC and anything replaying it without an running game. */
+struct DIGNITY_API FDWallJumpCore
+{
+	/* Dot between the Characters Up vector and the Surface normal. */
+	static FORCEINLINE float ComputePitchDot(float UpX, float UpY, float UpZ, float NormalX, float NormalY, float NormalZ)
+	{
+		return UpX * NormalX + UpY * NormalY + UpZ * NormalZ;
+	}
+
+	/**
+	 * The same as FVector::CosineAngle2D() between the Characters Forward vector and the inverse Surface normal.
+	 * Vectors that are too short to normalize in 2D contribute an Cosine of 0, the same as looking along the Surface.
+	 */
+	static FORCEINLINE float ComputeYawCos(float ForwardX, float ForwardY, float NormalX, float NormalY)
+	{
+		const float SizeSquared = (ForwardX * ForwardX + ForwardY * ForwardY) * (NormalX * NormalX + NormalY * NormalY);
+		const float InvSize = SizeSquared > SMALL_NUMBER ? FMath::InvSqrt(SizeSquared) : 0.f;
+		return -(ForwardX * NormalX + ForwardY * NormalY) * InvSize;
+	}
+
+	/* Evaluates an single candidate with the same math as FDWallHitBatch::Evaluate(). */
+	static FDWallHitEvaluation EvaluateCandidate(const FDWallHitCandidate& Candidate);
+
+	/* True if the Surface can be Clung to, the counterpart of the Evaluation checks in UDWallJumpComponent::WallCling(). */
+	static FORCEINLINE bool IsClingAccepted(const FDWallHitEvaluation& Evaluation, bool bAttemptedWallJump)
+	{
+		return Evaluation.bIsPitchValid && Evaluation.bIsYawValid && Evaluation.bIsSpeedValid && !bAttemptedWallJump;
+	}
+
+	/**
+	 * Decides whether an Hit should be evaluated as an WallJump or an WallCling.
+	 *
+	 * @return	False if the Hit doesnt need to be evaluated.
+	 */
+	static bool DecideHitIntent(const FDWallJumpCoreSettings& Settings, const FDWallJumpCoreState& State, bool bJumpKeyDown, bool bJumpJustPressed, EDWallHitIntent& OutIntent);
+
+	/* DecideHitIntent() with the enabled features decided by the Policy, see TDWallJumpStaticPolicy. */
+	template<typename Policy>
+	static bool DecideHitIntent(const FDWallJumpCoreSettings& Settings, const FDWallJumpCoreState& State, bool bJumpKeyDown, bool bJumpJustPressed, EDWallHitIntent& OutIntent);
+
+	/**
+	 * Decides what side of the Surface the Character is holding from the Forward vector they hit it with.
+	 *
+	 * @param	OutRightSideCos	The 2D Cosine between the Forward vector and the Surfaces Right vector.
+	 * @return	True if the Character is holding the wall on its Right side.
+	 */
+	static bool IsHoldingWallRightSide(const FVector& CharacterForward, const FVector& SurfaceNormal, float MaxYawSurfaceAngleCos, float& OutRightSideCos);
+
+	/* Steps the State through one Frame in the same order an WJC would, deadlines, Landing, damage, Jumping from an Cling and then the Hit. */
+	static FDWallJumpCoreStepResult Step(const FDWallJumpCoreSettings& Settings, FDWallJumpCoreState& State, const FDWallJumpCoreFrame& Frame);
+
+	template<typename Policy>
+	static FDWallJumpCoreStepResult Step(const FDWallJumpCoreSettings& Settings, FDWallJumpCoreState& State, const FDWallJumpCoreFrame& Frame);
+
+	/**
+	 * Replays an scripted feed of Frames from an fresh State.
+	 *
+	 * @param	OutResults	One result per Frame.
+	 * @return	An hash of every result, two replays of the same Frames with the same Settings always produce the same hash.
+	 */
+	static uint32 Replay(const FDWallJumpCoreSettings& Settings, const TArray<FDWallJumpCoreFrame>& Frames, TArray<FDWallJumpCoreStepResult>& OutResults);
+
+	template<typename Policy>
+	static uint32 Replay(const FDWallJumpCoreSettings& Settings, const TArray<FDWallJumpCoreFrame>& Frames, TArray<FDWallJumpCoreStepResult>& OutResults);
+};
+
+template<typename Policy>
+bool FDWallJumpCore::DecideHitIntent(const FDWallJumpCoreSettings& Settings, const FDWallJumpCoreState& State, bool bJumpKeyDown, bool bJumpJustPressed, EDWallHitIntent& OutIntent)
+{
+	// An WallJump is determined to be that if the Player is against an surface an presses the "Jump" key.
+	if (Policy::CanWallJump(Settings) && State.WallJumpCount < Settings.MaxSequentialWallJumps && bJumpJustPressed)
+	{
+		// If we need an Cling in order to WallJump then this Hit does nothing, the next Hit is highly likely to come along in the next couple of frames
+		// without bJumpJustPressed and will be evaluated as an Cling instead.
+		if (Policy::RequiresClingToWallJump(Settings))
+		{
+			return false;
+		}
+
+		OutIntent = EDWallHitIntent::Jump;
+		return true;
+	}
+
+	// An WallCling is determined to be that if the Player is still holding "Jump" while hitting the Surface.
+	if (Policy::CanWallCling(Settings) && !State.bIsClungToWall && State.WallClingCount < Settings.MaxSequentialWallClings && bJumpKeyDown)
+	{
+		OutIntent = EDWallHitIntent::Cling;
+		return true;
+	}
+
+	return false;
+}
+
+template<typename Policy>
+FDWallJumpCoreStepResult FDWallJumpCore::Step(const FDWallJumpCoreSettings& Settings, FDWallJumpCoreState& State, const FDWallJumpCoreFrame& Frame)
+{
+	FDWallJumpCoreStepResult Result;
+
+	auto ReleaseCling = [&State]()
+	{
+		State.bIsClungToWall = false;
+		State.WallClingReleaseTime = 0.f;
+	};
+
+	auto StartGracePeriod = [&Settings, &State, &Frame]()
+	{
+		State.bAttemptedWallJump = true;
+		State.WallJumpGracePeriodEndTime = Frame.Time + Settings.WallJumpGracePeriodDuration;
+	};
+
+	if (State.WallJumpGracePeriodEndTime > 0.f && Frame.Time >= State.WallJumpGracePeriodEndTime)
+	{
+		State.WallJumpGracePeriodEndTime = 0.f;
+		State.bAttemptedWallJump = false;
+		Result.Events |= EDWallJumpCoreEvents::CooldownExpired;
+	}
+
+	if (State.WallClingReleaseTime > 0.f && Frame.Time >= State.WallClingReleaseTime)
+	{
+		ReleaseCling();
+		Result.Events |= EDWallJumpCoreEvents::Fell;
+	}
+
+	if (Frame.bLanded)
+	{
+		State.WallClingCount = 0;
+		State.WallJumpCount = 0;
+		State.bAttemptedWallJump = false;
+		Result.Events |= EDWallJumpCoreEvents::Landed;
+	}
+
+	if (State.bIsClungToWall && Frame.Damage > 0.f && Frame.Damage >= Settings.ClingDamageReleaseThreshold)
+	{
+		ReleaseCling();
+		Result.Events |= EDWallJumpCoreEvents::Fell | EDWallJumpCoreEvents::DamageReleased;
+	}
+
+	// Jumping from an Cling launches along the Camera rather than mirroring off the Surface.
+	if (State.bIsClungToWall && Policy::CanWallJump(Settings) && Frame.bJumpJustPressed)
+	{
+		Result.LaunchVelocity = Frame.CameraDirection * Settings.WallJumpMagnitude;
+		State.WallJumpCount++;
+		StartGracePeriod();
+		ReleaseCling();
+		Result.Events |= EDWallJumpCoreEvents::JumpedFromCling;
+	}
+
+	EDWallHitIntent Intent;
+	if (Frame.bHasHit && Frame.bIsFalling && DecideHitIntent<Policy>(Settings, State, Frame.bJumpKeyDown, Frame.bJumpJustPressed, Intent))
+	{
+		FDWallHitCandidate Candidate;
+		Candidate.Intent = Intent;
+		Candidate.SurfaceNormal = Frame.HitNormal;
+		Candidate.CharacterUp = Frame.CharacterUp;
+		Candidate.CharacterForward = Frame.CharacterForward;
+		Candidate.CharacterSpeed = Frame.CharacterSpeed;
+		Candidate.LaunchVelocity = Frame.CameraDirection * Settings.WallJumpMagnitude;
+		Candidate.MinPitchSurfaceAngleCos = Settings.MinPitchSurfaceAngleCos;
+		Candidate.MaxPitchSurfaceAngleCos = Settings.MaxPitchSurfaceAngleCos;
+		Candidate.MaxYawSurfaceAngleCos = Settings.MaxYawSurfaceAngleCos;
+		Candidate.MinSpeed = Settings.MinSpeed;
+
+		const FDWallHitEvaluation Evaluation = EvaluateCandidate(Candidate);
+
+		if (Intent == EDWallHitIntent::Jump)
+		{
+			Result.LaunchVelocity = Evaluation.RicochetVelocity;
+			State.WallJumpCount++;
+			StartGracePeriod();
+			ReleaseCling();
+			Result.Events |= EDWallJumpCoreEvents::Jumped;
+		}
+		else
+		{
+			Result.PitchDot = Evaluation.PitchDot;
+			Result.YawCos = Evaluation.YawCos;
+
+			if (IsClingAccepted(Evaluation, State.bAttemptedWallJump))
+			{
+				State.WallClingCount++;
+				State.bIsClungToWall = true;
+				State.bAttemptedWallJump = false;
+				State.ClingSurfaceNormal = Frame.HitNormal;
+				State.WallClingReleaseTime = Settings.ClingDuration > 0.f ? Frame.Time + Settings.ClingDuration : 0.f;
+				Result.Events |= EDWallJumpCoreEvents::Clung;
+			}
+			else
+			{
+				Result.Events |= EDWallJumpCoreEvents::ClingRejected;
+			}
+		}
+	}
+
+	return Result;
+}
+
+template<typename Policy>
+uint32 FDWallJumpCore::Replay(const FDWallJumpCoreSettings& Settings, const TArray<FDWallJumpCoreFrame>& Frames, TArray<FDWallJumpCoreStepResult>& OutResults)
+{
+	FDWallJumpCoreState State;
+	uint32 Hash = 0;
+
+	OutResults.Reset(Frames.Num());
+
+	for (const FDWallJumpCoreFrame& Frame : Frames)
+	{
+		const FDWallJumpCoreStepResult& Result = OutResults.Add_GetRef(Step<Policy>(Settings, State, Frame));
+
+		// Hash the fields one at a time so padding never ends up in the hash.
+		Hash = FCrc::MemCrc32(&Result.Events, sizeof(Result.Events), Hash);
+		Hash = FCrc::MemCrc32(&Result.LaunchVelocity, sizeof(Result.LaunchVelocity), Hash);
+		Hash = FCrc::MemCrc32(&Result.PitchDot, sizeof(Result.PitchDot), Hash);
+		Hash = FCrc::MemCrc32(&Result.YawCos, sizeof(Result.YawCos), Hash);
+	}
+
+	return Hash;
+}
@@ -0,0 +1,144 @@
+#include "Dignity.h"
+#include "DWallJumpDebug.h"
+#include "DrawDebugHelpers.h"
+#include "Misc/FileHelper.h"
+
+FDWallJumpDebugBuffer::FDWallJumpDebugBuffer(int32 InCapacity /*= 256*/)
+	: Head(0)
+	, Count(0)
+{
+	Records.SetNum(FMath::Max(InCapacity, 1));
+}
+
+void FDWallJumpDebugBuffer::Add(const FDWallJumpDebugRecord& Record)
+{
+	Records[Head] = Record;
+	Head = (Head + 1) % Records.Num();
+	Count = FMath::Min(Count + 1, Records.Num());
+}
+
+void FDWallJumpDebugBuffer::Reset()
+{
+	Head = 0;
+	Count = 0;
+}
+
+const FDWallJumpDebugRecord& FDWallJumpDebugBuffer::GetRecord(int32 Age) const
+{
+	check(Age >= 0 && Age < Count);
+	return Records[(Head - 1 - Age + Records.Num()) % Records.Num()];
+}
+
+bool FDWallJumpDebugBuffer::HasRecentRecords(float WorldTime, float MaxAge) const
+{
+	return Count > 0 && WorldTime - GetRecord(0).WorldTime <= MaxAge;
+}
+
+void FDWallJumpDebugBuffer::Draw(UWorld* World, float MaxAge, int32 MaxRecords) const
+{
+	if (!World)
+	{
+		return;
+	}
+
+	const float WorldTime = World->GetTimeSeconds();
+	const int32 NumToDraw = FMath::Min(Count, MaxRecords);
+
+	for (int32 Age = 0; Age < NumToDraw; Age++)
+	{
+		const FDWallJumpDebugRecord& Record = GetRecord(Age);
+
+		// Records are newest first so everything after this is older still.
+		if (WorldTime - Record.WorldTime > MaxAge)
+		{
+			break;
+		}
+
+		DrawRecord(World, Record);
+	}
+}
+
+void FDWallJumpDebugBuffer::DrawRecord(UWorld* World, const FDWallJumpDebugRecord& Record)
+{
+	// Everything is drawn for this frame only, the buffer is drawn again next frame.
+	switch (Record.Action)
+	{
+		case EDWallJumpDebugAction::Cling:
+		{
+			const FVector InverseSurfaceNormal = Record.Normal * -1.f;
+			const FVector ImpactPointExtended = (Record.Normal * 50.f) + Record.Location;
+			const FVector ImpactPointExtendedUp = FVector(ImpactPointExtended.X, ImpactPointExtended.Y, ImpactPointExtended.Z + 50.f);
+			const FVector CharacterForwardVectorExtended = (Record.Direction * 50.f) + ImpactPointExtended;
+			const FVector InverseSurfaceNormalExtended = (InverseSurfaceNormal * 50.f) + Record.Location;
+
+			DrawDebugLine(World, Record.Location, ImpactPointExtended, FColor::Green, false, -1.f, 0.f, .5f);
+			DrawDebugLine(World, ImpactPointExtended, ImpactPointExtendedUp, FColor::Blue, false, -1.f, 0.f, .5f);
+			DrawDebugLine(World, ImpactPointExtended, CharacterForwardVectorExtended, FColor::Red, false, -1.f, 0.f, .5f);
+			DrawDebugLine(World, Record.Location, InverseSurfaceNormalExtended, FColor::Yellow, false, -1.f, 0.f, .5f);
+
+			DrawDebugString(World, ImpactPointExtended, "Pitch: " + FString::SanitizeFloat(Record.AngleA), NULL, FColor::Green, 0.f, true);
+			DrawDebugString(World, CharacterForwardVectorExtended, "Yaw: " + FString::SanitizeFloat(Record.AngleB), NULL, FColor::Red, 0.f, true);
+			DrawDebugString(World, ImpactPointExtendedUp, Record.bAccepted ? "Valid Cling Surface" : "Invalid Cling Surface", NULL, Record.bAccepted ? FColor::Blue : FColor::Orange, 0.f, true);
+
+			DrawDebugCircle(World, ImpactPointExtended, 25.f, 50.f, FColor::Red, false, -1.f, 0.f, .5f, Record.Right, Record.Direction, true);
+			DrawDebugCircle(World, ImpactPointExtended, 25.f, 50.f, FColor::Green, false, -1.f, 0.f, .5f, FVector::CrossProduct(Record.Right, InverseSurfaceNormal), InverseSurfaceNormal, true);
+			break;
+		}
+		case EDWallJumpDebugAction::Jump:
+		case EDWallJumpDebugAction::ClingJump:
+		{
+			const bool bFromCling = Record.Action == EDWallJumpDebugAction::ClingJump;
+			const FColor JumpColor = bFromCling ? FColor::Green : FColor::Red;
+			const FVector RicochetStart = bFromCling ? Record.Location : Record.Location + Record.Normal;
+			const FVector RicochetDirection = RicochetStart + (Record.Direction.GetSafeNormal() * 100.f);
+
+			DrawDebugDirectionalArrow(World, Record.Location, RicochetDirection, 5.f, JumpColor, false, -1.f, 0.f, 1.f);
+			DrawDebugString(World, Record.Location, "Jump Velocity: " + Record.Direction.ToString(), NULL, JumpColor, 0.f, true);
+			break;
+		}
+		case EDWallJumpDebugAction::Align:
+		{
+			FVector SurfaceNormalUpVector;
+			FVector SurfaceNormalLeftVector;
+			Record.Normal.FindBestAxisVectors(SurfaceNormalUpVector, SurfaceNormalLeftVector);
+			const FVector SurfaceNormalRightVector = SurfaceNormalLeftVector * -1.f;
+
+			FVector ImpactPointExtended = Record.Location + (Record.Normal * 50.f);
+			ImpactPointExtended.Z = ImpactPointExtended.Z + 50.f;
+
+			const FVector SurfaceNormalUpExtended = ImpactPointExtended + (SurfaceNormalUpVector * 50.f);
+			const FVector SurfaceNormalLeftExtended = ImpactPointExtended + (SurfaceNormalLeftVector * 50.f);
+			const FVector SurfaceNormalRightExtended = ImpactPointExtended + (SurfaceNormalRightVector * 50.f);
+
+			DrawDebugLine(World, ImpactPointExtended, SurfaceNormalUpExtended, FColor::Blue, false, -1.f, 0.f, .5f);
+			DrawDebugLine(World, ImpactPointExtended, SurfaceNormalLeftExtended, FColor::Green, false, -1.f, 0.f, .5f);
+			DrawDebugLine(World, ImpactPointExtended, SurfaceNormalRightExtended, FColor::Red, false, -1.f, 0.f, .5f);
+
+			DrawDebugString(World, SurfaceNormalUpExtended, "Normal Up", NULL, FColor::Blue, 0.f, true);
+			DrawDebugString(World, SurfaceNormalLeftExtended, "Normal Left: " + FString::SanitizeFloat(Record.AngleB) + " | " + (!Record.bAccepted ? "True" : "False"), NULL, FColor::Green, 0.f, true);
+			DrawDebugString(World, SurfaceNormalRightExtended, "Normal Right: " + FString::SanitizeFloat(Record.AngleA) + " | " + (Record.bAccepted ? "True" : "False"), NULL, FColor::Red, 0.f, true);
+			break;
+		}
+	}
+}
+
+bool FDWallJumpDebugBuffer::ExportToCSV(const FString& FilePath) const
+{
+	static const TCHAR* ActionNames[] = { TEXT("Cling"), TEXT("Jump"), TEXT("ClingJump"), TEXT("Align") };
+
+	FString CSV = TEXT("WorldTime,Character,Action,Accepted,LocationX,LocationY,LocationZ,NormalX,NormalY,NormalZ,DirectionX,DirectionY,DirectionZ,AngleA,AngleB\n");
+
+	for (int32 Age = Count - 1; Age >= 0; Age--)
+	{
+		const FDWallJumpDebugRecord& Record = GetRecord(Age);
+
+		CSV += FString::Printf(TEXT("%.4f,%s,%s,%d,%.2f,%.2f,%.2f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.3f,%.3f\n"),
+			Record.WorldTime, *Record.CharacterName.ToString(), ActionNames[(uint8)Record.Action], Record.bAccepted ? 1 : 0,
+			Record.Location.X, Record.Location.Y, Record.Location.Z,
+			Record.Normal.X, Record.Normal.Y, Record.Normal.Z,
+			Record.Direction.X, Record.Direction.Y, Record.Direction.Z,
+			Record.AngleA, Record.AngleB);
+	}
+
+	return FFileHelper::SaveStringToFile(CSV, *FilePath);
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+
+/* What an FDWallJumpDebugRecord describes. */
+enum class EDWallJumpDebugAction : uint8
+{
+	/* An Cling surface evaluation, accepted or rejected. */
+	Cling,
+	/* An WallJump from an Hit. */
+	Jump,
+	/* An WallJump from an Cling. */
+	ClingJump,
+	/* The Mesh alignment after an Cling. */
+	Align
+};
+
+/* An single Cling or Jump evaluation kept for debugging, small enough to hold a few hundred of without any allocations. */
+struct FDWallJumpDebugRecord
+{
+	/* The World time the evaluation happened at. */
+	float WorldTime;
+
+	/* The Character that was evaluated. */
+	FName CharacterName;
+
+	EDWallJumpDebugAction Action;
+
+	/* Cling, if the surface was valid. Align, if the Character is holding the wall on its Right side. */
+	bool bAccepted;
+
+	/* The Impact point of the Hit, or the Characters location for an ClingJump. */
+	FVector Location;
+
+	/* The Impact normal of the Hit. */
+	FVector Normal;
+
+	/* Cling, the Characters Forward vector. Jump, the Launch velocity. */
+	FVector Direction;
+
+	/* Cling, the Characters Right vector. */
+	FVector Right;
+
+	/* Cling, the Pitch and Yaw impact angles. Align, the Right and Left side angles. In degrees. */
+	float AngleA;
+	float AngleB;
+
+	FDWallJumpDebugRecord()
+		: WorldTime(0.f)
+		, CharacterName(NAME_None)
+		, Action(EDWallJumpDebugAction::Cling)
+		, bAccepted(false)
+		, Location(FVector::ZeroVector)
+		, Normal(FVector::ZeroVector)
+		, Direction(FVector::ZeroVector)
+		, Right(FVector::ZeroVector)
+		, AngleA(0.f)
+		, AngleB(0.f)
+	{
+	}
+};
+
+/**
+ * Fixed capacity ring buffer of the most recent Cling and Jump evaluations.
+ * Replaces drawing them as persistent debug shapes, which grew without bound, the buffer is redrawn every frame at an capped cost and can be exported to an file.
+ */
+class DIGNITY_API FDWallJumpDebugBuffer
+{
+public:
+
+	explicit FDWallJumpDebugBuffer(int32 InCapacity = 256);
+
+	/* Adds the Record, overwriting the oldest one once the buffer is full. */
+	void Add(const FDWallJumpDebugRecord& Record);
+
+	/* Draws at most MaxRecords of the most recent Records that are no older than MaxAge seconds, for this frame only. */
+	void Draw(UWorld* World, float MaxAge, int32 MaxRecords) const;
+
+	/* Writes every Record, oldest first, to an CSV file. */
+	bool ExportToCSV(const FString& FilePath) const;
+
+	/* True if any Record is no older than MaxAge seconds. */
+	bool HasRecentRecords(float WorldTime, float MaxAge) const;
+
+	FORCEINLINE int32 Num() const { return Count; }
+
+	void Reset();
+
+private:
+
+	TArray<FDWallJumpDebugRecord> Records;
+
+	/* Where the next Record will be written. */
+	int32 Head;
+
+	/* How many Records are in the buffer. */
+	int32 Count;
+
+	/* Returns the Record that was added Age Records ago, 0 being the newest. */
+	const FDWallJumpDebugRecord& GetRecord(int32 Age) const;
+
+	static void DrawRecord(UWorld* World, const FDWallJumpDebugRecord& Record);
+};
@@ -0,0 +1,451 @@
+#include "Dignity.h"
+#include "DWallJumpHitStream.h"
+#include "DWallJumpStats.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#if !UE_BUILD_SHIPPING && DIGNITY_DEVELOPMENT
+static FAutoConsoleCommand CmdWallJumpRecordHitStream(
+	TEXT("dignity.WallJump.RecordHitStream"),
+	TEXT("Records an random feed of Frames and what the core decided for them. Usage: dignity.WallJump.RecordHitStream [Name] [NumFrames] [Seed]. Files are written to Saved/WallJump/. ")
+	TEXT("Golden records what the core decides for the Frames of the golden stream again, only do so when the change in its decisions is intended."),
+	FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+	{
+		const FString Name = Args.Num() > 0 ? Args[0] : TEXT("Default");
+		const int32 NumFrames = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 10000;
+		const int32 Seed = Args.Num() > 2 ? FCString::Atoi(*Args[2]) : 0x57A11;
+
+		FDWallJumpHitStream Stream;
+		FString FilePath;
+
+		// The golden stream keeps its Frames, they were picked to stay clear of the Cling angle and speed bounds.
+		if (Name == TEXT("Golden"))
+		{
+			FilePath = FDWallJumpHitStream::GetGoldenFilePath();
+			if (!Stream.Load(FilePath))
+			{
+				return;
+			}
+		}
+		else
+		{
+			FilePath = FDWallJumpHitStream::GetFilePath(Name);
+			Stream.GenerateRandom(NumFrames, Seed);
+		}
+
+		Stream.Record();
+
+		if (Stream.Save(FilePath))
+		{
+			UE_LOG(LogDWallJump, Log, TEXT("RecordHitStream: %d frames recorded to %s, hash %08x."), Stream.Frames.Num(), *FilePath, Stream.ExpectedHash);
+		}
+	}));
+
+static FAutoConsoleCommand CmdWallJumpReplayHitStream(
+	TEXT("dignity.WallJump.ReplayHitStream"),
+	TEXT("Replays an recorded stream through the core, checks it still makes the same decisions and logs how many Steps it evaluates per second. Usage: dignity.WallJump.ReplayHitStream [Name] [Repeats]. ")
+	TEXT("Without an Name the golden stream checked in next to the sources is replayed."),
+	FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+	{
+		const FString Name = Args.Num() > 0 ? Args[0] : TEXT("Golden");
+		const int32 NumRepeats = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 100;
+
+		FDWallJumpHitStream Stream;
+		const FString FilePath = Name == TEXT("Golden") ? FDWallJumpHitStream::GetGoldenFilePath() : FDWallJumpHitStream::GetFilePath(Name);
+		if (!Stream.Load(FilePath))
+		{
+			UE_LOG(LogDWallJump, Error, TEXT("ReplayHitStream: FAILED, %s could not be loaded from %s."), *Name, *FilePath);
+			return;
+		}
+
+		TArray<FDWallJumpCoreStepResult> Results;
+		const int32 MismatchIndex = Stream.Verify(Results);
+		if (MismatchIndex != INDEX_NONE)
+		{
+			const FDWallJumpCoreStepResult& Expected = Stream.ExpectedResults[MismatchIndex];
+			const FDWallJumpCoreStepResult& Actual = Results[MismatchIndex];
+			UE_LOG(LogDWallJump, Error, TEXT("ReplayHitStream: FAILED, %s drifted at frame %d of %d. Expected events %02x launch %s pitch %.6f yaw %.6f, got events %02x launch %s pitch %.6f yaw %.6f."),
+				*Name, MismatchIndex, Stream.Frames.Num(),
+				Expected.Events, *Expected.LaunchVelocity.ToString(), Expected.PitchDot, Expected.YawCos,
+				Actual.Events, *Actual.LaunchVelocity.ToString(), Actual.PitchDot, Actual.YawCos);
+			return;
+		}
+
+		uint32 Hash = 0;
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Repeat = 0; Repeat < NumRepeats; Repeat++)
+		{
+			Hash = FDWallJumpCore::Replay(Stream.Settings, Stream.Frames, Results);
+		}
+		const double Seconds = FPlatformTime::Seconds() - StartTime;
+		const double NumSteps = (double)Stream.Frames.Num() * NumRepeats;
+
+		// An matching hash means the results are bit for bit the same, only the tolerance kept them matching otherwise.
+		UE_LOG(LogDWallJump, Log, TEXT("ReplayHitStream: %s matches its %d recorded frames%s. %.0f Steps per second, %.2f ns per Step."),
+			*Name, Stream.Frames.Num(), Hash == Stream.ExpectedHash ? TEXT("") : TEXT(" within tolerance"), NumSteps / FMath::Max(Seconds, SMALL_NUMBER), Seconds * 1000000000.0 / NumSteps);
+	}));
+#endif //!UE_BUILD_SHIPPING && DIGNITY_DEVELOPMENT
+
+FDWallJumpHitStream::FDWallJumpHitStream()
+	: ExpectedHash(0)
+{
+}
+
+FString FDWallJumpHitStream::GetFilePath(const FString& Name)
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("WallJump"), Name + TEXT(".wjstream"));
+}
+
+FString FDWallJumpHitStream::GetGoldenFilePath()
+{
+	// Only Development builds replay it, and those are built from the sources it sits next to.
+	return FPaths::Combine(FPaths::GetPath(FString(ANSI_TO_TCHAR(__FILE__))), TEXT("DWallJumpHitStreamGolden.txt"));
+}
+
+void FDWallJumpHitStream::GenerateRandom(int32 NumFrames, int32 Seed)
+{
+	FRandomStream Random(Seed);
+	Frames.SetNum(NumFrames);
+
+	for (int32 Index = 0; Index < NumFrames; Index++)
+	{
+		FDWallJumpCoreFrame& Frame = Frames[Index];
+		Frame.Time = Index / 60.f;
+		Frame.bLanded = Random.FRand() < 0.02f;
+		Frame.bJumpKeyDown = Random.FRand() < 0.5f;
+		Frame.bJumpJustPressed = Random.FRand() < 0.1f;
+		Frame.CharacterForward = FVector(Random.FRandRange(-1.f, 1.f), Random.FRandRange(-1.f, 1.f), 0.f).GetSafeNormal();
+		Frame.CharacterSpeed = Random.FRandRange(0.f, 1000.f);
+		Frame.CameraDirection = Random.GetUnitVector();
+		Frame.bHasHit = Random.FRand() < 0.3f;
+		Frame.HitNormal = FVector(Random.FRandRange(-1.f, 1.f), Random.FRandRange(-1.f, 1.f), Random.FRandRange(-0.2f, 0.2f)).GetSafeNormal();
+	}
+
+	Settings = FDWallJumpCoreSettings();
+	Settings.MaxSequentialWallClings = 3;
+	Settings.MaxSequentialWallJumps = 3;
+	Settings.MinPitchSurfaceAngleCos = FMath::Cos(FMath::DegreesToRadians(80.f));
+	Settings.MaxPitchSurfaceAngleCos = FMath::Cos(FMath::DegreesToRadians(100.f));
+	Settings.MaxYawSurfaceAngleCos = FMath::Cos(FMath::DegreesToRadians(60.f));
+	Settings.MinSpeed = 200.f;
+
+	ExpectedResults.Reset();
+	ExpectedHash = 0;
+}
+
+void FDWallJumpHitStream::Record()
+{
+	ExpectedHash = FDWallJumpCore::Replay(Settings, Frames, ExpectedResults);
+}
+
+bool FDWallJumpHitStream::Save(const FString& FilePath) const
+{
+	if (ExpectedResults.Num() != Frames.Num())
+	{
+		UE_LOG(LogDWallJump, Warning, TEXT("The WallJump hit stream for %s has to be recorded before it is saved."), *FilePath);
+		return false;
+	}
+
+	if (FPaths::GetExtension(FilePath) == TEXT("txt"))
+	{
+		if (!FFileHelper::SaveStringToFile(ExportText(), *FilePath))
+		{
+			UE_LOG(LogDWallJump, Warning, TEXT("Failed to write the WallJump hit stream %s."), *FilePath);
+			return false;
+		}
+
+		return true;
+	}
+
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+	const_cast<FDWallJumpHitStream*>(this)->Serialize(Writer);
+
+	if (!FFileHelper::SaveArrayToFile(Data, *FilePath))
+	{
+		UE_LOG(LogDWallJump, Warning, TEXT("Failed to write the WallJump hit stream %s."), *FilePath);
+		return false;
+	}
+
+	return true;
+}
+
+bool FDWallJumpHitStream::Load(const FString& FilePath)
+{
+	bool bIsValid = false;
+
+	if (FPaths::GetExtension(FilePath) == TEXT("txt"))
+	{
+		TArray<FString> Lines;
+		if (!FFileHelper::LoadFileToStringArray(Lines, *FilePath))
+		{
+			UE_LOG(LogDWallJump, Warning, TEXT("There is no WallJump hit stream at %s."), *FilePath);
+			return false;
+		}
+
+		bIsValid = ImportText(Lines);
+	}
+	else
+	{
+		TArray<uint8> Data;
+		if (!FFileHelper::LoadFileToArray(Data, *FilePath, FILEREAD_Silent))
+		{
+			UE_LOG(LogDWallJump, Warning, TEXT("There is no WallJump hit stream at %s, record one with dignity.WallJump.RecordHitStream."), *FilePath);
+			return false;
+		}
+
+		FMemoryReader Reader(Data);
+		Serialize(Reader);
+		bIsValid = !Reader.IsError();
+	}
+
+	if (!bIsValid || ExpectedResults.Num() != Frames.Num())
+	{
+		UE_LOG(LogDWallJump, Warning, TEXT("%s is not an valid WallJump hit stream, record it again with dignity.WallJump.RecordHitStream."), *FilePath);
+		Frames.Empty();
+		ExpectedResults.Empty();
+		return false;
+	}
+
+	return true;
+}
+
+int32 FDWallJumpHitStream::Verify(TArray<FDWallJumpCoreStepResult>& OutResults) const
+{
+	const float Tolerance = KINDA_SMALL_NUMBER;
+
+	FDWallJumpCore::Replay(Settings, Frames, OutResults);
+
+	for (int32 Index = 0; Index < OutResults.Num(); Index++)
+	{
+		const FDWallJumpCoreStepResult& Expected = ExpectedResults[Index];
+		const FDWallJumpCoreStepResult& Actual = OutResults[Index];
+
+		if (Actual.Events != Expected.Events
+			|| !Actual.LaunchVelocity.Equals(Expected.LaunchVelocity, Tolerance * FMath::Max(Settings.WallJumpMagnitude, 1.f))
+			|| !FMath::IsNearlyEqual(Actual.PitchDot, Expected.PitchDot, Tolerance)
+			|| !FMath::IsNearlyEqual(Actual.YawCos, Expected.YawCos, Tolerance))
+		{
+			return Index;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+void FDWallJumpHitStream::Serialize(FArchive& Ar)
+{
+	uint32 Magic = DWALLJUMPHITSTREAM_MAGIC;
+	uint32 Version = DWALLJUMPHITSTREAM_VERSION;
+	Ar << Magic;
+	Ar << Version;
+
+	if (Magic != DWALLJUMPHITSTREAM_MAGIC || Version != DWALLJUMPHITSTREAM_VERSION)
+	{
+		Ar.SetError();
+		return;
+	}
+
+	Ar << Settings.bCanWallCling;
+	Ar << Settings.bCanWallJump;
+	Ar << Settings.bRequireClingToWallJump;
+	Ar << Settings.MaxSequentialWallClings;
+	Ar << Settings.MaxSequentialWallJumps;
+	Ar << Settings.ClingDuration;
+	Ar << Settings.WallJumpGracePeriodDuration;
+	Ar << Settings.WallJumpMagnitude;
+	Ar << Settings.ClingDamageReleaseThreshold;
+	Ar << Settings.MinPitchSurfaceAngleCos;
+	Ar << Settings.MaxPitchSurfaceAngleCos;
+	Ar << Settings.MaxYawSurfaceAngleCos;
+	Ar << Settings.MinSpeed;
+
+	int32 NumFrames = Frames.Num();
+	Ar << NumFrames;
+
+	// Each Frame is at least an few bytes, so an count larger than the file is an corrupt one rather than an allocation to attempt.
+	if (Ar.IsLoading())
+	{
+		if (NumFrames < 0 || NumFrames > Ar.TotalSize())
+		{
+			Ar.SetError();
+			return;
+		}
+
+		Frames.SetNum(NumFrames);
+		ExpectedResults.SetNum(NumFrames);
+	}
+
+	for (FDWallJumpCoreFrame& Frame : Frames)
+	{
+		Ar << Frame.Time;
+		Ar << Frame.bLanded;
+		Ar << Frame.Damage;
+		Ar << Frame.bJumpKeyDown;
+		Ar << Frame.bJumpJustPressed;
+		Ar << Frame.bIsFalling;
+		Ar << Frame.CharacterUp;
+		Ar << Frame.CharacterForward;
+		Ar << Frame.CharacterSpeed;
+		Ar << Frame.CameraDirection;
+		Ar << Frame.bHasHit;
+		Ar << Frame.HitNormal;
+	}
+
+	for (FDWallJumpCoreStepResult& Result : ExpectedResults)
+	{
+		Ar << Result.Events;
+		Ar << Result.LaunchVelocity;
+		Ar << Result.PitchDot;
+		Ar << Result.YawCos;
+	}
+
+	Ar << ExpectedHash;
+}
+
+/* The number of values on each line of an text stream, see ExportText(). */
+static const int32 NumTextSettingsValues = 13;
+static const int32 NumTextFrameValues = 26;
+
+static FString FormatTextFloat(float Value)
+{
+	// 9 significant digits is enough for every float to read back as the same float.
+	return FString::Printf(TEXT("%.9g"), Value);
+}
+
+static FString FormatTextVector(const FVector& Vector)
+{
+	return FormatTextFloat(Vector.X) + TEXT(" ") + FormatTextFloat(Vector.Y) + TEXT(" ") + FormatTextFloat(Vector.Z);
+}
+
+static FVector ParseTextVector(const TArray<FString>& Values, int32 Index)
+{
+	return FVector(FCString::Atof(*Values[Index]), FCString::Atof(*Values[Index + 1]), FCString::Atof(*Values[Index + 2]));
+}
+
+FString FDWallJumpHitStream::ExportText() const
+{
+	FString Text;
+
+	Text += TEXT("# FDWallJumpHitStream, see DWallJumpHitStream.h. Lines starting with # are ignored.\n");
+	Text += FString::Printf(TEXT("WJJS %u\n"), DWALLJUMPHITSTREAM_VERSION);
+
+	Text += TEXT("# bCanWallCling bCanWallJump bRequireClingToWallJump MaxSequentialWallClings MaxSequentialWallJumps ClingDuration WallJumpGracePeriodDuration WallJumpMagnitude ClingDamageReleaseThreshold MinPitchSurfaceAngleCos MaxPitchSurfaceAngleCos MaxYawSurfaceAngleCos MinSpeed\n");
+	Text += FString::Printf(TEXT("%d %d %d %d %d %s %s %s %s %s %s %s %s\n"),
+		Settings.bCanWallCling ? 1 : 0, Settings.bCanWallJump ? 1 : 0, Settings.bRequireClingToWallJump ? 1 : 0, Settings.MaxSequentialWallClings, Settings.MaxSequentialWallJumps,
+		*FormatTextFloat(Settings.ClingDuration), *FormatTextFloat(Settings.WallJumpGracePeriodDuration), *FormatTextFloat(Settings.WallJumpMagnitude), *FormatTextFloat(Settings.ClingDamageReleaseThreshold),
+		*FormatTextFloat(Settings.MinPitchSurfaceAngleCos), *FormatTextFloat(Settings.MaxPitchSurfaceAngleCos), *FormatTextFloat(Settings.MaxYawSurfaceAngleCos), *FormatTextFloat(Settings.MinSpeed));
+
+	Text += FString::Printf(TEXT("%d\n"), Frames.Num());
+
+	Text += TEXT("# Frame: Time bLanded Damage bJumpKeyDown bJumpJustPressed bIsFalling CharacterUp CharacterForward CharacterSpeed CameraDirection bHasHit HitNormal\n");
+	Text += TEXT("# Result: Events LaunchVelocity PitchDot YawCos\n");
+	for (int32 Index = 0; Index < Frames.Num(); Index++)
+	{
+		const FDWallJumpCoreFrame& Frame = Frames[Index];
+		const FDWallJumpCoreStepResult& Result = ExpectedResults[Index];
+
+		Text += FString::Printf(TEXT("%s %d %s %d %d %d %s %s %s %s %d %s  %u %s %s %s\n"),
+			*FormatTextFloat(Frame.Time), Frame.bLanded ? 1 : 0, *FormatTextFloat(Frame.Damage), Frame.bJumpKeyDown ? 1 : 0, Frame.bJumpJustPressed ? 1 : 0, Frame.bIsFalling ? 1 : 0,
+			*FormatTextVector(Frame.CharacterUp), *FormatTextVector(Frame.CharacterForward), *FormatTextFloat(Frame.CharacterSpeed), *FormatTextVector(Frame.CameraDirection),
+			Frame.bHasHit ? 1 : 0, *FormatTextVector(Frame.HitNormal),
+			Result.Events, *FormatTextVector(Result.LaunchVelocity), *FormatTextFloat(Result.PitchDot), *FormatTextFloat(Result.YawCos));
+	}
+
+	Text += FString::Printf(TEXT("%08x\n"), ExpectedHash);
+
+	return Text;
+}
+
+bool FDWallJumpHitStream::ImportText(const TArray<FString>& Lines)
+{
+	TArray<FString> DataLines;
+	for (const FString& Line : Lines)
+	{
+		FString TrimmedLine = Line.TrimStartAndEnd();
+		if (!TrimmedLine.IsEmpty() && !TrimmedLine.StartsWith(TEXT("#")))
+		{
+			DataLines.Add(MoveTemp(TrimmedLine));
+		}
+	}
+
+	// The header, Settings, Frame count and hash lines around the Frames.
+	if (DataLines.Num() < 4)
+	{
+		return false;
+	}
+
+	TArray<FString> Values;
+	DataLines[0].ParseIntoArrayWS(Values);
+	if (Values.Num() != 2 || Values[0] != TEXT("WJJS") || FCString::Atoi(*Values[1]) != DWALLJUMPHITSTREAM_VERSION)
+	{
+		return false;
+	}
+
+	DataLines[1].ParseIntoArrayWS(Values);
+	if (Values.Num() != NumTextSettingsValues)
+	{
+		return false;
+	}
+
+	Settings = FDWallJumpCoreSettings();
+	Settings.bCanWallCling = FCString::Atoi(*Values[0]) != 0;
+	Settings.bCanWallJump = FCString::Atoi(*Values[1]) != 0;
+	Settings.bRequireClingToWallJump = FCString::Atoi(*Values[2]) != 0;
+	Settings.MaxSequentialWallClings = FCString::Atoi(*Values[3]);
+	Settings.MaxSequentialWallJumps = FCString::Atoi(*Values[4]);
+	Settings.ClingDuration = FCString::Atof(*Values[5]);
+	Settings.WallJumpGracePeriodDuration = FCString::Atof(*Values[6]);
+	Settings.WallJumpMagnitude = FCString::Atof(*Values[7]);
+	Settings.ClingDamageReleaseThreshold = FCString::Atof(*Values[8]);
+	Settings.MinPitchSurfaceAngleCos = FCString::Atof(*Values[9]);
+	Settings.MaxPitchSurfaceAngleCos = FCString::Atof(*Values[10]);
+	Settings.MaxYawSurfaceAngleCos = FCString::Atof(*Values[11]);
+	Settings.MinSpeed = FCString::Atof(*Values[12]);
+
+	const int32 NumFrames = FCString::Atoi(*DataLines[2]);
+	if (NumFrames < 0 || DataLines.Num() != NumFrames + 4)
+	{
+		return false;
+	}
+
+	Frames.SetNum(NumFrames);
+	ExpectedResults.SetNum(NumFrames);
+
+	for (int32 Index = 0; Index < NumFrames; Index++)
+	{
+		DataLines[Index + 3].ParseIntoArrayWS(Values);
+		if (Values.Num() != NumTextFrameValues)
+		{
+			return false;
+		}
+
+		FDWallJumpCoreFrame& Frame = Frames[Index];
+		Frame.Time = FCString::Atof(*Values[0]);
+		Frame.bLanded = FCString::Atoi(*Values[1]) != 0;
+		Frame.Damage = FCString::Atof(*Values[2]);
+		Frame.bJumpKeyDown = FCString::Atoi(*Values[3]) != 0;
+		Frame.bJumpJustPressed = FCString::Atoi(*Values[4]) != 0;
+		Frame.bIsFalling = FCString::Atoi(*Values[5]) != 0;
+		Frame.CharacterUp = ParseTextVector(Values, 6);
+		Frame.CharacterForward = ParseTextVector(Values, 9);
+		Frame.CharacterSpeed = FCString::Atof(*Values[12]);
+		Frame.CameraDirection = ParseTextVector(Values, 13);
+		Frame.bHasHit = FCString::Atoi(*Values[16]) != 0;
+		Frame.HitNormal = ParseTextVector(Values, 17);
+
+		FDWallJumpCoreStepResult& Result = ExpectedResults[Index];
+		Result.Events = (uint8)FCString::Atoi(*Values[20]);
+		Result.LaunchVelocity = ParseTextVector(Values, 21);
+		Result.PitchDot = FCString::Atof(*Values[24]);
+		Result.YawCos = FCString::Atof(*Values[25]);
+	}
+
+	ExpectedHash = FCString::Strtoui64(*DataLines.Last(), nullptr, 16);
+
+	return true;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DWallJumpCore.h"
+
+/**
+ * An recorded feed of FDWallJumpCoreFrame, the Settings it was played with and what FDWallJumpCore decided for every Frame.
+ * Replaying it through the core and comparing the results catches any change to the core that changes its decisions, without an running game.
+ *
+ * The file is the magic and version, the Settings, the Frames and then one FDWallJumpCoreStepResult per Frame followed by their hash.
+ * Every field is serialized on its own so the file doesnt depend on the padding or layout of the structs.
+ *
+ * Streams saved to an .txt file are written as text instead, one line per Frame with the result the core has to produce for it.
+ * The golden stream kept next to the sources is one, so any change to what the core decides shows up line by line when it is recorded again.
+ */
+
+#define DWALLJUMPHITSTREAM_MAGIC 0x534A4A57 // WJJS
+#define DWALLJUMPHITSTREAM_VERSION 2
+
+struct DIGNITY_API FDWallJumpHitStream
+{
+	FDWallJumpCoreSettings Settings;
+
+	TArray<FDWallJumpCoreFrame> Frames;
+
+	/* What the core decided for each Frame when the stream was recorded. */
+	TArray<FDWallJumpCoreStepResult> ExpectedResults;
+
+	/* The hash FDWallJumpCore::Replay() returned when the stream was recorded. */
+	uint32 ExpectedHash;
+
+	FDWallJumpHitStream();
+
+	/* Where streams are recorded to, Saved/WallJump/<Name>.wjstream. */
+	static FString GetFilePath(const FString& Name);
+
+	/* The golden stream checked in next to the sources, what dignity.WallJump.ReplayHitStream replays unless it is given an Name. */
+	static FString GetGoldenFilePath();
+
+	/**
+	 * Fills the Frames with an random feed of Falling, Hits, Jump input and Landing, the same feed for the same Seed.
+	 * The Settings are set to the ClingAndJump archetype with Cling angles that accept roughly half of the Hits.
+	 */
+	void GenerateRandom(int32 NumFrames, int32 Seed);
+
+	/* Replays the Frames and keeps the results as the ExpectedResults. */
+	void Record();
+
+	bool Save(const FString& FilePath) const;
+
+	bool Load(const FString& FilePath);
+
+	/**
+	 * Replays the Frames and compares the results against the ExpectedResults.
+	 * The Events have to match exactly, the velocities and Cosines within an small tolerance so an different compiler doesnt count as an drift.
+	 *
+	 * @param	OutResults	The results of the replay.
+	 * @return	The first Frame whose result differs, INDEX_NONE if they all match.
+	 */
+	int32 Verify(TArray<FDWallJumpCoreStepResult>& OutResults) const;
+
+	void Serialize(FArchive& Ar);
+
+private:
+
+	/* The text form of the stream, see Save(). */
+	FString ExportText() const;
+	bool ImportText(const TArray<FString>& Lines);
+};
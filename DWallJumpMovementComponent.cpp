@@ -0,0 +1,537 @@
+#include "Dignity.h"
+#include "DWallJumpMovementComponent.h"
+#include "DWallJumpComponent.h"
+#include "DWallJumpStats.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/PlayerController.h"
+#include "Containers/Ticker.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+#if !UE_BUILD_SHIPPING && DIGNITY_DEVELOPMENT
+/**
+ * Plays the local Client with simulated packet lag and counts the Server corrections that follow its WallClings and WallJumps.
+ * The Server approves each of them for the move the Client sent it with, so however late the packet and the move arrive neither should ever be corrected.
+ */
+class FDWallJumpCorrectionTest
+{
+public:
+
+	static FDWallJumpCorrectionTest& Get()
+	{
+		static FDWallJumpCorrectionTest Test;
+		return Test;
+	}
+
+	void Start(UWorld* World, int32 LagMilliseconds, float Seconds)
+	{
+		Stop();
+
+		APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+		ACharacter* Character = PlayerController ? PlayerController->GetCharacter() : nullptr;
+		UDWallJumpMovementComponent* WallJumpMovement = Character ? Cast<UDWallJumpMovementComponent>(Character->GetCharacterMovement()) : nullptr;
+		UDWallJumpComponent* WallJumpComponentPtr = Character ? Character->FindComponentByClass<UDWallJumpComponent>() : nullptr;
+
+		if (!Character || Character->Role != ROLE_AutonomousProxy || !WallJumpMovement || !WallJumpComponentPtr)
+		{
+			UE_LOG(LogDWallJump, Warning, TEXT("CorrectionTest has to be run on an Client whose Character has an WJC and an UDWallJumpMovementComponent."));
+			return;
+		}
+
+		TestWorld = World;
+		Movement = WallJumpMovement;
+		WallJumpComponent = WallJumpComponentPtr;
+
+		// The Server replies to an move no sooner than the round trip, give its correction that long and an few frames to arrive.
+		LagSeconds = LagMilliseconds / 1000.0;
+		SettleSeconds = LagSeconds * 2.0 + 0.1;
+		EndTime = FPlatformTime::Seconds() + Seconds;
+
+		bHasPendingWallMove = false;
+		NumWallMoves = 0;
+		NumCorrectedWallMoves = 0;
+		StartCorrections = Movement->GetNumClientCorrections();
+
+		GEngine->Exec(World, *FString::Printf(TEXT("Net PktLag=%d"), LagMilliseconds));
+
+		EventHandle = WallJumpComponentPtr->OnWallJumpEvent().AddRaw(this, &FDWallJumpCorrectionTest::OnWallJumpEvent);
+		TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FDWallJumpCorrectionTest::Tick));
+
+		UE_LOG(LogDWallJump, Log, TEXT("CorrectionTest: started with %d ms of packet lag for %.0f seconds, Cling and Jump away."), LagMilliseconds, Seconds);
+	}
+
+private:
+
+	TWeakObjectPtr<UWorld> TestWorld;
+	TWeakObjectPtr<UDWallJumpMovementComponent> Movement;
+	TWeakObjectPtr<UDWallJumpComponent> WallJumpComponent;
+
+	FDelegateHandle EventHandle;
+	FDelegateHandle TickerHandle;
+
+	double LagSeconds;
+	double SettleSeconds;
+	double EndTime;
+
+	/* The last Cling or Jump, waiting SettleSeconds to see if it is corrected. */
+	bool bHasPendingWallMove;
+	EDWallJumpEventType PendingWallMoveType;
+	double PendingWallMoveTime;
+	int32 PendingWallMoveCorrections;
+
+	int32 NumWallMoves;
+	int32 NumCorrectedWallMoves;
+	int32 StartCorrections;
+
+	FDWallJumpCorrectionTest()
+		: bHasPendingWallMove(false)
+	{
+	}
+
+	void OnWallJumpEvent(const FDWallJumpEvent& Event)
+	{
+		if (Event.Type != EDWallJumpEventType::Clung && Event.Type != EDWallJumpEventType::Jumped)
+		{
+			return;
+		}
+
+		// An Jump from an Cling follows it closely, whatever was corrected until now is put down to the Cling.
+		SettleWallMove();
+
+		bHasPendingWallMove = true;
+		PendingWallMoveType = Event.Type;
+		PendingWallMoveTime = FPlatformTime::Seconds();
+		PendingWallMoveCorrections = Movement.IsValid() ? Movement->GetNumClientCorrections() : 0;
+		NumWallMoves++;
+	}
+
+	void SettleWallMove()
+	{
+		if (!bHasPendingWallMove || !Movement.IsValid())
+		{
+			return;
+		}
+
+		bHasPendingWallMove = false;
+
+		const int32 NumCorrections = Movement->GetNumClientCorrections() - PendingWallMoveCorrections;
+		if (NumCorrections > 0)
+		{
+			NumCorrectedWallMoves++;
+			UE_LOG(LogDWallJump, Error, TEXT("CorrectionTest: an %s was corrected %d times within %.0f ms."),
+				PendingWallMoveType == EDWallJumpEventType::Clung ? TEXT("Cling") : TEXT("Jump"), NumCorrections, (FPlatformTime::Seconds() - PendingWallMoveTime) * 1000.0);
+		}
+	}
+
+	bool Tick(float DeltaTime)
+	{
+		if (!TestWorld.IsValid() || !Movement.IsValid() || !WallJumpComponent.IsValid())
+		{
+			UE_LOG(LogDWallJump, Warning, TEXT("CorrectionTest: the Character went away, stopping."));
+			Finish();
+			return false;
+		}
+
+		const double Now = FPlatformTime::Seconds();
+		if (bHasPendingWallMove && Now - PendingWallMoveTime >= SettleSeconds)
+		{
+			SettleWallMove();
+		}
+
+		if (Now >= EndTime && !bHasPendingWallMove)
+		{
+			Finish();
+			return false;
+		}
+
+		return true;
+	}
+
+	/* Stops an running test from outside its Tick. */
+	void Stop()
+	{
+		if (TickerHandle.IsValid())
+		{
+			FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+			Finish();
+		}
+	}
+
+	void Finish()
+	{
+		TickerHandle.Reset();
+
+		if (UDWallJumpComponent* WallJumpComponentPtr = WallJumpComponent.Get())
+		{
+			WallJumpComponentPtr->OnWallJumpEvent().Remove(EventHandle);
+		}
+		EventHandle.Reset();
+
+		if (UWorld* World = TestWorld.Get())
+		{
+			GEngine->Exec(World, TEXT("Net PktLag=0"));
+		}
+
+		SettleWallMove();
+
+		const int32 NumCorrections = Movement.IsValid() ? Movement->GetNumClientCorrections() - StartCorrections : 0;
+		if (NumWallMoves == 0)
+		{
+			UE_LOG(LogDWallJump, Warning, TEXT("CorrectionTest: no Clings or Jumps were performed, nothing was tested."));
+		}
+		else if (NumCorrectedWallMoves > 0)
+		{
+			UE_LOG(LogDWallJump, Error, TEXT("CorrectionTest: FAILED, %d of %d Clings and Jumps were corrected at %.0f ms of lag. %d corrections in total."),
+				NumCorrectedWallMoves, NumWallMoves, LagSeconds * 1000.0, NumCorrections);
+		}
+		else
+		{
+			UE_LOG(LogDWallJump, Log, TEXT("CorrectionTest: passed, none of %d Clings and Jumps were corrected at %.0f ms of lag. %d corrections in total."),
+				NumWallMoves, LagSeconds * 1000.0, NumCorrections);
+		}
+
+		Movement.Reset();
+		WallJumpComponent.Reset();
+		TestWorld.Reset();
+	}
+};
+
+static FAutoConsoleCommandWithWorldAndArgs CmdWallJumpCorrectionTest(
+	TEXT("dignity.WallJump.CorrectionTest"),
+	TEXT("Run on an Client. Adds packet lag, default 200 ms, for an number of seconds, default 30, and logs an Error for every WallCling or WallJump the Server corrects. Usage: dignity.WallJump.CorrectionTest [LagMs] [Seconds]."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 LagMilliseconds = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 0) : 200;
+		const float Seconds = Args.Num() > 1 ? FMath::Max(FCString::Atof(*Args[1]), 1.f) : 30.f;
+
+		FDWallJumpCorrectionTest::Get().Start(World, LagMilliseconds, Seconds);
+	}));
+#endif //!UE_BUILD_SHIPPING && DIGNITY_DEVELOPMENT
+
+UDWallJumpMovementComponent::UDWallJumpMovementComponent()
+{
+	bWantsToWallCling = false;
+	bWantsToReleaseWallCling = false;
+	bWantsToWallJump = false;
+	bIsApplyingCorrection = false;
+	ServerWallClingApprovedTimestamp = 0.f;
+	ServerWallJumpApprovedTimestamp = 0.f;
+	CurrentClientMoveTimestamp = 0.f;
+	LastClientMoveTimestamp = 0.f;
+	PendingWallJumpVelocity = FVector::ZeroVector;
+	NumClientCorrections = 0;
+}
+
+void UDWallJumpMovementComponent::UpdateFromCompressedFlags(uint8 Flags)
+{
+	Super::UpdateFromCompressedFlags(Flags);
+
+	bWantsToWallCling = (Flags & FSavedMove_Character::FLAG_Custom_0) != 0;
+	bWantsToReleaseWallCling = (Flags & FSavedMove_Character::FLAG_Custom_1) != 0;
+	bWantsToWallJump = (Flags & FSavedMove_Character::FLAG_Custom_2) != 0;
+}
+
+FNetworkPredictionData_Client* UDWallJumpMovementComponent::GetPredictionData_Client() const
+{
+	check(PawnOwner != nullptr);
+
+	if (!ClientPredictionData)
+	{
+		UDWallJumpMovementComponent* MutableThis = const_cast<UDWallJumpMovementComponent*>(this);
+		MutableThis->ClientPredictionData = new FNetworkPredictionData_Client_DWallJump(*this);
+	}
+
+	return ClientPredictionData;
+}
+
+void UDWallJumpMovementComponent::ClientAdjustPosition_Implementation(float TimeStamp, FVector NewLoc, FVector NewVel, UPrimitiveComponent* NewBase, FName NewBaseBoneName, bool bHasBase, bool bBaseRelativePosition, uint8 ServerMovementMode)
+{
+	NumClientCorrections++;
+
+	bIsApplyingCorrection = true;
+	Super::ClientAdjustPosition_Implementation(TimeStamp, NewLoc, NewVel, NewBase, NewBaseBoneName, bHasBase, bBaseRelativePosition, ServerMovementMode);
+	bIsApplyingCorrection = false;
+}
+
+bool UDWallJumpMovementComponent::ClientUpdatePositionAfterServerUpdate()
+{
+	const bool bResult = Super::ClientUpdatePositionAfterServerUpdate();
+
+	// Only once the saved moves have been replayed do we know if the correction really took us out of the Cling.
+	if (!IsWallClinging())
+	{
+		NotifyWallClingModeLeft();
+	}
+
+	return bResult;
+}
+
+void UDWallJumpMovementComponent::SetWallJumpComponent(UDWallJumpComponent* InWallJumpComponent)
+{
+	WallJumpComponent = InWallJumpComponent;
+}
+
+void UDWallJumpMovementComponent::NotifyWallClingModeLeft()
+{
+	if (UDWallJumpComponent* WallJumpComponentPtr = WallJumpComponent.Get())
+	{
+		WallJumpComponentPtr->OnWallClingMovementModeLeft();
+	}
+}
+
+void UDWallJumpMovementComponent::FlushWallMoveForClientMove(float ClientMoveTimestamp)
+{
+	if (UDWallJumpComponent* WallJumpComponentPtr = WallJumpComponent.Get())
+	{
+		WallJumpComponentPtr->FlushWallMove(ClientMoveTimestamp);
+	}
+}
+
+void UDWallJumpMovementComponent::RequestWallCling(float ClientMoveTimestamp /*= 0.f*/)
+{
+	if (IsMoveLocal())
+	{
+		bWantsToWallCling = true;
+		bWantsToReleaseWallCling = false;
+	}
+	else
+	{
+		ServerWallClingApprovedTimestamp = ClientMoveTimestamp;
+	}
+}
+
+void UDWallJumpMovementComponent::RequestWallClingRelease()
+{
+	if (IsMoveLocal())
+	{
+		bWantsToReleaseWallCling = true;
+		bWantsToWallCling = false;
+	}
+	else if (IsWallClinging())
+	{
+		SetMovementMode(MOVE_Falling);
+	}
+}
+
+void UDWallJumpMovementComponent::RequestWallJump(const FVector& LaunchVelocity, float ClientMoveTimestamp /*= 0.f*/)
+{
+	PendingWallJumpVelocity = LaunchVelocity;
+
+	if (IsMoveLocal())
+	{
+		bWantsToWallJump = true;
+	}
+	else
+	{
+		ServerWallJumpApprovedTimestamp = ClientMoveTimestamp;
+	}
+}
+
+bool UDWallJumpMovementComponent::HasClientMovePassed(float ClientMoveTimestamp) const
+{
+	// The Clients TimeStamps are reset every MinTimeBetweenTimeStampResets, one that far behind the last move is from after an reset.
+	return ClientMoveTimestamp <= LastClientMoveTimestamp && LastClientMoveTimestamp - ClientMoveTimestamp < MinTimeBetweenTimeStampResets * 0.5f;
+}
+
+bool UDWallJumpMovementComponent::ConsumeServerApproval(float& ApprovedTimestamp, bool& bOutPassed)
+{
+	bOutPassed = false;
+
+	if (ApprovedTimestamp <= 0.f)
+	{
+		return false;
+	}
+
+	// The move it is for may still be on its way, batched behind this one in an ServerMoveDual for example. Unless it is that far ahead because the TimeStamps were reset since.
+	const bool bIsFromBeforeReset = ApprovedTimestamp - CurrentClientMoveTimestamp >= MinTimeBetweenTimeStampResets * 0.5f;
+	if (CurrentClientMoveTimestamp < ApprovedTimestamp && !bIsFromBeforeReset)
+	{
+		return false;
+	}
+
+	const bool bIsForThisMove = CurrentClientMoveTimestamp == ApprovedTimestamp;
+	bOutPassed = !bIsForThisMove;
+	ApprovedTimestamp = 0.f;
+	return bIsForThisMove;
+}
+
+bool UDWallJumpMovementComponent::IsWallClinging() const
+{
+	return MovementMode == MOVE_Custom && CustomMovementMode == (uint8)EDWallJumpCustomMovementMode::CMOVE_WallCling;
+}
+
+bool UDWallJumpMovementComponent::IsMoveLocal() const
+{
+	return CharacterOwner && (CharacterOwner->Role != ROLE_Authority || CharacterOwner->IsLocallyControlled());
+}
+
+void UDWallJumpMovementComponent::UpdateCharacterStateBeforeMovement(float DeltaSeconds)
+{
+	Super::UpdateCharacterStateBeforeMovement(DeltaSeconds);
+
+	// An remote Clients requests only count on the move the WJC validated them for, if it hasnt we carry on without them and the Client gets corrected.
+	const bool bIsMoveLocal = IsMoveLocal();
+	bool bIsWallJumpApproved = bIsMoveLocal;
+	bool bIsWallClingApproved = bIsMoveLocal;
+	bool bWallClingApprovalPassed = false;
+
+	if (!bIsMoveLocal)
+	{
+		bool bWallJumpApprovalPassed = false;
+		bIsWallJumpApproved = ConsumeServerApproval(ServerWallJumpApprovedTimestamp, bWallJumpApprovalPassed);
+		bIsWallClingApproved = ConsumeServerApproval(ServerWallClingApprovedTimestamp, bWallClingApprovalPassed);
+	}
+
+	if (bWantsToReleaseWallCling && IsWallClinging())
+	{
+		SetMovementMode(MOVE_Falling);
+	}
+
+	if (bWantsToWallJump && bIsWallJumpApproved)
+	{
+		// The same as LaunchCharacter() overriding both the XY and Z velocity.
+		Velocity = PendingWallJumpVelocity;
+		SetMovementMode(MOVE_Falling);
+	}
+
+	if (bWantsToWallCling && bIsWallClingApproved && MovementMode == MOVE_Falling)
+	{
+		Velocity = FVector::ZeroVector;
+		SetMovementMode(MOVE_Custom, (uint8)EDWallJumpCustomMovementMode::CMOVE_WallCling);
+	}
+
+	// The WJC Clung when it validated the packet, if the move it was for went by without entering the Cling mode it has to let go again.
+	if (bWallClingApprovalPassed && !IsWallClinging())
+	{
+		NotifyWallClingModeLeft();
+	}
+
+	bWantsToWallCling = false;
+	bWantsToReleaseWallCling = false;
+	bWantsToWallJump = false;
+}
+
+void UDWallJumpMovementComponent::MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAccel)
+{
+	CurrentClientMoveTimestamp = ClientTimeStamp;
+
+	Super::MoveAutonomous(ClientTimeStamp, DeltaTime, CompressedFlags, NewAccel);
+
+	LastClientMoveTimestamp = ClientTimeStamp;
+}
+
+void UDWallJumpMovementComponent::OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode)
+{
+	Super::OnMovementModeChanged(PreviousMovementMode, PreviousCustomMode);
+
+	const bool bWasWallClinging = PreviousMovementMode == MOVE_Custom && PreviousCustomMode == (uint8)EDWallJumpCustomMovementMode::CMOVE_WallCling;
+
+	// Corrections and their replays are settled in ClientUpdatePositionAfterServerUpdate() instead.
+	if (bWasWallClinging && !IsWallClinging() && !bClientUpdating && !bIsApplyingCorrection)
+	{
+		NotifyWallClingModeLeft();
+	}
+}
+
+void UDWallJumpMovementComponent::PhysCustom(float DeltaTime, int32 Iterations)
+{
+	if (CustomMovementMode == (uint8)EDWallJumpCustomMovementMode::CMOVE_WallCling)
+	{
+		// Held in place against the wall without gravity until we are released.
+		Velocity = FVector::ZeroVector;
+		return;
+	}
+
+	Super::PhysCustom(DeltaTime, Iterations);
+}
+
+void FSavedMove_DWallJump::Clear()
+{
+	Super::Clear();
+
+	bSavedWantsToWallCling = false;
+	bSavedWantsToReleaseWallCling = false;
+	bSavedWantsToWallJump = false;
+	SavedWallJumpVelocity = FVector::ZeroVector;
+}
+
+uint8 FSavedMove_DWallJump::GetCompressedFlags() const
+{
+	uint8 Result = Super::GetCompressedFlags();
+
+	if (bSavedWantsToWallCling)
+	{
+		Result |= FLAG_Custom_0;
+	}
+
+	if (bSavedWantsToReleaseWallCling)
+	{
+		Result |= FLAG_Custom_1;
+	}
+
+	if (bSavedWantsToWallJump)
+	{
+		Result |= FLAG_Custom_2;
+	}
+
+	return Result;
+}
+
+bool FSavedMove_DWallJump::CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const
+{
+	// The requests are one shot, combining an move that has one with another would apply it at the wrong time.
+	const FSavedMove_DWallJump* NewWallJumpMove = static_cast<const FSavedMove_DWallJump*>(NewMove.Get());
+	if (bSavedWantsToWallCling || bSavedWantsToReleaseWallCling || bSavedWantsToWallJump
+		|| NewWallJumpMove->bSavedWantsToWallCling || NewWallJumpMove->bSavedWantsToReleaseWallCling || NewWallJumpMove->bSavedWantsToWallJump)
+	{
+		return false;
+	}
+
+	return Super::CanCombineWith(NewMove, InCharacter, MaxDelta);
+}
+
+void FSavedMove_DWallJump::SetMoveFor(ACharacter* Character, float InDeltaTime, FVector const& NewAccel, class FNetworkPredictionData_Client_Character& ClientData)
+{
+	Super::SetMoveFor(Character, InDeltaTime, NewAccel, ClientData);
+
+	UDWallJumpMovementComponent* WallJumpMovement = Cast<UDWallJumpMovementComponent>(Character->GetCharacterMovement());
+	if (WallJumpMovement)
+	{
+		bSavedWantsToWallCling = WallJumpMovement->bWantsToWallCling;
+		bSavedWantsToReleaseWallCling = WallJumpMovement->bWantsToReleaseWallCling;
+		bSavedWantsToWallJump = WallJumpMovement->bWantsToWallJump;
+		SavedWallJumpVelocity = WallJumpMovement->PendingWallJumpVelocity;
+
+		// The Server has to have validated the WJCs packet by the time this move arrives, it goes out first on the same channel stamped with our TimeStamp.
+		if (bSavedWantsToWallCling || bSavedWantsToWallJump)
+		{
+			WallJumpMovement->FlushWallMoveForClientMove(TimeStamp);
+		}
+	}
+}
+
+void FSavedMove_DWallJump::PrepMoveFor(ACharacter* Character)
+{
+	Super::PrepMoveFor(Character);
+
+	// Restore the requests so they are applied again when this move is replayed after an correction.
+	UDWallJumpMovementComponent* WallJumpMovement = Cast<UDWallJumpMovementComponent>(Character->GetCharacterMovement());
+	if (WallJumpMovement)
+	{
+		WallJumpMovement->bWantsToWallCling = bSavedWantsToWallCling;
+		WallJumpMovement->bWantsToReleaseWallCling = bSavedWantsToReleaseWallCling;
+		WallJumpMovement->bWantsToWallJump = bSavedWantsToWallJump;
+		WallJumpMovement->PendingWallJumpVelocity = SavedWallJumpVelocity;
+	}
+}
+
+FNetworkPredictionData_Client_DWallJump::FNetworkPredictionData_Client_DWallJump(const UCharacterMovementComponent& ClientMovement)
+	: Super(ClientMovement)
+{
+}
+
+FSavedMovePtr FNetworkPredictionData_Client_DWallJump::AllocateNewMove()
+{
+	return FSavedMovePtr(new FSavedMove_DWallJump());
+}
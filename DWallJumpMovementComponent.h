@@ -0,0 +1,173 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "DWallJumpMovementComponent.generated.h"
+
+class UDWallJumpComponent;
+
+/* The Custom movement modes added by the UDWallJumpMovementComponent, used as the CustomMovementMode while in MOVE_Custom. */
+UENUM(BlueprintType)
+enum class EDWallJumpCustomMovementMode : uint8
+{
+	CMOVE_None		UMETA(Hidden),
+	CMOVE_WallCling	UMETA(DisplayName = "Wall Cling")
+};
+
+/**
+ * CharacterMovementComponent that predicts WallClings and WallJumps for the UDWallJumpComponent.
+ *
+ * Clinging, releasing and jumping are requested by the WJC and applied at the start of the next move, they are recorded in the Saved Moves as Compressed Flags
+ * so they are replayed on Client corrections and applied by the Server at the same point in the move timeline.
+ * The Client sends the WJCs FDWallJumpMovePacket just before the move that carries its flags, stamped with that moves TimeStamp.
+ * The Server only applies an Clients request to the move the WJC validated the matching FDWallJumpMovePacket for, otherwise it corrects the Client.
+ */
+UCLASS(ClassGroup = ("Dignity"))
+class DIGNITY_API UDWallJumpMovementComponent : public UCharacterMovementComponent
+{
+	GENERATED_BODY()
+
+	friend class FSavedMove_DWallJump;
+
+public:
+
+	UDWallJumpMovementComponent();
+
+	virtual void UpdateFromCompressedFlags(uint8 Flags) override;
+
+	virtual class FNetworkPredictionData_Client* GetPredictionData_Client() const override;
+
+	virtual void ClientAdjustPosition_Implementation(float TimeStamp, FVector NewLoc, FVector NewVel, UPrimitiveComponent* NewBase, FName NewBaseBoneName, bool bHasBase, bool bBaseRelativePosition, uint8 ServerMovementMode) override;
+
+	virtual bool ClientUpdatePositionAfterServerUpdate() override;
+
+	/* The WJC told when the Character leaves the Cling movement mode, set by the WJC itself. */
+	void SetWallJumpComponent(UDWallJumpComponent* InWallJumpComponent);
+
+	/**
+	 * Puts the Character into the WallCling movement mode on its next move. On the Server for an remote Client this approves the Clients predicted Cling instead.
+	 *
+	 * @param	ClientMoveTimestamp	On the Server, the TimeStamp of the Clients move the Cling is approved for.
+	 */
+	void RequestWallCling(float ClientMoveTimestamp = 0.f);
+
+	/* Returns the Character to Falling from the WallCling movement mode. On the Server this is applied immediately as the Server is authoritative over releases. */
+	void RequestWallClingRelease();
+
+	/**
+	 * Launches the Character with the LaunchVelocity on its next move. On the Server for an remote Client this approves the Clients predicted Jump instead.
+	 *
+	 * @param	LaunchVelocity			The Velocity to Launch the Character with.
+	 * @param	ClientMoveTimestamp		On the Server, the TimeStamp of the Clients move the Jump is approved for.
+	 */
+	void RequestWallJump(const FVector& LaunchVelocity, float ClientMoveTimestamp = 0.f);
+
+	/* Server only, true once the remote Clients move with this TimeStamp has been performed, an approval for it would never be used. */
+	bool HasClientMovePassed(float ClientMoveTimestamp) const;
+
+	/* True if the Character is in the WallCling movement mode. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Wall Cling")
+	bool IsWallClinging() const;
+
+	/* How many times the Server has corrected this Client, useful for measuring how well WallClings and WallJumps are predicted. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Wall Cling")
+	FORCEINLINE int32 GetNumClientCorrections() const { return NumClientCorrections; }
+
+protected:
+
+	virtual void UpdateCharacterStateBeforeMovement(float DeltaSeconds) override;
+
+	virtual void MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAccel) override;
+
+	virtual void PhysCustom(float DeltaTime, int32 Iterations) override;
+
+	virtual void OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode) override;
+
+private:
+
+	/* Set when the Character wants to enter the WallCling movement mode on its next move. */
+	uint8 bWantsToWallCling : 1;
+
+	/* Set when the Character wants to leave the WallCling movement mode on its next move. */
+	uint8 bWantsToReleaseWallCling : 1;
+
+	/* Set when the Character wants to WallJump on its next move. */
+	uint8 bWantsToWallJump : 1;
+
+	/* Client only, set while an correction from the Server is applied. The Cling mode it leaves may be entered again when the saved moves are replayed. */
+	uint8 bIsApplyingCorrection : 1;
+
+	/**
+	 * Server only, the TimeStamp of the remote Clients move the WJC validated an Cling for, 0 if there is none.
+	 * Moves can arrive batched and after unflagged ones, so the approval is kept until the move it is for, or any later one, is performed.
+	 */
+	float ServerWallClingApprovedTimestamp;
+
+	/* Server only, the TimeStamp of the remote Clients move the WJC validated an Jump for, 0 if there is none. */
+	float ServerWallJumpApprovedTimestamp;
+
+	/* Server only, the TimeStamp of the remote Clients move being performed, set by MoveAutonomous(). */
+	float CurrentClientMoveTimestamp;
+
+	/* Server only, the TimeStamp of the last remote Client move that was performed. */
+	float LastClientMoveTimestamp;
+
+	/**
+	 * Server only, true if the approval for the move with ApprovedTimestamp applies to the current move. Clears the approval once the current move is that one or any later one.
+	 *
+	 * @param	bOutPassed	Set if the approval was cleared without the move it was for being performed.
+	 */
+	bool ConsumeServerApproval(float& ApprovedTimestamp, bool& bOutPassed);
+
+	TWeakObjectPtr<UDWallJumpComponent> WallJumpComponent;
+
+	/* Sends the WJCs pending FDWallJumpMovePacket for the Client move with this TimeStamp, called as the move is saved and before it is sent. */
+	void FlushWallMoveForClientMove(float ClientMoveTimestamp);
+
+	/* Tells the WallJumpComponent that the Character is no longer in the Cling movement mode. */
+	void NotifyWallClingModeLeft();
+
+	/* The Velocity to Launch the Character with when bWantsToWallJump is applied. */
+	FVector PendingWallJumpVelocity;
+
+	/* How many times the Server has corrected this Client. */
+	int32 NumClientCorrections;
+
+	/* True if the moves for this Character are generated on this machine rather than received from an remote Client. */
+	bool IsMoveLocal() const;
+};
+
+/* Saved Move that records the WallCling and WallJump requests so they can be sent to the Server and replayed on corrections. */
+class DIGNITY_API FSavedMove_DWallJump : public FSavedMove_Character
+{
+public:
+
+	typedef FSavedMove_Character Super;
+
+	uint8 bSavedWantsToWallCling : 1;
+	uint8 bSavedWantsToReleaseWallCling : 1;
+	uint8 bSavedWantsToWallJump : 1;
+	FVector SavedWallJumpVelocity;
+
+	virtual void Clear() override;
+
+	virtual uint8 GetCompressedFlags() const override;
+
+	virtual bool CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const override;
+
+	virtual void SetMoveFor(ACharacter* Character, float InDeltaTime, FVector const& NewAccel, class FNetworkPredictionData_Client_Character& ClientData) override;
+
+	virtual void PrepMoveFor(ACharacter* Character) override;
+};
+
+/* Client Prediction Data that allocates FSavedMove_DWallJump. */
+class DIGNITY_API FNetworkPredictionData_Client_DWallJump : public FNetworkPredictionData_Client_Character
+{
+public:
+
+	typedef FNetworkPredictionData_Client_Character Super;
+
+	FNetworkPredictionData_Client_DWallJump(const UCharacterMovementComponent& ClientMovement);
+
+	virtual FSavedMovePtr AllocateNewMove() override;
+};
@@ -0,0 +1,205 @@
+#include "Dignity.h"
+#include "DWallJumpStats.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY(LogDWallJump);
+
+DEFINE_STAT(STAT_DWallJump_CapsuleHit);
+DEFINE_STAT(STAT_DWallJump_WallCling);
+DEFINE_STAT(STAT_DWallJump_WallJump);
+DEFINE_STAT(STAT_DWallJump_CheckWallClingJump);
+DEFINE_STAT(STAT_DWallJump_AlignMesh);
+DEFINE_STAT(STAT_DWallJump_ClingTransition);
+DEFINE_STAT(STAT_DWallJump_LookRestrictions);
+DEFINE_STAT(STAT_DWallJump_HitBatch);
+DEFINE_STAT(STAT_DWallJump_ClingProbes);
+DEFINE_STAT(STAT_DWallJump_ClingPersistence);
+DEFINE_STAT(STAT_DWallJump_AIBatch);
+DEFINE_STAT(STAT_DWallJump_AIBatchWait);
+DEFINE_STAT(STAT_DWallJump_LowSignificance);
+DEFINE_STAT(STAT_DWallJump_HitsDisabled);
+DEFINE_STAT(STAT_DWallJump_SignificanceSaved);
+
+static FAutoConsoleCommand CmdWallJumpStatsCSV(
+	TEXT("dignity.WallJump.StatsCSV"),
+	TEXT("Captures the WallJump counters per frame to an CSV file. Usage: dignity.WallJump.StatsCSV Start [FileName] | Stop. Files are written to Saved/WallJump/."),
+	FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+	{
+		FDWallJumpStats& Stats = FDWallJumpStats::Get();
+
+		if (Args.Num() > 0 && Args[0] == TEXT("Stop"))
+		{
+			Stats.StopCSVCapture();
+		}
+		else
+		{
+			const FString FileName = Args.Num() > 1 ? Args[1] : FString::Printf(TEXT("WallJumpStats-%s.csv"), *FDateTime::Now().ToString());
+			Stats.StartCSVCapture(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("WallJump"), FileName));
+		}
+	}));
+
+static FAutoConsoleCommand CmdWallJumpStatsDump(
+	TEXT("dignity.WallJump.StatsDump"),
+	TEXT("Logs the WallJump counters. Pass Reset to reset them afterwards."),
+	FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+	{
+		FDWallJumpStats& Stats = FDWallJumpStats::Get();
+		Stats.LogTotals();
+
+		if (Args.Num() > 0 && Args[0] == TEXT("Reset"))
+		{
+			Stats.ResetTotals();
+		}
+	}));
+
+FDWallJumpStats& FDWallJumpStats::Get()
+{
+	static FDWallJumpStats Stats;
+	return Stats;
+}
+
+FDWallJumpStats::FDWallJumpStats()
+{
+	FMemory::Memzero(FrameCounts);
+	FMemory::Memzero(TotalCounts);
+	FMemory::Memzero(AverageWorkSeconds);
+	TotalSecondsSaved = 0.0;
+}
+
+const TCHAR* FDWallJumpStats::GetCounterName(EDWallJumpCounter Counter)
+{
+	static const TCHAR* CounterNames[] =
+	{
+		TEXT("HitsReceived"),
+		TEXT("HitsCoalesced"),
+		TEXT("RejectedSurfaceType"),
+		TEXT("RejectedExhausted"),
+		TEXT("RejectedCount"),
+		TEXT("RejectedNotLocal"),
+		TEXT("RejectedNotFalling"),
+		TEXT("RejectedPitch"),
+		TEXT("RejectedYaw"),
+		TEXT("RejectedSpeed"),
+		TEXT("RejectedGracePeriod"),
+		TEXT("Clings"),
+		TEXT("Jumps"),
+		TEXT("Falls"),
+		TEXT("DamageReleases"),
+		TEXT("ProbesIssued"),
+		TEXT("ProbeHits"),
+		TEXT("PredictedClings"),
+		TEXT("SkippedTicks"),
+		TEXT("SkippedAlignments"),
+		TEXT("AIRequests"),
+		TEXT("PersistenceProbes"),
+		TEXT("ClingsLost")
+	};
+	static_assert(ARRAY_COUNT(CounterNames) == (int32)EDWallJumpCounter::Num, "Every EDWallJumpCounter needs an name.");
+
+	return CounterNames[(int32)Counter];
+}
+
+bool FDWallJumpStats::StartCSVCapture(const FString& FilePath)
+{
+	StopCSVCapture();
+
+	CSVWriter = TUniquePtr<FArchive>(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!CSVWriter.IsValid())
+	{
+		UE_LOG(LogDWallJump, Warning, TEXT("Failed to open %s for the WallJump stats capture."), *FilePath);
+		return false;
+	}
+
+	FString Header = TEXT("Frame,WorldTime");
+	for (int32 Index = 0; Index < (int32)EDWallJumpCounter::Num; Index++)
+	{
+		Header += TEXT(",");
+		Header += GetCounterName((EDWallJumpCounter)Index);
+	}
+	Header += TEXT("\n");
+
+	FTCHARToUTF8 HeaderUTF8(*Header);
+	CSVWriter->Serialize((void*)HeaderUTF8.Get(), HeaderUTF8.Length());
+
+	FMemory::Memzero(FrameCounts);
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &FDWallJumpStats::OnEndFrame);
+
+	UE_LOG(LogDWallJump, Log, TEXT("Started the WallJump stats capture to %s."), *FilePath);
+	return true;
+}
+
+void FDWallJumpStats::StopCSVCapture()
+{
+	if (CSVWriter.IsValid())
+	{
+		FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+		EndFrameHandle.Reset();
+
+		CSVWriter->Close();
+		CSVWriter.Reset();
+
+		UE_LOG(LogDWallJump, Log, TEXT("Stopped the WallJump stats capture."));
+	}
+}
+
+void FDWallJumpStats::OnEndFrame()
+{
+	if (!CSVWriter.IsValid())
+	{
+		return;
+	}
+
+	FString Line = FString::Printf(TEXT("%llu,%.4f"), (uint64)GFrameCounter, FPlatformTime::Seconds() - GStartTime);
+	for (int32 Index = 0; Index < (int32)EDWallJumpCounter::Num; Index++)
+	{
+		Line += FString::Printf(TEXT(",%u"), FrameCounts[Index]);
+	}
+	Line += TEXT("\n");
+
+	FTCHARToUTF8 LineUTF8(*Line);
+	CSVWriter->Serialize((void*)LineUTF8.Get(), LineUTF8.Length());
+
+	FMemory::Memzero(FrameCounts);
+}
+
+void FDWallJumpStats::LogTotals() const
+{
+	for (int32 Index = 0; Index < (int32)EDWallJumpCounter::Num; Index++)
+	{
+		UE_LOG(LogDWallJump, Log, TEXT("%s: %llu"), GetCounterName((EDWallJumpCounter)Index), TotalCounts[Index]);
+	}
+
+	UE_LOG(LogDWallJump, Log, TEXT("SignificanceTimeSaved: %.3f ms"), TotalSecondsSaved * 1000.0);
+}
+
+void FDWallJumpStats::ResetTotals()
+{
+	FMemory::Memzero(TotalCounts);
+	TotalSecondsSaved = 0.0;
+}
+
+void FDWallJumpStats::RecordWorkCost(EDWallJumpSkippableWork Work, double Seconds)
+{
+	// An exponential moving average, quick to settle and cheap enough to update on every call.
+	double& Average = AverageWorkSeconds[(int32)Work];
+	Average = Average > 0.0 ? FMath::Lerp(Average, Seconds, 0.05) : Seconds;
+}
+
+void FDWallJumpStats::RecordSkippedWork(EDWallJumpSkippableWork Work, int32 Count /*= 1*/)
+{
+	if (Count <= 0)
+	{
+		return;
+	}
+
+	const int32 Counter = (int32)(Work == EDWallJumpSkippableWork::Tick ? EDWallJumpCounter::SkippedTicks : EDWallJumpCounter::SkippedAlignments);
+	FrameCounts[Counter] += Count;
+	TotalCounts[Counter] += Count;
+
+	const double SecondsSaved = AverageWorkSeconds[(int32)Work] * Count;
+	TotalSecondsSaved += SecondsSaved;
+	INC_FLOAT_STAT_BY(STAT_DWallJump_SignificanceSaved, (float)(SecondsSaved * 1000.0));
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogDWallJump, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("WallJump"), STATGROUP_DWallJump, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("OnCharacterCapsuleHit"), STAT_DWallJump_CapsuleHit, STATGROUP_DWallJump, DIGNITY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("WallCling"), STAT_DWallJump_WallCling, STATGROUP_DWallJump, DIGNITY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("WallJump"), STAT_DWallJump_WallJump, STATGROUP_DWallJump, DIGNITY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("CheckWallClingJump"), STAT_DWallJump_CheckWallClingJump, STATGROUP_DWallJump, DIGNITY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AlignCharacterMeshForCling"), STAT_DWallJump_AlignMesh, STATGROUP_DWallJump, DIGNITY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Cling Transition"), STAT_DWallJump_ClingTransition, STATGROUP_DWallJump, DIGNITY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ApplyWallClingLookInputRestrictions"), STAT_DWallJump_LookRestrictions, STATGROUP_DWallJump, DIGNITY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Hit Batch"), STAT_DWallJump_HitBatch, STATGROUP_DWallJump, DIGNITY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Wall Cling Probes"), STAT_DWallJump_ClingProbes, STATGROUP_DWallJump, DIGNITY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Cling Persistence"), STAT_DWallJump_ClingPersistence, STATGROUP_DWallJump, DIGNITY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AI Batch"), STAT_DWallJump_AIBatch, STATGROUP_DWallJump, DIGNITY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AI Batch Wait"), STAT_DWallJump_AIBatchWait, STATGROUP_DWallJump, DIGNITY_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Low Significance WJCs"), STAT_DWallJump_LowSignificance, STATGROUP_DWallJump, DIGNITY_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("WJCs Ignoring Hits"), STAT_DWallJump_HitsDisabled, STATGROUP_DWallJump, DIGNITY_API);
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Significance Time Saved (ms)"), STAT_DWallJump_SignificanceSaved, STATGROUP_DWallJump, DIGNITY_API);
+
+/* Scopes an cycle counter for the stat system along with an named event of the same name for external profilers and traces. */
+#define DWALLJUMP_SCOPE_CYCLE_COUNTER(Stat) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	SCOPED_NAMED_EVENT(Stat, FColor::Orange)
+
+/* The events counted by FDWallJumpStats. */
+enum class EDWallJumpCounter : uint8
+{
+	HitsReceived,
+	HitsCoalesced,
+	RejectedSurfaceType,
+	RejectedExhausted,
+	RejectedCount,
+	RejectedNotLocal,
+	RejectedNotFalling,
+	RejectedPitch,
+	RejectedYaw,
+	RejectedSpeed,
+	RejectedGracePeriod,
+	Clings,
+	Jumps,
+	Falls,
+	DamageReleases,
+	ProbesIssued,
+	ProbeHits,
+	PredictedClings,
+	SkippedTicks,
+	SkippedAlignments,
+	AIRequests,
+	PersistenceProbes,
+	ClingsLost,
+
+	Num
+};
+
+/* Work an WJC skips at Low significance, see UDWallJumpSubsystem::UpdateSignificance(). */
+enum class EDWallJumpSkippableWork : uint8
+{
+	Tick,
+	AlignMesh,
+
+	Num
+};
+
+/**
+ * Counts what every WJC on this machine does, in all build configurations.
+ * The counts can be dumped to the log, or captured per frame to an CSV file with the dignity.WallJump.StatsCSV console command, which works on Dedicated Servers.
+ */
+class DIGNITY_API FDWallJumpStats
+{
+public:
+
+	static FDWallJumpStats& Get();
+
+	FORCEINLINE void Increment(EDWallJumpCounter Counter)
+	{
+		FrameCounts[(int32)Counter]++;
+		TotalCounts[(int32)Counter]++;
+	}
+
+	/* Starts writing an line of counts to FilePath at the end of every frame. */
+	bool StartCSVCapture(const FString& FilePath);
+
+	/* Stops and closes the CSV capture. */
+	void StopCSVCapture();
+
+	FORCEINLINE bool IsCapturingCSV() const { return CSVWriter.IsValid(); }
+
+	/* Logs the counts since the last ResetTotals(). */
+	void LogTotals() const;
+
+	void ResetTotals();
+
+	static const TCHAR* GetCounterName(EDWallJumpCounter Counter);
+
+	/* Adds to the running average cost of the Work, measured whenever it isnt skipped. */
+	void RecordWorkCost(EDWallJumpSkippableWork Work, double Seconds);
+
+	/* Counts the Work as skipped and adds its average cost to the time saved by the significance LOD. */
+	void RecordSkippedWork(EDWallJumpSkippableWork Work, int32 Count = 1);
+
+private:
+
+	FDWallJumpStats();
+
+	/* Writes the counts for this frame to the CSV capture. */
+	void OnEndFrame();
+
+	/* Counts since the last CSV line was written. */
+	uint32 FrameCounts[(int32)EDWallJumpCounter::Num];
+
+	/* Counts since the last ResetTotals(). */
+	uint64 TotalCounts[(int32)EDWallJumpCounter::Num];
+
+	/* Running average cost of each EDWallJumpSkippableWork, in seconds. */
+	double AverageWorkSeconds[(int32)EDWallJumpSkippableWork::Num];
+
+	/* Estimated time the significance LOD has saved since the last ResetTotals(). */
+	double TotalSecondsSaved;
+
+	TUniquePtr<FArchive> CSVWriter;
+
+	FDelegateHandle EndFrameHandle;
+};
@@ -0,0 +1,549 @@
+#include "Dignity.h"
+#include "DWallJumpSubsystem.h"
+#include "DWallJumpComponent.h"
+#include "DWallJumpStats.h"
+#include "DWallJumpTuning.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+#if !UE_BUILD_SHIPPING && DIGNITY_DEVELOPMENT
+static TAutoConsoleVariable<int32> CVarWallJumpDebugDrawMaxRecords(
+	TEXT("dignity.WallJump.DebugDrawMaxRecords"),
+	32,
+	TEXT("The maximum number of recent WallCling/WallJump evaluations drawn each frame."));
+
+static TAutoConsoleVariable<float> CVarWallJumpDebugDrawMaxAge(
+	TEXT("dignity.WallJump.DebugDrawMaxAge"),
+	5.f,
+	TEXT("How many seconds an WallCling/WallJump evaluation is drawn for."));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdWallJumpExportDebug(
+	TEXT("dignity.WallJump.ExportDebug"),
+	TEXT("Exports the recent WallCling/WallJump evaluations to an CSV file. Optionally takes the file name, written to Saved/WallJump/."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+	{
+		UDWallJumpSubsystem* WallJumpSubsystem = World ? World->GetSubsystem<UDWallJumpSubsystem>() : nullptr;
+		if (WallJumpSubsystem)
+		{
+			const FString FileName = Args.Num() > 0 ? Args[0] : FString::Printf(TEXT("WallJumpDebug-%s.csv"), *FDateTime::Now().ToString());
+			WallJumpSubsystem->GetDebugBuffer().ExportToCSV(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("WallJump"), FileName));
+		}
+	}));
+#endif //!UE_BUILD_SHIPPING && DIGNITY_DEVELOPMENT
+
+UDWallJumpSubsystem::UDWallJumpSubsystem()
+{
+	NoWallClingTag = "NoWallCling";
+	NoWallJumpTag = "NoWallJump";
+
+	bHasOpenedClingNavData = false;
+	NextProbeId = 0;
+
+	bEnableSignificance = true;
+	SignificanceUpdateInterval = 0.25f;
+	HighSignificanceDistance = 3000.f;
+	MaxHighSignificanceComponents = 16;
+	LowSignificanceTickInterval = 0.1f;
+	NextSignificanceUpdateTime = 0.f;
+
+	AIBatchMinSize = 32;
+	AIBatchMinDispatchSize = 128;
+
+	ClingPersistenceProbeInterval = 6;
+	ClingPersistenceProbeDistance = 20.f;
+	NextClingPersistencePhase = 0;
+}
+
+void UDWallJumpSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	SurfaceRules.NoClingTag = NoWallClingTag;
+	SurfaceRules.NoJumpTag = NoWallJumpTag;
+	SurfaceRules.NoClingSurfaceTypes = NoWallClingSurfaceTypes;
+	SurfaceRules.NoJumpSurfaceTypes = NoWallJumpSurfaceTypes;
+
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UDWallJumpSubsystem::OnLevelsChanged);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &UDWallJumpSubsystem::OnLevelsChanged);
+	TuningChangedHandle = UDWallJumpTuning::OnTuningChanged().AddUObject(this, &UDWallJumpSubsystem::OnTuningChanged);
+
+	ProbeTraceDelegate.BindUObject(this, &UDWallJumpSubsystem::OnWallClingProbeCompleted);
+	PersistenceTraceDelegate.BindUObject(this, &UDWallJumpSubsystem::OnClingPersistenceProbeCompleted);
+}
+
+void UDWallJumpSubsystem::Deinitialize()
+{
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	UDWallJumpTuning::OnTuningChanged().Remove(TuningChangedHandle);
+
+	// The worker threads could still be writing to the InFlightAIBatch.
+	if (AIBatchTask.IsValid())
+	{
+		FTaskGraphInterface::Get().WaitUntilTaskCompletes(AIBatchTask, ENamedThreads::GameThread);
+		AIBatchTask = nullptr;
+	}
+
+	QueuedAIRequests.Empty();
+	QueuedAIBatch.Reset();
+	InFlightAIRequests.Empty();
+	InFlightAIBatch.Reset();
+
+	PendingComponents.Empty();
+	PendingWallMoveComponents.Empty();
+	HitBatch.Reset();
+	HitBatchComponents.Reset();
+	DebugBuffer.Reset();
+	SurfaceCache.Reset();
+	ClingNavData.Close();
+	bHasOpenedClingNavData = false;
+	WallJumpComponents.Empty();
+	ProbeComponents.Empty();
+	PendingProbes.Empty();
+	ProbeTraceDelegate.Unbind();
+	ClingingComponents.Empty();
+	PendingPersistenceProbes.Empty();
+	PersistenceTraceDelegate.Unbind();
+
+	Super::Deinitialize();
+}
+
+FDWallClingNavData* UDWallJumpSubsystem::GetClingNavData()
+{
+	if (!bHasOpenedClingNavData)
+	{
+		bHasOpenedClingNavData = true;
+
+		const FString MapName = UWorld::RemovePIEPrefix(GetWorld()->GetOutermost()->GetName());
+		ClingNavData.Open(FDWallClingNavData::GetFilePath(MapName));
+	}
+
+	return ClingNavData.IsOpen() ? &ClingNavData : nullptr;
+}
+
+void UDWallJumpSubsystem::Tick(float DeltaTime)
+{
+	if (bEnableSignificance)
+	{
+		UpdateSignificance();
+	}
+
+	IssueWallClingProbes();
+
+	UpdateClingPersistence();
+
+	ApplyAIWallMoves();
+
+	HitBatch.Reset();
+	HitBatchComponents.Reset();
+
+	UDWallJumpComponent::GatherWallHitCandidates(PendingComponents, HitBatch, HitBatchComponents);
+
+	// Anything queued while applying the results below belongs to the next frame.
+	PendingComponents.Reset();
+
+	{
+		DWALLJUMP_SCOPE_CYCLE_COUNTER(STAT_DWallJump_HitBatch);
+		HitBatch.Evaluate();
+	}
+
+	for (int32 Index = 0; Index < HitBatch.Num(); Index++)
+	{
+		HitBatchComponents[Index]->ApplyWallHitEvaluation(HitBatch.GetEvaluation(Index));
+	}
+
+	// Send everything each WJC did this frame as one packet.
+	for (const TWeakObjectPtr<UDWallJumpComponent>& PendingComponent : PendingWallMoveComponents)
+	{
+		if (UDWallJumpComponent* WallJumpComponent = PendingComponent.Get())
+		{
+			WallJumpComponent->FlushWallMove();
+		}
+	}
+
+	PendingWallMoveComponents.Reset();
+
+	DispatchAIWallMoves();
+
+#if !UE_BUILD_SHIPPING && DIGNITY_DEVELOPMENT
+	DebugBuffer.Draw(GetWorld(), CVarWallJumpDebugDrawMaxAge.GetValueOnGameThread(), CVarWallJumpDebugDrawMaxRecords.GetValueOnGameThread());
+#endif //!UE_BUILD_SHIPPING && DIGNITY_DEVELOPMENT
+}
+
+bool UDWallJumpSubsystem::IsTickable() const
+{
+	// FTickableGameObject registers the CDO and any template too, they have no World to work on.
+	if (IsTemplate())
+	{
+		return false;
+	}
+
+	if (PendingComponents.Num() > 0 || PendingWallMoveComponents.Num() > 0 || ProbeComponents.Num() > 0 || ClingingComponents.Num() > 0 || QueuedAIRequests.Num() > 0 || InFlightAIRequests.Num() > 0 || (bEnableSignificance && WallJumpComponents.Num() > 0))
+	{
+		return true;
+	}
+
+#if !UE_BUILD_SHIPPING && DIGNITY_DEVELOPMENT
+	// Keep ticking to redraw the debug evaluations until they are too old to be drawn.
+	UWorld* World = GetWorld();
+	if (World && DebugBuffer.HasRecentRecords(World->GetTimeSeconds(), CVarWallJumpDebugDrawMaxAge.GetValueOnGameThread()))
+	{
+		return true;
+	}
+#endif //!UE_BUILD_SHIPPING && DIGNITY_DEVELOPMENT
+
+	return false;
+}
+
+TStatId UDWallJumpSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDWallJumpSubsystem, STATGROUP_Tickables);
+}
+
+UWorld* UDWallJumpSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+void UDWallJumpSubsystem::OnLevelsChanged(ULevel* Level, UWorld* World)
+{
+	// LevelRemovedFromWorld is also called with an null World when every level is being removed.
+	if (!World || World == GetWorld())
+	{
+		SurfaceCache.Reset();
+	}
+}
+
+void UDWallJumpSubsystem::QueueWallHitEvaluation(UDWallJumpComponent* Component)
+{
+	PendingComponents.Add(Component);
+}
+
+void UDWallJumpSubsystem::QueueWallMoveFlush(UDWallJumpComponent* Component)
+{
+	PendingWallMoveComponents.AddUnique(Component);
+}
+
+void UDWallJumpSubsystem::QueueAIWallMove(const FDWallAIMoveRequest& Request, const FDWallHitCandidate& Candidate)
+{
+	QueuedAIRequests.Add(Request);
+	QueuedAIBatch.Add(Candidate);
+}
+
+void UDWallJumpSubsystem::DispatchAIWallMoves()
+{
+	// ApplyAIWallMoves() has already emptied the previous batch at the start of this Tick.
+	if (QueuedAIRequests.Num() == 0 || InFlightAIRequests.Num() > 0)
+	{
+		return;
+	}
+
+	// Swap rather than copy so both sides keep their allocations for the next frame.
+	Swap(QueuedAIRequests, InFlightAIRequests);
+	Swap(QueuedAIBatch, InFlightAIBatch);
+
+	if (InFlightAIRequests.Num() < AIBatchMinDispatchSize)
+	{
+		DWALLJUMP_SCOPE_CYCLE_COUNTER(STAT_DWallJump_AIBatch);
+		InFlightAIBatch.Evaluate();
+		return;
+	}
+
+	FDWallHitBatch* Batch = &InFlightAIBatch;
+	const int32 MinBatchSize = AIBatchMinSize;
+
+	AIBatchTask = FFunctionGraphTask::CreateAndDispatchWhenReady([Batch, MinBatchSize]()
+	{
+		DWALLJUMP_SCOPE_CYCLE_COUNTER(STAT_DWallJump_AIBatch);
+		Batch->EvaluateParallel(MinBatchSize);
+	}, TStatId(), nullptr, ENamedThreads::AnyHiPriThreadNormalTask);
+}
+
+void UDWallJumpSubsystem::ApplyAIWallMoves()
+{
+	if (InFlightAIRequests.Num() == 0)
+	{
+		return;
+	}
+
+	if (AIBatchTask.IsValid())
+	{
+		// The batch has had the rest of the last frame to finish, this should rarely have to wait.
+		DWALLJUMP_SCOPE_CYCLE_COUNTER(STAT_DWallJump_AIBatchWait);
+		FTaskGraphInterface::Get().WaitUntilTaskCompletes(AIBatchTask, ENamedThreads::GameThread);
+		AIBatchTask = nullptr;
+	}
+
+	for (int32 Index = 0; Index < InFlightAIRequests.Num(); Index++)
+	{
+		if (UDWallJumpComponent* WallJumpComponent = InFlightAIRequests[Index].Component.Get())
+		{
+			WallJumpComponent->ApplyAIWallMove(InFlightAIRequests[Index], InFlightAIBatch.GetEvaluation(Index));
+		}
+	}
+
+	InFlightAIRequests.Reset();
+	InFlightAIBatch.Reset();
+}
+
+void UDWallJumpSubsystem::RegisterWallJumpComponent(UDWallJumpComponent* Component)
+{
+	WallJumpComponents.AddUnique(Component);
+
+	// Let the new WJC be picked up by the next update rather than waiting out the interval.
+	NextSignificanceUpdateTime = 0.f;
+}
+
+void UDWallJumpSubsystem::UnregisterWallJumpComponent(UDWallJumpComponent* Component)
+{
+	WallJumpComponents.RemoveSwap(Component);
+}
+
+void UDWallJumpSubsystem::OnTuningChanged(const UDWallJumpTuning* Tuning)
+{
+	// WJCs without overrides read the Tuning directly and already see the change, the rest rebuild their copy.
+	for (const TWeakObjectPtr<UDWallJumpComponent>& WeakComponent : WallJumpComponents)
+	{
+		UDWallJumpComponent* WallJumpComponent = WeakComponent.Get();
+		if (WallJumpComponent && WallJumpComponent->Tuning == Tuning)
+		{
+			WallJumpComponent->ResolveTuning();
+		}
+	}
+}
+
+void UDWallJumpSubsystem::UpdateSignificance()
+{
+	UWorld* World = GetWorld();
+	const float WorldTime = World->GetTimeSeconds();
+
+	if (WorldTime < NextSignificanceUpdateTime)
+	{
+		return;
+	}
+
+	NextSignificanceUpdateTime = WorldTime + SignificanceUpdateInterval;
+
+	// Clients only know about their local Players, the Server knows about every Player and views from where they are.
+	SignificanceViewLocations.Reset();
+	for (FConstPlayerControllerIterator Iterator = World->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		if (APlayerController* PlayerController = Iterator->Get())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			SignificanceViewLocations.Add(ViewLocation);
+		}
+	}
+
+	const float HighSignificanceDistanceSquared = FMath::Square(HighSignificanceDistance);
+	uint32 NumLowSignificance = 0;
+	uint32 NumHitsDisabled = 0;
+
+	SignificanceCandidates.Reset();
+
+	for (int32 Index = WallJumpComponents.Num() - 1; Index >= 0; Index--)
+	{
+		UDWallJumpComponent* WallJumpComponent = WallJumpComponents[Index].Get();
+		if (!WallJumpComponent || !WallJumpComponent->OwningCharacter)
+		{
+			WallJumpComponents.RemoveAtSwap(Index);
+			continue;
+		}
+
+		// Simulated Proxies and Characters controlled from another machine never act on their own Hits.
+		// Neither does AI, there is no Jump key to read so it asks for its Clings and Jumps through RequestAIWallMove().
+		const bool bCanActOnHits = WallJumpComponent->IsWallJumpInputLocal() && WallJumpComponent->OwningCharacter->IsPlayerControlled();
+		WallJumpComponent->SetCapsuleHitHandlingEnabled(bCanActOnHits);
+		NumHitsDisabled += bCanActOnHits ? 0 : 1;
+
+		// Our own Players are what everyone is looking at, and the Server owns every Players Cling rotation and release deadlines so it cant let them lag.
+		// That leaves Simulated Proxies and AI. IsPlayerControlled() cant tell them apart, it only looks at the PlayerState and that replicates to other Players Simulated Proxies too.
+		// The PlayerController only exists on the Server and the owning Client, so ask for it directly.
+		const ACharacter* Character = WallJumpComponent->OwningCharacter;
+		if (Character->IsLocallyControlled() || (Character->Role == ROLE_Authority && Cast<APlayerController>(Character->GetController())))
+		{
+			WallJumpComponent->SetSignificance(EDWallJumpSignificance::High, LowSignificanceTickInterval);
+			continue;
+		}
+
+		float ClosestDistanceSquared = MAX_flt;
+		for (const FVector& ViewLocation : SignificanceViewLocations)
+		{
+			ClosestDistanceSquared = FMath::Min(ClosestDistanceSquared, FVector::DistSquared(ViewLocation, Character->GetActorLocation()));
+		}
+
+		if (ClosestDistanceSquared <= HighSignificanceDistanceSquared)
+		{
+			SignificanceCandidates.Emplace(ClosestDistanceSquared, WallJumpComponent);
+		}
+		else
+		{
+			WallJumpComponent->SetSignificance(EDWallJumpSignificance::Low, LowSignificanceTickInterval);
+			NumLowSignificance++;
+		}
+	}
+
+	// Spend the High significance budget on whoever is closest.
+	SignificanceCandidates.Sort([](const TPair<float, UDWallJumpComponent*>& A, const TPair<float, UDWallJumpComponent*>& B) { return A.Key < B.Key; });
+
+	for (int32 Index = 0; Index < SignificanceCandidates.Num(); Index++)
+	{
+		const bool bIsHigh = Index < MaxHighSignificanceComponents;
+		SignificanceCandidates[Index].Value->SetSignificance(bIsHigh ? EDWallJumpSignificance::High : EDWallJumpSignificance::Low, LowSignificanceTickInterval);
+		NumLowSignificance += bIsHigh ? 0 : 1;
+	}
+
+	SET_DWORD_STAT(STAT_DWallJump_LowSignificance, NumLowSignificance);
+	SET_DWORD_STAT(STAT_DWallJump_HitsDisabled, NumHitsDisabled);
+}
+
+void UDWallJumpSubsystem::RegisterWallClingProbe(UDWallJumpComponent* Component)
+{
+	ProbeComponents.AddUnique(Component);
+}
+
+void UDWallJumpSubsystem::UnregisterWallClingProbe(UDWallJumpComponent* Component)
+{
+	ProbeComponents.RemoveSwap(Component);
+}
+
+void UDWallJumpSubsystem::IssueWallClingProbes()
+{
+	if (ProbeComponents.Num() == 0)
+	{
+		return;
+	}
+
+	DWALLJUMP_SCOPE_CYCLE_COUNTER(STAT_DWallJump_ClingProbes);
+
+	UWorld* World = GetWorld();
+	FDWallJumpStats& Stats = FDWallJumpStats::Get();
+	FDWallClingProbeRequest Request;
+
+	for (int32 Index = ProbeComponents.Num() - 1; Index >= 0; Index--)
+	{
+		UDWallJumpComponent* WallJumpComponent = ProbeComponents[Index].Get();
+		if (!WallJumpComponent)
+		{
+			ProbeComponents.RemoveAtSwap(Index);
+			continue;
+		}
+
+		if (!WallJumpComponent->GatherWallClingProbe(Request))
+		{
+			continue;
+		}
+
+		// The sweeps are only queued here, the World runs them all together on worker threads and hands them back to OnWallClingProbeCompleted().
+		const uint32 ProbeId = NextProbeId++;
+		World->AsyncSweepByChannel(EAsyncTraceType::Single, Request.Start, Request.End, Request.Rotation, Request.Channel, Request.Shape, Request.Params, Request.ResponseParams, &ProbeTraceDelegate, ProbeId);
+
+		FPendingProbe& PendingProbe = PendingProbes.Add(ProbeId);
+		PendingProbe.Component = WallJumpComponent;
+		PendingProbe.Speed = Request.Speed;
+
+		Stats.Increment(EDWallJumpCounter::ProbesIssued);
+	}
+}
+
+void UDWallJumpSubsystem::OnWallClingProbeCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	FPendingProbe PendingProbe;
+	if (!PendingProbes.RemoveAndCopyValue(TraceDatum.UserData, PendingProbe))
+	{
+		return;
+	}
+
+	UDWallJumpComponent* WallJumpComponent = PendingProbe.Component.Get();
+	if (WallJumpComponent && TraceDatum.OutHits.Num() > 0 && TraceDatum.OutHits[0].bBlockingHit)
+	{
+		FDWallJumpStats::Get().Increment(EDWallJumpCounter::ProbeHits);
+		WallJumpComponent->ApplyWallClingProbe(TraceDatum.OutHits[0], PendingProbe.Speed);
+	}
+}
+
+void UDWallJumpSubsystem::RegisterClingPersistence(UDWallJumpComponent* Component)
+{
+	for (const FClingingComponent& ClingingComponent : ClingingComponents)
+	{
+		if (ClingingComponent.Component == Component)
+		{
+			return;
+		}
+	}
+
+	FClingingComponent& ClingingComponent = ClingingComponents.AddDefaulted_GetRef();
+	ClingingComponent.Component = Component;
+	ClingingComponent.Phase = NextClingPersistencePhase++;
+}
+
+void UDWallJumpSubsystem::UpdateClingPersistence()
+{
+	if (ClingingComponents.Num() == 0)
+	{
+		return;
+	}
+
+	DWALLJUMP_SCOPE_CYCLE_COUNTER(STAT_DWallJump_ClingPersistence);
+
+	UWorld* World = GetWorld();
+	FDWallJumpStats& Stats = FDWallJumpStats::Get();
+	const uint32 Interval = (uint32)FMath::Max(ClingPersistenceProbeInterval, 1);
+	FDWallClingProbeRequest Request;
+
+	for (int32 Index = ClingingComponents.Num() - 1; Index >= 0; Index--)
+	{
+		UDWallJumpComponent* WallJumpComponent = ClingingComponents[Index].Component.Get();
+		if (!WallJumpComponent || !WallJumpComponent->IsClungToWall())
+		{
+			ClingingComponents.RemoveAtSwap(Index);
+			continue;
+		}
+
+		// The cached contact answers most frames without an trace, it can release the Cling outright or ask for an probe straight away once the Surface has moved as far as the probe reaches.
+		bool bNeedsProbe = false;
+		if (!WallJumpComponent->CheckWallClingPersistence(ClingPersistenceProbeDistance, bNeedsProbe))
+		{
+			ClingingComponents.RemoveAtSwap(Index);
+			continue;
+		}
+
+		if (!bNeedsProbe && (GFrameCounter + ClingingComponents[Index].Phase) % Interval != 0)
+		{
+			continue;
+		}
+
+		if (WallJumpComponent->GatherClingPersistenceProbe(Request, ClingPersistenceProbeDistance))
+		{
+			const uint32 ProbeId = NextProbeId++;
+			World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Request.Start, Request.End, Request.Channel, Request.Params, Request.ResponseParams, &PersistenceTraceDelegate, ProbeId);
+			PendingPersistenceProbes.Add(ProbeId, WallJumpComponent);
+
+			Stats.Increment(EDWallJumpCounter::PersistenceProbes);
+		}
+	}
+}
+
+void UDWallJumpSubsystem::OnClingPersistenceProbeCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	TWeakObjectPtr<UDWallJumpComponent> Component;
+	if (!PendingPersistenceProbes.RemoveAndCopyValue(TraceDatum.UserData, Component))
+	{
+		return;
+	}
+
+	UDWallJumpComponent* WallJumpComponent = Component.Get();
+	if (!WallJumpComponent)
+	{
+		return;
+	}
+
+	const FHitResult* Hit = TraceDatum.OutHits.Num() > 0 && TraceDatum.OutHits[0].bBlockingHit ? &TraceDatum.OutHits[0] : nullptr;
+	WallJumpComponent->ApplyClingPersistenceProbe(Hit);
+}
@@ -0,0 +1,309 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "WorldCollision.h"
+#include "DWallClingNavData.h"
+#include "DWallJumpCore.h"
+#include "DWallJumpDebug.h"
+#include "DWallJumpTypes.h"
+#include "DWallSurfaceCache.h"
+#include "DWallJumpSubsystem.generated.h"
+
+class UDWallJumpComponent;
+class UDWallJumpTuning;
+
+/**
+ * An sweep of an Characters Capsule along its Velocity, looking for the Surface it will hit in the next few frames.
+ * Also used for the short line trace that checks an Clung Character still has its Surface where it touched it, which leaves the Shape as an line.
+ */
+struct FDWallClingProbeRequest
+{
+	FVector Start;
+	FVector End;
+	FQuat Rotation;
+	FCollisionShape Shape;
+	ECollisionChannel Channel;
+	FCollisionQueryParams Params;
+	FCollisionResponseParams ResponseParams;
+
+	/* The Characters Speed when the probe was requested. */
+	float Speed;
+
+	FDWallClingProbeRequest()
+		: Start(FVector::ZeroVector)
+		, End(FVector::ZeroVector)
+		, Rotation(FQuat::Identity)
+		, Channel(ECC_Pawn)
+		, Speed(0.f)
+	{
+	}
+};
+
+/* An AI Characters request to Cling to or Jump from an Surface, see UDWallJumpComponent::RequestAIWallMove(). */
+struct FDWallAIMoveRequest
+{
+	TWeakObjectPtr<UDWallJumpComponent> Component;
+
+	/* The Surface to Cling to or Jump from, unused for an Jump from the Cling the Character is already in. */
+	FDWallClingContext Surface;
+
+	/* The Launch velocity of an Jump from an Cling, an Jump from an Hit ricochets its Launch velocity off the Surface instead. */
+	FVector LaunchVelocity;
+
+	/* True if the Character is Jumping from the Cling it is already in. */
+	bool bFromCling;
+
+	FDWallAIMoveRequest()
+		: LaunchVelocity(FVector::ZeroVector)
+		, bFromCling(false)
+	{
+	}
+};
+
+/**
+ * Gathers the Hits every WJC in the World wants evaluated this frame and evaluates them together as one batch.
+ * The batch is ticked after the Physics tick groups, by which point every CharacterMovementComponent has finished moving and raising Hits.
+ * It also owns the cache of what every static Surface in the World allows, see FDWallSurfaceCache.
+ *
+ * Requests from AI Characters are evaluated on the task graph worker threads while the rest of the frame runs, and applied at the start of the next tick.
+ */
+UCLASS(Config = Game)
+class DIGNITY_API UDWallJumpSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	UDWallJumpSubsystem();
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual bool IsTickable() const override;
+
+	virtual TStatId GetStatId() const override;
+
+	/* Lets the World we belong to decide if we Tick, so we dont when it is paused or isnt an Game World. */
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	/* Queues the WJC to have its pending Hit evaluated in this frames batch. */
+	void QueueWallHitEvaluation(UDWallJumpComponent* Component);
+
+	/* Queues the WJC to send its pending WallMove to the Server once this frame has been evaluated. */
+	void QueueWallMoveFlush(UDWallJumpComponent* Component);
+
+	/**
+	 * Queues an AI Characters WallCling or WallJump to be evaluated with every other AI request made this frame.
+	 *
+	 * @param	Request		Who made the request and what it is against.
+	 * @param	Candidate	The snapshot of the Character and Surface to evaluate, it is read from the worker threads so it cant point back at either.
+	 */
+	void QueueAIWallMove(const FDWallAIMoveRequest& Request, const FDWallHitCandidate& Candidate);
+
+	/* Adds the WJC to the significance updates, every WJC registers itself in BeginPlay. */
+	void RegisterWallJumpComponent(UDWallJumpComponent* Component);
+
+	void UnregisterWallJumpComponent(UDWallJumpComponent* Component);
+
+	/* Starts probing ahead of the WJCs Character every frame for Surfaces it is about to Cling to, see UDWallJumpComponent::bPredictWallCling. */
+	void RegisterWallClingProbe(UDWallJumpComponent* Component);
+
+	void UnregisterWallClingProbe(UDWallJumpComponent* Component);
+
+	/* Starts checking that the Surface the WJCs Character is Clung to is still there, until it is no longer Clung. */
+	void RegisterClingPersistence(UDWallJumpComponent* Component);
+
+	/* What every static Surface the WJCs in this World have hit allows. */
+	FORCEINLINE FDWallSurfaceCache& GetSurfaceCache() { return SurfaceCache; }
+
+	FORCEINLINE const FDWallSurfaceRules& GetSurfaceRules() const { return SurfaceRules; }
+
+	/* The baked Wall Cling navigation data of this Worlds map, opened the first time it is asked for. Null if the map hasnt been baked. */
+	FDWallClingNavData* GetClingNavData();
+
+	/* The most recent Cling and Jump evaluations of every WJC in the World that has debugging enabled. */
+	FORCEINLINE FDWallJumpDebugBuffer& GetDebugBuffer() { return DebugBuffer; }
+
+	/* An Component or Actor with this Tag cant be Clung to. */
+	UPROPERTY(Config)
+	FName NoWallClingTag;
+
+	/* An Component or Actor with this Tag cant be Jumped from. */
+	UPROPERTY(Config)
+	FName NoWallJumpTag;
+
+	/* Physical Surface types that cant be Clung to, ice for example. */
+	UPROPERTY(Config)
+	TArray<TEnumAsByte<EPhysicalSurface>> NoWallClingSurfaceTypes;
+
+	/* Physical Surface types that cant be Jumped from. */
+	UPROPERTY(Config)
+	TArray<TEnumAsByte<EPhysicalSurface>> NoWallJumpSurfaceTypes;
+
+	/* Whether WJCs far from every Player drop to Low significance and WJCs that cant act on Capsule Hits stop receiving them, see EDWallJumpSignificance. */
+	UPROPERTY(Config)
+	bool bEnableSignificance;
+
+	/* How often the significance of every WJC is re-evaluated, in seconds. */
+	UPROPERTY(Config)
+	float SignificanceUpdateInterval;
+
+	/* How close to an Players view an Character has to be for its WJC to be High significance. */
+	UPROPERTY(Config)
+	float HighSignificanceDistance;
+
+	/* The most WJCs that can be High significance at once, the closest ones win. Locally controlled Players are always High and dont count. */
+	UPROPERTY(Config)
+	int32 MaxHighSignificanceComponents;
+
+	/* The Tick interval of an Low significance WJC, in seconds. */
+	UPROPERTY(Config)
+	float LowSignificanceTickInterval;
+
+	/**
+	 * How many frames apart the persistence probes of each Clung WJC are, the probes of every Clung WJC are spread evenly across them.
+	 * An Cling whose Surface has gone is released at most this many frames later, plus the frame the probe takes to complete.
+	 */
+	UPROPERTY(Config)
+	int32 ClingPersistenceProbeInterval;
+
+	/* How far either side of where the Capsule touched the Surface the persistence probe looks for it. */
+	UPROPERTY(Config)
+	float ClingPersistenceProbeDistance;
+
+	/* The fewest AI requests each worker thread evaluates, an batch smaller than this is evaluated on an single worker thread. */
+	UPROPERTY(Config)
+	int32 AIBatchMinSize;
+
+	/**
+	 * The fewest AI requests worth dispatching to the task graph, an smaller batch is evaluated on the Game thread as it is dispatched.
+	 * Below it dispatching and waiting for the task costs the Game thread more than the evaluation, see dignity.WallJump.AIBatchBenchmark.
+	 * Either way the results are applied at the start of the next Tick.
+	 */
+	UPROPERTY(Config)
+	int32 AIBatchMinDispatchSize;
+
+private:
+
+	/* Every WJC that has an Hit waiting to be evaluated. */
+	TArray<TWeakObjectPtr<UDWallJumpComponent>> PendingComponents;
+
+	/* Every WJC that has an WallMove waiting to be sent to the Server. */
+	TArray<TWeakObjectPtr<UDWallJumpComponent>> PendingWallMoveComponents;
+
+	/* Reused every frame so we dont reallocate the arrays. */
+	FDWallHitBatch HitBatch;
+
+	/* The WJC that submitted each candidate in the HitBatch. */
+	TArray<UDWallJumpComponent*> HitBatchComponents;
+
+	FDWallJumpDebugBuffer DebugBuffer;
+
+	FDWallSurfaceCache SurfaceCache;
+
+	/* The Config rules, gathered in Initialize(). */
+	FDWallSurfaceRules SurfaceRules;
+
+	/* Every WJC in the World. */
+	TArray<TWeakObjectPtr<UDWallJumpComponent>> WallJumpComponents;
+
+	/* The World time the significance is next updated at. */
+	float NextSignificanceUpdateTime;
+
+	/* Reused by UpdateSignificance() so we dont reallocate them. */
+	TArray<FVector> SignificanceViewLocations;
+	TArray<TPair<float, UDWallJumpComponent*>> SignificanceCandidates;
+
+	/**
+	 * Decides the significance of every WJC from its distance to the nearest Player view, within the MaxHighSignificanceComponents budget.
+	 * Only runs every SignificanceUpdateInterval.
+	 */
+	void UpdateSignificance();
+
+	/* Every WJC that predicts its Clings, probed each frame. */
+	TArray<TWeakObjectPtr<UDWallJumpComponent>> ProbeComponents;
+
+	struct FPendingProbe
+	{
+		TWeakObjectPtr<UDWallJumpComponent> Component;
+
+		/* The Characters Speed when the probe was requested. */
+		float Speed;
+	};
+
+	/* The probes that are waiting on their async sweep, keyed by the UserData the sweep was requested with. */
+	TMap<uint32, FPendingProbe> PendingProbes;
+
+	uint32 NextProbeId;
+
+	FTraceDelegate ProbeTraceDelegate;
+
+	/* Requests an async sweep for every WJC that predicts its Clings, all of them are run together by the Worlds async trace batch. */
+	void IssueWallClingProbes();
+
+	/* Hands the result of an async sweep back to the WJC that requested it. */
+	void OnWallClingProbeCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+	/* The AI requests queued this frame, with their candidates in QueuedAIBatch. */
+	TArray<FDWallAIMoveRequest> QueuedAIRequests;
+	FDWallHitBatch QueuedAIBatch;
+
+	/* The AI requests waiting to be applied, with their candidates in InFlightAIBatch. Neither can be touched until the AIBatchTask evaluating them has completed. */
+	TArray<FDWallAIMoveRequest> InFlightAIRequests;
+	FDWallHitBatch InFlightAIBatch;
+
+	/* Completes once every candidate in the InFlightAIBatch has been evaluated, null if there is nothing in flight or it was evaluated on the Game thread. */
+	FGraphEventRef AIBatchTask;
+
+	/* Hands this frames AI requests to the worker threads, they are evaluated while the rest of the frame runs. */
+	void DispatchAIWallMoves();
+
+	/* The sync point for the AI requests, waits for the worker threads to finish evaluating them and applies the results on the Game Thread. */
+	void ApplyAIWallMoves();
+
+	struct FClingingComponent
+	{
+		TWeakObjectPtr<UDWallJumpComponent> Component;
+
+		/* Which of the ClingPersistenceProbeInterval frames this WJC is probed on. */
+		uint32 Phase;
+	};
+
+	/* Every WJC that is Clung to an Surface on this machine. */
+	TArray<FClingingComponent> ClingingComponents;
+
+	/* Handed out round robin so the persistence probes are staggered. */
+	uint32 NextClingPersistencePhase;
+
+	/* The persistence probes waiting on their async trace, keyed by the UserData the trace was requested with. */
+	TMap<uint32, TWeakObjectPtr<UDWallJumpComponent>> PendingPersistenceProbes;
+
+	FTraceDelegate PersistenceTraceDelegate;
+
+	/* Runs the cheap persistence check of every Clung WJC and requests an async trace for the ones whose turn it is this frame. */
+	void UpdateClingPersistence();
+
+	/* Hands the result of an persistence probe back to the WJC that requested it. */
+	void OnClingPersistenceProbeCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+	FDWallClingNavData ClingNavData;
+
+	bool bHasOpenedClingNavData;
+
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+
+	/* Empties the SurfaceCache when an level in our World is streamed in or out, the Components it holds may have come or gone. */
+	void OnLevelsChanged(ULevel* Level, UWorld* World);
+
+	FDelegateHandle TuningChangedHandle;
+
+	/* Applies an edited UDWallJumpTuning to every WJC in the World using it. */
+	void OnTuningChanged(const UDWallJumpTuning* Tuning);
+};
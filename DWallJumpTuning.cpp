@@ -0,0 +1,161 @@
+#include "Dignity.h"
+#include "DWallJumpTuning.h"
+#include "DWallJumpTypes.h"
+#include "Animation/AnimSequence.h"
+
+// The ClampMax of MaxSequentialWallClings/Jumps has to be an literal, keep it in step with the bits the counts are replicated in.
+static_assert(FDWallJumpOwnerState::MaxCount == 63, "Update the ClampMax of MaxSequentialWallClings and MaxSequentialWallJumps to FDWallJumpOwnerState::MaxCount.");
+
+FDWallJumpTuningValues::FDWallJumpTuningValues()
+	: ClingDuration(5.f)
+	, WallJumpInterferenceGracePeriodDuration(0.5f)
+	, ClingMinPitchSurfaceAngle(44.f)
+	, ClingMaxPitchSurfaceAngle(135.f)
+	, ClingMaxYawSurfaceAngle(45.f)
+	, ClingDamageReleaseThreshold(10.f)
+	, MaxSequentialWallClings(1)
+	, MaxSequentialWallJumps(1)
+	, MinVelocityToWallCling(300.f)
+	, WallClingPredictionFrames(3)
+	, WallClingLookInputRestrictionMode(ERestrictLookInput::RLI_Both)
+	, LookInputVerticalAngleRestriction(45.f)
+	, LookInputHorizontalAngleRestriction(180.f)
+	, WallJumpMagnitude(1000.f)
+	, ServerClingAngleTolerance(10.f)
+	, ServerClingSurfaceTolerance(15.f)
+	, ClingPoseBlendTime(0.1f)
+{
+	UpdateDerivedValues();
+}
+
+void FDWallJumpTuningValues::UpdateDerivedValues()
+{
+	// Make sure our ClingMaxPitch isnt exceeding our Min required value or its Max value.
+	ClingMinPitchSurfaceAngle = FMath::Clamp(ClingMinPitchSurfaceAngle, 0.f, 180.f);
+	ClingMaxPitchSurfaceAngle = FMath::Clamp(ClingMaxPitchSurfaceAngle, ClingMinPitchSurfaceAngle, 180.f);
+	ClingMaxYawSurfaceAngle = FMath::Clamp(ClingMaxYawSurfaceAngle, 0.f, 180.f);
+	ServerClingAngleTolerance = FMath::Max(ServerClingAngleTolerance, 0.f);
+	WallClingPredictionFrames = FMath::Clamp(WallClingPredictionFrames, 1, 30);
+	MaxSequentialWallClings = FMath::Clamp(MaxSequentialWallClings, 0, FDWallJumpOwnerState::MaxCount);
+	MaxSequentialWallJumps = FMath::Clamp(MaxSequentialWallJumps, 0, FDWallJumpOwnerState::MaxCount);
+
+	// Cosine decreases over [0, 180] so the Min angle becomes the upper bound and the Max angle the lower bound.
+	ClingMinPitchSurfaceAngleCos = FMath::Cos(FMath::DegreesToRadians(ClingMinPitchSurfaceAngle));
+	ClingMaxPitchSurfaceAngleCos = FMath::Cos(FMath::DegreesToRadians(ClingMaxPitchSurfaceAngle));
+	ClingMaxYawSurfaceAngleCos = FMath::Cos(FMath::DegreesToRadians(ClingMaxYawSurfaceAngle));
+
+	// The Server re-checks the Clients Clings against its own view of the Character, which can lag behind, so widen the bounds by the tolerance.
+	ServerClingMinPitchSurfaceAngleCos = FMath::Cos(FMath::DegreesToRadians(FMath::Max(ClingMinPitchSurfaceAngle - ServerClingAngleTolerance, 0.f)));
+	ServerClingMaxPitchSurfaceAngleCos = FMath::Cos(FMath::DegreesToRadians(FMath::Min(ClingMaxPitchSurfaceAngle + ServerClingAngleTolerance, 180.f)));
+	ServerClingMaxYawSurfaceAngleCos = FMath::Cos(FMath::DegreesToRadians(FMath::Min(ClingMaxYawSurfaceAngle + ServerClingAngleTolerance, 180.f)));
+}
+
+float FDWallJumpTuningValues::GetValue(EDWallJumpTuningValue Value) const
+{
+	switch (Value)
+	{
+	case EDWallJumpTuningValue::ClingDuration:							return ClingDuration;
+	case EDWallJumpTuningValue::WallJumpInterferenceGracePeriodDuration:	return WallJumpInterferenceGracePeriodDuration;
+	case EDWallJumpTuningValue::ClingMinPitchSurfaceAngle:				return ClingMinPitchSurfaceAngle;
+	case EDWallJumpTuningValue::ClingMaxPitchSurfaceAngle:				return ClingMaxPitchSurfaceAngle;
+	case EDWallJumpTuningValue::ClingMaxYawSurfaceAngle:					return ClingMaxYawSurfaceAngle;
+	case EDWallJumpTuningValue::ClingDamageReleaseThreshold:				return ClingDamageReleaseThreshold;
+	case EDWallJumpTuningValue::MaxSequentialWallClings:					return (float)MaxSequentialWallClings;
+	case EDWallJumpTuningValue::MaxSequentialWallJumps:					return (float)MaxSequentialWallJumps;
+	case EDWallJumpTuningValue::MinVelocityToWallCling:					return MinVelocityToWallCling;
+	case EDWallJumpTuningValue::WallClingPredictionFrames:				return (float)WallClingPredictionFrames;
+	case EDWallJumpTuningValue::LookInputVerticalAngleRestriction:		return LookInputVerticalAngleRestriction;
+	case EDWallJumpTuningValue::LookInputHorizontalAngleRestriction:		return LookInputHorizontalAngleRestriction;
+	case EDWallJumpTuningValue::WallJumpMagnitude:						return WallJumpMagnitude;
+	case EDWallJumpTuningValue::ServerClingAngleTolerance:				return ServerClingAngleTolerance;
+	case EDWallJumpTuningValue::ServerClingSurfaceTolerance:			return ServerClingSurfaceTolerance;
+	case EDWallJumpTuningValue::ClingPoseBlendTime:						return ClingPoseBlendTime;
+	case EDWallJumpTuningValue::WallClingLookInputRestrictionMode:		return (float)(uint8)WallClingLookInputRestrictionMode;
+	default:															return 0.f;
+	}
+}
+
+void FDWallJumpTuningValues::SetValue(EDWallJumpTuningValue Value, float Amount)
+{
+	switch (Value)
+	{
+	case EDWallJumpTuningValue::ClingDuration:							ClingDuration = FMath::Max(Amount, 0.f); break;
+	case EDWallJumpTuningValue::WallJumpInterferenceGracePeriodDuration:	WallJumpInterferenceGracePeriodDuration = FMath::Max(Amount, 0.f); break;
+	case EDWallJumpTuningValue::ClingMinPitchSurfaceAngle:				ClingMinPitchSurfaceAngle = Amount; break;
+	case EDWallJumpTuningValue::ClingMaxPitchSurfaceAngle:				ClingMaxPitchSurfaceAngle = Amount; break;
+	case EDWallJumpTuningValue::ClingMaxYawSurfaceAngle:					ClingMaxYawSurfaceAngle = Amount; break;
+	case EDWallJumpTuningValue::ClingDamageReleaseThreshold:				ClingDamageReleaseThreshold = FMath::Max(Amount, 0.f); break;
+	case EDWallJumpTuningValue::MaxSequentialWallClings:					MaxSequentialWallClings = FMath::Clamp(FMath::RoundToInt(Amount), 0, FDWallJumpOwnerState::MaxCount); break;
+	case EDWallJumpTuningValue::MaxSequentialWallJumps:					MaxSequentialWallJumps = FMath::Clamp(FMath::RoundToInt(Amount), 0, FDWallJumpOwnerState::MaxCount); break;
+	case EDWallJumpTuningValue::MinVelocityToWallCling:					MinVelocityToWallCling = FMath::Max(Amount, 0.f); break;
+	case EDWallJumpTuningValue::WallClingPredictionFrames:				WallClingPredictionFrames = FMath::RoundToInt(Amount); break;
+	case EDWallJumpTuningValue::LookInputVerticalAngleRestriction:		LookInputVerticalAngleRestriction = Amount; break;
+	case EDWallJumpTuningValue::LookInputHorizontalAngleRestriction:		LookInputHorizontalAngleRestriction = Amount; break;
+	case EDWallJumpTuningValue::WallJumpMagnitude:						WallJumpMagnitude = FMath::Max(Amount, 0.f); break;
+	case EDWallJumpTuningValue::ServerClingAngleTolerance:				ServerClingAngleTolerance = Amount; break;
+	case EDWallJumpTuningValue::ServerClingSurfaceTolerance:			ServerClingSurfaceTolerance = FMath::Max(Amount, 0.f); break;
+	case EDWallJumpTuningValue::ClingPoseBlendTime:						ClingPoseBlendTime = FMath::Max(Amount, 0.f); break;
+	case EDWallJumpTuningValue::WallClingLookInputRestrictionMode:		SetLookInputRestrictionMode(FMath::RoundToInt(Amount)); break;
+	default:															break;
+	}
+}
+
+void FDWallJumpTuningValues::SetLookInputRestrictionMode(int32 ModeIndex)
+{
+	// Ignore anything that isnt one of the modes rather than cast it to one.
+	const UEnum* RestrictLookInputEnum = StaticEnum<ERestrictLookInput>();
+	if (RestrictLookInputEnum && RestrictLookInputEnum->IsValidEnumValue(ModeIndex))
+	{
+		WallClingLookInputRestrictionMode = (ERestrictLookInput)ModeIndex;
+	}
+}
+
+const FDWallJumpTuningValues& FDWallJumpTuningValues::GetDefaults()
+{
+	static const FDWallJumpTuningValues Defaults;
+	return Defaults;
+}
+
+UDWallJumpTuning::UDWallJumpTuning()
+{
+	ClingAnimLeft = nullptr;
+	ClingAnimRight = nullptr;
+	ClingAnimForward = nullptr;
+}
+
+void UDWallJumpTuning::PostLoad()
+{
+	Super::PostLoad();
+
+	Values.UpdateDerivedValues();
+}
+
+#if WITH_EDITOR
+void UDWallJumpTuning::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	const FName PropertyName = PropertyChangedEvent.Property ? PropertyChangedEvent.Property->GetFName() : NAME_None;
+
+	// Keep the Min angle the one that was just edited, UpdateDerivedValues() would otherwise push the Max up to meet it.
+	if (PropertyName == GET_MEMBER_NAME_CHECKED(FDWallJumpTuningValues, ClingMinPitchSurfaceAngle))
+	{
+		Values.ClingMinPitchSurfaceAngle = FMath::Min(Values.ClingMinPitchSurfaceAngle, Values.ClingMaxPitchSurfaceAngle);
+	}
+
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// Applies the edit to every WJC using this profile, including the ones in an running Play session.
+	NotifyTuningChanged();
+}
+#endif // WITH_EDITOR
+
+void UDWallJumpTuning::NotifyTuningChanged()
+{
+	Values.UpdateDerivedValues();
+	OnTuningChanged().Broadcast(this);
+}
+
+FOnDWallJumpTuningChanged& UDWallJumpTuning::OnTuningChanged()
+{
+	static FOnDWallJumpTuningChanged TuningChanged;
+	return TuningChanged;
+}
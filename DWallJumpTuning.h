@@ -0,0 +1,225 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "DignityCharacter.h"
+#include "DWallJumpTuning.generated.h"
+
+class UAnimSequence;
+class UDWallJumpTuning;
+
+/* The FDWallJumpTuningValues an WJC can override from its UDWallJumpTuning, see FDWallJumpTuningOverride. */
+UENUM(BlueprintType)
+enum class EDWallJumpTuningValue : uint8
+{
+	ClingDuration,
+	WallJumpInterferenceGracePeriodDuration,
+	ClingMinPitchSurfaceAngle,
+	ClingMaxPitchSurfaceAngle,
+	ClingMaxYawSurfaceAngle,
+	ClingDamageReleaseThreshold,
+	MaxSequentialWallClings,
+	MaxSequentialWallJumps,
+	MinVelocityToWallCling,
+	WallClingPredictionFrames,
+	LookInputVerticalAngleRestriction,
+	LookInputHorizontalAngleRestriction,
+	WallJumpMagnitude,
+	ServerClingAngleTolerance,
+	ServerClingSurfaceTolerance,
+	ClingPoseBlendTime,
+	WallClingLookInputRestrictionMode,
+
+	Num UMETA(Hidden)
+};
+
+/**
+ * The tuning of an WJC, shared by every WJC using the same UDWallJumpTuning.
+ * The Cling angles are clamped and converted to their Cosine bounds once, by UpdateDerivedValues(), rather than by every WJC.
+ */
+USTRUCT(BlueprintType)
+struct DIGNITY_API FDWallJumpTuningValues
+{
+	GENERATED_BODY()
+
+	/* How long Clinging to an Wall will last before the Character is forced to fall off. Setting this to 0 will disable the effect. */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, meta = (ClampMin = 0, UIMin = 0), Category = "Cling")
+	float ClingDuration;
+
+	/* How long to wait for the ability to WallCling again. */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, meta = (ClampMin = 0, UIMin = 0), Category = "Cling")
+	float WallJumpInterferenceGracePeriodDuration;
+
+	/**
+	 * The Minimum Angle of the Surface normal that the Character can Cling to.
+	 * This cannot be greater than ClingMaxPitchSurfaceAngle.
+	 */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, meta = (ClampMin = 0, UIMin = 0, ClampMax = 180, UIMax = 180), Category = "Cling")
+	float ClingMinPitchSurfaceAngle;
+
+	/**
+	 * The Maximum Angle of the Surface normal that the Character can Cling to.
+	 * This cannot be less than ClingMinPitchSurfaceAngle.
+	 */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, meta = (ClampMin = 0, UIMin = 0, ClampMax = 180, UIMax = 180), Category = "Cling")
+	float ClingMaxPitchSurfaceAngle;
+
+	/* The Maximum Forward facing Angle that the Character can approach the Surface from in order to Cling. */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, meta = (ClampMin = 0, UIMin = 0, ClampMax = 180, UIMax = 180), Category = "Cling")
+	float ClingMaxYawSurfaceAngle;
+
+	/* How much damage needs to be applied in an single hit to force the Character to release an WallCling. */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, meta = (ClampMin = 0, UIMin = 0), Category = "Cling")
+	float ClingDamageReleaseThreshold;
+
+	/* The Maximum number of times this Character can Cling to an wall in an row without landing. Limited to FDWallJumpOwnerState::MaxCount. */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, meta = (ClampMin = 0, UIMin = 0, ClampMax = 63, UIMax = 63), Category = "Cling")
+	int32 MaxSequentialWallClings;
+
+	/* The Maximum number of WallJumps that the Character can perform in an row without landing. Limited to FDWallJumpOwnerState::MaxCount. */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, meta = (ClampMin = 0, UIMin = 0, ClampMax = 63, UIMax = 63), Category = "Jump")
+	int32 MaxSequentialWallJumps;
+
+	/* The minimum required velocity the Character must have in order to perform a WallCling. */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, meta = (ClampMin = 0, UIMin = 0), Category = "Cling")
+	float MinVelocityToWallCling;
+
+	/* How many frames of the Characters current Velocity ahead to probe for an Surface to Cling to, see UDWallJumpComponent::bPredictWallCling. */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, AdvancedDisplay, meta = (ClampMin = 1, UIMin = 1, ClampMax = 30, UIMax = 30), Category = "Cling")
+	int32 WallClingPredictionFrames;
+
+	/* The Look Input Restriction mode to use when Clung to a Wall. */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Cling")
+	ERestrictLookInput WallClingLookInputRestrictionMode;
+
+	/* The Angle on the Vertical Axis to restrict look input to when Clung to a Wall. These angles will be applied to the view axis defined by WallClingLookInputRestrictionMode. */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, meta = (ClampMin = -90, UIMin = -90, ClampMax = 90, UIMax = 90), Category = "Cling")
+	float LookInputVerticalAngleRestriction;
+
+	/* The Angle on the Horizontal Axis to restrict look input to when Clung to a Wall. These angles will be applied to the view axis defined by WallClingLookInputRestrictionMode. */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, meta = (ClampMin = 0, UIMin = 0, ClampMax = 360, UIMax = 360), Category = "Cling")
+	float LookInputHorizontalAngleRestriction;
+
+	/* Controls the power of the WallJump. */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, meta = (ClampMin = 0, UIMin = 0), Category = "Jump")
+	float WallJumpMagnitude;
+
+	/* How many degrees the Server allows an Clients Cling angles to be off by when it re-checks them, the Servers view of the Character can lag behind the Clients. */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, AdvancedDisplay, meta = (ClampMin = 0, UIMin = 0, ClampMax = 90, UIMax = 90), Category = "Cling")
+	float ServerClingAngleTolerance;
+
+	/* How far past the Capsule the Server looks for the Surface an Client says it Clung to, the Servers view of the Character can lag behind the Clients. */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, AdvancedDisplay, meta = (ClampMin = 0, UIMin = 0), Category = "Cling")
+	float ServerClingSurfaceTolerance;
+
+	/* How long other Characters take to turn to the Cling the Server sends for them, hiding the time between it and the next movement update. */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, AdvancedDisplay, meta = (ClampMin = 0, UIMin = 0), Category = "Cling")
+	float ClingPoseBlendTime;
+
+	/* Cosine of ClingMinPitchSurfaceAngle, the upper bound of the Dot between the Character Up vector and the Surface normal. */
+	float ClingMinPitchSurfaceAngleCos;
+
+	/* Cosine of ClingMaxPitchSurfaceAngle, the lower bound of the Dot between the Character Up vector and the Surface normal. */
+	float ClingMaxPitchSurfaceAngleCos;
+
+	/* Cosine of ClingMaxYawSurfaceAngle, the lower bound of the Cosine between the Character Forward vector and the inverse Surface normal. */
+	float ClingMaxYawSurfaceAngleCos;
+
+	/* Cosine bounds of the Cling angles widened by ServerClingAngleTolerance, used by the Server to re-check an Clients Cling. */
+	float ServerClingMinPitchSurfaceAngleCos;
+	float ServerClingMaxPitchSurfaceAngleCos;
+	float ServerClingMaxYawSurfaceAngleCos;
+
+	FDWallJumpTuningValues();
+
+	/* Clamps the Cling angles and recalculates their Cosines, this needs to be called whenever any of the values change. */
+	void UpdateDerivedValues();
+
+	/* Returns the Value as an float, the counts and WallClingLookInputRestrictionMode are converted. */
+	float GetValue(EDWallJumpTuningValue Value) const;
+
+	/* Sets the Value from an float, the counts are rounded. UpdateDerivedValues() needs to be called afterwards. */
+	void SetValue(EDWallJumpTuningValue Value, float Amount);
+
+	/* The values of an WJC with no UDWallJumpTuning. */
+	static const FDWallJumpTuningValues& GetDefaults();
+
+private:
+
+	void SetLookInputRestrictionMode(int32 ModeIndex);
+};
+
+/* One value an WJC uses instead of the one in its UDWallJumpTuning. */
+USTRUCT(BlueprintType)
+struct DIGNITY_API FDWallJumpTuningOverride
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Tuning")
+	EDWallJumpTuningValue Value;
+
+	/* The counts are rounded to the nearest whole number, WallClingLookInputRestrictionMode is the index of the mode. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Tuning")
+	float Amount;
+
+	FDWallJumpTuningOverride()
+		: Value(EDWallJumpTuningValue::ClingDuration)
+		, Amount(0.f)
+	{
+	}
+
+	FDWallJumpTuningOverride(EDWallJumpTuningValue InValue, float InAmount)
+		: Value(InValue)
+		, Amount(InAmount)
+	{
+	}
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnDWallJumpTuningChanged, const UDWallJumpTuning* /*Tuning*/);
+
+/**
+ * An WallJump tuning profile, shared by every WJC that uses it so the values and their Cosines are only stored and computed once.
+ * Characters of the same archetype should share one, an WJC that needs to differ in an few values lists them in its TuningOverrides.
+ *
+ * Editing an profile while Playing applies it to every WJC using it, see OnTuningChanged().
+ */
+UCLASS(BlueprintType)
+class DIGNITY_API UDWallJumpTuning : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+
+	UDWallJumpTuning();
+
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, meta = (ShowOnlyInnerProperties), Category = "Tuning")
+	FDWallJumpTuningValues Values;
+
+	/* The animation to play when Clinging to the Left. This is only an convenience variable, the WJC doesnt play any Anims. */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Animation")
+	UAnimSequence* ClingAnimLeft;
+
+	/* The animation to play when Clinging to the Right. This is only an convenience variable, the WJC doesnt play any Anims. */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Animation")
+	UAnimSequence* ClingAnimRight;
+
+	/* The animation to play when not Clinging to the Wall perpendicular but holding the Mesh forward. This is only an convenience variable, the WJC doesnt play any Anims. */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "Animation")
+	UAnimSequence* ClingAnimForward;
+
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif // WITH_EDITOR
+
+	/**
+	 * Tells every WJC using this profile that it changed, WJCs with TuningOverrides keep their own copy of the Values which needs rebuilding.
+	 * Called when the profile is edited, call it after changing an profile at runtime.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Wall Jump")
+	void NotifyTuningChanged();
+
+	/* Broadcast by NotifyTuningChanged(). */
+	static FOnDWallJumpTuningChanged& OnTuningChanged();
+};
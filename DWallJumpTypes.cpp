@@ -0,0 +1,223 @@
+#include "Dignity.h"
+#include "DWallJumpTypes.h"
+#include "Components/PrimitiveComponent.h"
+
+bool FDWallJumpOwnerState::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+{
+	const uint32 MaxSerializedCount = MaxCount;
+
+	uint32 SerializedWallClingCount = FMath::Min<uint32>(WallClingCount, MaxSerializedCount);
+	uint32 SerializedWallJumpCount = FMath::Min<uint32>(WallJumpCount, MaxSerializedCount);
+	uint8 Flags = (bAttemptedWallJump ? 1 : 0) | (bIsClungToWall ? 2 : 0);
+
+	Ar.SerializeInt(SerializedWallClingCount, MaxSerializedCount + 1);
+	Ar.SerializeInt(SerializedWallJumpCount, MaxSerializedCount + 1);
+	Ar.SerializeBits(&Flags, 2);
+
+	if (Ar.IsLoading())
+	{
+		WallClingCount = SerializedWallClingCount;
+		WallJumpCount = SerializedWallJumpCount;
+		bAttemptedWallJump = (Flags & 1) != 0;
+		bIsClungToWall = (Flags & 2) != 0;
+	}
+
+	bOutSuccess = true;
+	return true;
+}
+
+bool FDWallJumpMovePacket::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+{
+	Ar << Timestamp;
+	Ar.SerializeBits(&Flags, 2);
+
+	// Packets sent without an UDWallJumpMovementComponent arent tied to an move, dont send them an MoveTimestamp.
+	uint8 bHasMoveTimestamp = MoveTimestamp > 0.f;
+	Ar.SerializeBits(&bHasMoveTimestamp, 1);
+	if (bHasMoveTimestamp)
+	{
+		Ar << MoveTimestamp;
+	}
+	else if (Ar.IsLoading())
+	{
+		MoveTimestamp = 0.f;
+	}
+
+	bOutSuccess = true;
+
+	// Only pay for the vectors of the actions we actually performed.
+	if (HasAction(EDWallJumpMoveFlags::Cling))
+	{
+		bool bNormalSuccess = true;
+		ClingSurfaceNormal.NetSerialize(Ar, Map, bNormalSuccess);
+		bOutSuccess &= bNormalSuccess;
+	}
+
+	if (HasAction(EDWallJumpMoveFlags::Jump))
+	{
+		bool bDirectionSuccess = true;
+		JumpDirection.NetSerialize(Ar, Map, bDirectionSuccess);
+		bOutSuccess &= bDirectionSuccess;
+	}
+
+	return true;
+}
+
+FDWallClingPose::FDWallClingPose()
+	: bIsClung(false)
+	, bIsHoldingRightSide(false)
+	, bIsHeldPerpendicular(false)
+	, Anchor(FVector::ZeroVector)
+{
+	EncodedNormal[0] = EncodedNormal[1] = 0;
+}
+
+static FORCEINLINE float SignNotZero(float Value)
+{
+	return Value >= 0.f ? 1.f : -1.f;
+}
+
+static FORCEINLINE uint8 QuantizeSigned(float Value)
+{
+	return (uint8)FMath::RoundToInt((FMath::Clamp(Value, -1.f, 1.f) * 0.5f + 0.5f) * 255.f);
+}
+
+static FORCEINLINE float DequantizeSigned(uint8 Value)
+{
+	return Value / 255.f * 2.f - 1.f;
+}
+
+void FDWallClingPose::SetNormal(const FVector& Normal)
+{
+	// Project onto the octahedron, then fold the lower half over the upper so both fit in the same square.
+	const float L1Norm = FMath::Abs(Normal.X) + FMath::Abs(Normal.Y) + FMath::Abs(Normal.Z);
+	if (L1Norm < SMALL_NUMBER)
+	{
+		EncodedNormal[0] = EncodedNormal[1] = QuantizeSigned(0.f);
+		return;
+	}
+
+	float X = Normal.X / L1Norm;
+	float Y = Normal.Y / L1Norm;
+	if (Normal.Z < 0.f)
+	{
+		const float FoldedX = (1.f - FMath::Abs(Y)) * SignNotZero(X);
+		Y = (1.f - FMath::Abs(X)) * SignNotZero(Y);
+		X = FoldedX;
+	}
+
+	EncodedNormal[0] = QuantizeSigned(X);
+	EncodedNormal[1] = QuantizeSigned(Y);
+}
+
+FVector FDWallClingPose::GetNormal() const
+{
+	FVector Normal(DequantizeSigned(EncodedNormal[0]), DequantizeSigned(EncodedNormal[1]), 0.f);
+	Normal.Z = 1.f - FMath::Abs(Normal.X) - FMath::Abs(Normal.Y);
+	if (Normal.Z < 0.f)
+	{
+		const float UnfoldedX = (1.f - FMath::Abs(Normal.Y)) * SignNotZero(Normal.X);
+		Normal.Y = (1.f - FMath::Abs(Normal.X)) * SignNotZero(Normal.Y);
+		Normal.X = UnfoldedX;
+	}
+
+	return Normal.GetSafeNormal();
+}
+
+bool FDWallClingPose::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+{
+	uint8 Flags = (bIsClung ? 1 : 0) | (bIsHoldingRightSide ? 2 : 0) | (bIsHeldPerpendicular ? 4 : 0);
+	Ar.SerializeBits(&Flags, 3);
+
+	if (Ar.IsLoading())
+	{
+		bIsClung = (Flags & 1) != 0;
+		bIsHoldingRightSide = (Flags & 2) != 0;
+		bIsHeldPerpendicular = (Flags & 4) != 0;
+	}
+
+	bOutSuccess = true;
+
+	// An released pose has nothing else worth sending.
+	if (bIsClung)
+	{
+		Ar.Serialize(EncodedNormal, sizeof(EncodedNormal));
+
+		bool bAnchorSuccess = true;
+		Anchor.NetSerialize(Ar, Map, bAnchorSuccess);
+		bOutSuccess &= bAnchorSuccess;
+	}
+
+	return true;
+}
+
+bool FDWallClingPose::operator==(const FDWallClingPose& Other) const
+{
+	if (bIsClung != Other.bIsClung)
+	{
+		return false;
+	}
+
+	// The rest of an released pose isnt sent, so it shouldnt cause one to be.
+	return !bIsClung || (bIsHoldingRightSide == Other.bIsHoldingRightSide && bIsHeldPerpendicular == Other.bIsHeldPerpendicular
+		&& EncodedNormal[0] == Other.EncodedNormal[0] && EncodedNormal[1] == Other.EncodedNormal[1] && Anchor.Equals(Other.Anchor, 0.5f));
+}
+
+FDWallClingContext::FDWallClingContext()
+	: Surface(nullptr)
+	, ImpactPoint(FVector::ZeroVector)
+	, SurfaceFlags(0)
+	, CharacterYaw(0)
+{
+	ImpactNormal[0] = ImpactNormal[1] = ImpactNormal[2] = 0;
+	OriginalRotation[0] = OriginalRotation[1] = OriginalRotation[2] = 0;
+}
+
+void FDWallClingContext::SetFromHit(const FHitResult& Hit)
+{
+	Surface = Hit.Component;
+	ImpactPoint = Hit.ImpactPoint;
+	SurfaceFlags = 0;
+	SetImpactNormal(Hit.ImpactNormal);
+}
+
+void FDWallClingContext::SetSurfaceFrom(const FDWallClingContext& Other)
+{
+	Surface = Other.Surface;
+	ImpactPoint = Other.ImpactPoint;
+	SurfaceFlags = Other.SurfaceFlags;
+	ImpactNormal[0] = Other.ImpactNormal[0];
+	ImpactNormal[1] = Other.ImpactNormal[1];
+	ImpactNormal[2] = Other.ImpactNormal[2];
+	CharacterYaw = Other.CharacterYaw;
+}
+
+void FDWallClingContext::SetImpactNormal(const FVector& Normal)
+{
+	ImpactNormal[0] = (int16)FMath::RoundToInt(FMath::Clamp(Normal.X, -1.f, 1.f) * MAX_int16);
+	ImpactNormal[1] = (int16)FMath::RoundToInt(FMath::Clamp(Normal.Y, -1.f, 1.f) * MAX_int16);
+	ImpactNormal[2] = (int16)FMath::RoundToInt(FMath::Clamp(Normal.Z, -1.f, 1.f) * MAX_int16);
+}
+
+void FDWallClingContext::SetOriginalRotation(const FRotator& Rotation)
+{
+	OriginalRotation[0] = FRotator::CompressAxisToShort(Rotation.Pitch);
+	OriginalRotation[1] = FRotator::CompressAxisToShort(Rotation.Yaw);
+	OriginalRotation[2] = FRotator::CompressAxisToShort(Rotation.Roll);
+}
+
+FRotator FDWallClingContext::GetOriginalRotation() const
+{
+	return FRotator(FRotator::DecompressAxisFromShort(OriginalRotation[0]), FRotator::DecompressAxisFromShort(OriginalRotation[1]), FRotator::DecompressAxisFromShort(OriginalRotation[2]));
+}
+
+FHitResult FDWallClingContext::ToHitResult() const
+{
+	FHitResult Hit;
+	Hit.bBlockingHit = true;
+	Hit.Location = Hit.ImpactPoint = ImpactPoint;
+	Hit.Normal = Hit.ImpactNormal = GetImpactNormal();
+	Hit.Component = Surface;
+	Hit.Actor = Surface.IsValid() ? Surface->GetOwner() : nullptr;
+	return Hit;
+}
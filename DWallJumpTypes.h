@@ -0,0 +1,323 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "Engine/NetSerialization.h"
+#include "DWallJumpTypes.generated.h"
+
+/**
+ * The WallJump state that only the owning Client needs, replicated as an single packed property.
+ * The counters are serialized with only as many bits as an sensible MaxSequentialWallClings/Jumps needs.
+ */
+USTRUCT()
+struct DIGNITY_API FDWallJumpOwnerState
+{
+	GENERATED_BODY()
+
+	/* Counters are serialized in this many bits, anything larger is clamped when sent. */
+	static const uint32 CountBits = 6;
+
+	/* The largest count that survives replication, MaxSequentialWallClings/Jumps are clamped to it so the Client never sees an count below the Servers. */
+	static const int32 MaxCount = (1 << CountBits) - 1;
+
+	/* The current amount of WallClings that have been performed in an row without landing. */
+	uint8 WallClingCount;
+
+	/* The current amount of WallJumps that have been performed in an row without landing. */
+	uint8 WallJumpCount;
+
+	/* True if the Character has just WallJumped, this is used to stop us from Clinging to the same wall in the same frame. */
+	uint8 bAttemptedWallJump : 1;
+
+	/* True if this Character is considered to be clinging to an wall, false otherwise. */
+	uint8 bIsClungToWall : 1;
+
+	FDWallJumpOwnerState()
+		: WallClingCount(0)
+		, WallJumpCount(0)
+		, bAttemptedWallJump(false)
+		, bIsClungToWall(false)
+	{
+	}
+
+	FORCEINLINE void IncrementWallClingCount() { WallClingCount = FMath::Min<int32>(WallClingCount + 1, MAX_uint8); }
+
+	FORCEINLINE void IncrementWallJumpCount() { WallJumpCount = FMath::Min<int32>(WallJumpCount + 1, MAX_uint8); }
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	FORCEINLINE bool operator==(const FDWallJumpOwnerState& Other) const
+	{
+		return WallClingCount == Other.WallClingCount && WallJumpCount == Other.WallJumpCount && bAttemptedWallJump == Other.bAttemptedWallJump && bIsClungToWall == Other.bIsClungToWall;
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FDWallJumpOwnerState> : public TStructOpsTypeTraitsBase2<FDWallJumpOwnerState>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true
+	};
+};
+
+/* The actions an FDWallJumpMovePacket can carry, more than one can be set if they happened in the same frame. */
+namespace EDWallJumpMoveFlags
+{
+	enum Type : uint8
+	{
+		None	= 0,
+		Jump	= 1 << 0,
+		Cling	= 1 << 1,
+	};
+}
+
+/**
+ * An compact, timestamped record of the WallJump and WallCling actions the owning Client performed in an frame.
+ * It is sent Unreliably so the Server uses the Timestamp to discard packets that arrive out of order, and re-checks the actions against its own state before applying them.
+ */
+USTRUCT()
+struct DIGNITY_API FDWallJumpMovePacket
+{
+	GENERATED_BODY()
+
+	/* The Clients World time when the actions were performed. */
+	UPROPERTY()
+	float Timestamp;
+
+	/* The TimeStamp of the Clients saved move that carries these actions, the Server only applies them to that move. 0 if they arent tied to an move. */
+	UPROPERTY()
+	float MoveTimestamp;
+
+	/* EDWallJumpMoveFlags of the actions in this packet. */
+	UPROPERTY()
+	uint8 Flags;
+
+	/* The Surface normal that was Clung to, only sent with an Cling. */
+	UPROPERTY()
+	FVector_NetQuantizeNormal ClingSurfaceNormal;
+
+	/* The direction the Character Launched in, only sent with an Jump. The Server scales it by its own WallJumpMagnitude. */
+	UPROPERTY()
+	FVector_NetQuantizeNormal JumpDirection;
+
+	FDWallJumpMovePacket()
+		: Timestamp(0.f)
+		, MoveTimestamp(0.f)
+		, Flags(EDWallJumpMoveFlags::None)
+		, ClingSurfaceNormal(FVector::ZeroVector)
+		, JumpDirection(FVector::ZeroVector)
+	{
+	}
+
+	FORCEINLINE bool HasAction(EDWallJumpMoveFlags::Type Action) const { return (Flags & Action) != 0; }
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FDWallJumpMovePacket> : public TStructOpsTypeTraitsBase2<FDWallJumpMovePacket>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
+
+/**
+ * What an Simulated Proxy needs to show another Character Clinging, the side it holds, the Surface normal and where it Clung.
+ * The Server only changes it on an Cling transition so it is only sent then, an release costs 3 bits and an Cling a few bytes.
+ * The normal is octahedral encoded into 2 bytes, which is well within an degree and plenty to turn an Character by.
+ */
+USTRUCT()
+struct DIGNITY_API FDWallClingPose
+{
+	GENERATED_BODY()
+
+	uint8 bIsClung : 1;
+
+	uint8 bIsHoldingRightSide : 1;
+
+	/* Copy of the Servers bHoldCharacterMeshPerpendicularToSurface, the Proxy may not share the Servers defaults. */
+	uint8 bIsHeldPerpendicular : 1;
+
+	/* Where the Character was when it Clung. */
+	FVector_NetQuantize Anchor;
+
+	FDWallClingPose();
+
+	void SetNormal(const FVector& Normal);
+
+	FVector GetNormal() const;
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FDWallClingPose& Other) const;
+
+private:
+
+	/* The Surface normal, octahedral encoded. */
+	uint8 EncodedNormal[2];
+};
+
+template<>
+struct TStructOpsTypeTraits<FDWallClingPose> : public TStructOpsTypeTraitsBase2<FDWallClingPose>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true
+	};
+};
+
+/* How much of its work an WJC does, decided by the UDWallJumpSubsystem from how close it is to the Players viewing it. */
+enum class EDWallJumpSignificance : uint8
+{
+	/* Everything, at the full Tick rate. */
+	High,
+
+	/**
+	 * Ticks at the LowSignificanceTickInterval and skips debugging, Simulated Proxies also skip blending to the Cling pose and wait for the replicated Rotation.
+	 * The Server aligns the Character to the Cling surface at any significance, its Rotation is the one that replicates.
+	 * Only Simulated Proxies and AI are ever Low, Player controlled Characters are always High wherever they are controlled or authoritative.
+	 */
+	Low
+};
+
+/**
+ * Which of the Cling and Jump features an WJC uses, fixed when it begins play so its evaluation is compiled without the branches it never takes.
+ * Each archetype expects bCanWallCling, bCanWallJump and bRequireClingToWallJump to be set to match, an WJC whose flags dont falls back to Dynamic.
+ */
+UENUM(BlueprintType)
+enum class EDWallJumpArchetype : uint8
+{
+	/* Reads the flags on every evaluation, they can be changed at any time. */
+	Dynamic,
+
+	/* Clings and Jumps from Hits. */
+	ClingAndJump,
+
+	/* Has to Cling before it can Jump. */
+	ClingThenJump,
+
+	/* Clings but never Jumps. */
+	ClingOnly,
+
+	/* Jumps from Hits but never Clings. */
+	JumpOnly
+};
+
+/* Why an WJC released its Cling, each one is counted by FDWallJumpStats under its own counter. */
+UENUM(BlueprintType)
+enum class EDWallClingReleaseReason : uint8
+{
+	/* The ClingDuration ran out, or the Server or the movement mode ended the Cling. */
+	Fell,
+
+	/* The Character Jumped from the Cling, counted as an Jump rather than an release. */
+	Jumped,
+
+	/* The Character took at least the ClingDamageReleaseThreshold in one hit. */
+	Damaged,
+
+	/* The Surface was destroyed or is no longer where the Character touched it. */
+	SurfaceLost
+};
+
+/* The events an WJC raises on its native event channel. */
+enum class EDWallJumpEventType : uint8
+{
+	Clung,
+	Jumped,
+	Fell,
+	CooldownExpired,
+
+	Num
+};
+
+/* The compact payload of an WJC event, only the fields relevant to the Type are set. */
+struct FDWallJumpEvent
+{
+	EDWallJumpEventType Type;
+
+	/* Clung, Jumped from an Cling and Fell, the normal of the Surface. */
+	FVector SurfaceNormal;
+
+	/* Clung, the Impact point of the Hit. Jumped, where the Character jumped from. */
+	FVector Location;
+
+	/* Jumped, the velocity the Character was Launched with. */
+	FVector LaunchVelocity;
+
+	explicit FDWallJumpEvent(EDWallJumpEventType InType)
+		: Type(InType)
+		, SurfaceNormal(FVector::ZeroVector)
+		, Location(FVector::ZeroVector)
+		, LaunchVelocity(FVector::ZeroVector)
+	{
+	}
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnWallJumpEventNative, const FDWallJumpEvent&);
+
+/**
+ * What an WJC remembers about the Surface it Clung to, kept small since every WJC holds one.
+ * The Impact normal is quantized to 16 bits per axis and the Characters rotations to 16 bits per axis as FRotator::CompressAxisToShort() does.
+ * The Impact point stays at full precision, quantizing it to an fixed point 32 bit value per axis wouldnt save anything.
+ */
+struct DIGNITY_API FDWallClingContext
+{
+	/* The Component that was hit, on the Server the one it found behind the Clients normal. */
+	TWeakObjectPtr<UPrimitiveComponent> Surface;
+
+	/* The Impact point of the Hit. */
+	FVector ImpactPoint;
+
+	/* EDWallSurfaceFlags of the Surface. */
+	uint8 SurfaceFlags;
+
+	FDWallClingContext();
+
+	/* Takes the Surface, Impact point and Impact normal from the Hit. */
+	void SetFromHit(const FHitResult& Hit);
+
+	/* Takes everything but the original Rotation from Other, which has to survive until the current Cling is released. */
+	void SetSurfaceFrom(const FDWallClingContext& Other);
+
+	void SetImpactNormal(const FVector& Normal);
+
+	FORCEINLINE FVector GetImpactNormal() const
+	{
+		return FVector(ImpactNormal[0], ImpactNormal[1], ImpactNormal[2]) * (1.f / MAX_int16);
+	}
+
+	/* The Z component of the Impact normal, without decoding the rest of it. */
+	FORCEINLINE float GetImpactNormalZ() const { return ImpactNormal[2] * (1.f / MAX_int16); }
+
+	/* The Yaw the Character was facing when they hit the Surface. */
+	FORCEINLINE void SetCharacterYaw(float Yaw) { CharacterYaw = FRotator::CompressAxisToShort(Yaw); }
+	FORCEINLINE float GetCharacterYaw() const { return FRotator::DecompressAxisFromShort(CharacterYaw); }
+
+	/* The Characters Forward and Right vectors when they hit the Surface, from their Yaw. */
+	FORCEINLINE FVector GetCharacterForward() const { return FRotator(0.f, GetCharacterYaw(), 0.f).Vector(); }
+	FORCEINLINE FVector GetCharacterRight() const { return FRotator(0.f, GetCharacterYaw() + 90.f, 0.f).Vector(); }
+
+	/* The Characters Rotation before the Cling overrode it. */
+	void SetOriginalRotation(const FRotator& Rotation);
+	FRotator GetOriginalRotation() const;
+
+	/* Rebuilds an FHitResult for the Blueprint delegates, only the Surface, Impact point and normal are set. */
+	FHitResult ToHitResult() const;
+
+private:
+
+	int16 ImpactNormal[3];
+
+	uint16 CharacterYaw;
+
+	uint16 OriginalRotation[3];
+};
+
+// The FHitResult, basis vectors and Rotation it replaced came to well over 150 bytes, keep an eye on anything that grows it.
+static_assert(sizeof(FDWallClingContext) == 36, "FDWallClingContext is held by every WJC, update the dignity.WallJump.ClingContextSize numbers if it has to grow.");
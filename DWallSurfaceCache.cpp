@@ -0,0 +1,112 @@
+#include "Dignity.h"
+#include "DWallSurfaceCache.h"
+#include "Components/PrimitiveComponent.h"
+#include "GameFramework/Actor.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+
+FDWallSurfaceCache::FDWallSurfaceCache(int32 InCapacity /*= 4096*/)
+	: Capacity(FMath::Max(InCapacity, 1))
+	, NumHits(0)
+	, NumMisses(0)
+{
+}
+
+void FDWallSurfaceCache::Reset()
+{
+	Entries.Reset();
+}
+
+void FDWallSurfaceCache::Invalidate(const UPrimitiveComponent* Component)
+{
+	const FObjectKey ComponentKey(Component);
+
+	// An Component has an Entry for each face that was Hit, so they all have to be found.
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		if (It.Key().Component == ComponentKey)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+uint32 FDWallSurfaceCache::QuantizeNormal(const FVector& Normal)
+{
+	// 10 bits per axis is well under an degree of precision, faces of the same wall all land in the same key.
+	const uint32 X = (uint32)FMath::RoundToInt((FMath::Clamp(Normal.X, -1.f, 1.f) * 0.5f + 0.5f) * 1023.f);
+	const uint32 Y = (uint32)FMath::RoundToInt((FMath::Clamp(Normal.Y, -1.f, 1.f) * 0.5f + 0.5f) * 1023.f);
+	const uint32 Z = (uint32)FMath::RoundToInt((FMath::Clamp(Normal.Z, -1.f, 1.f) * 0.5f + 0.5f) * 1023.f);
+	return X | (Y << 10) | (Z << 20);
+}
+
+uint8 FDWallSurfaceCache::GetSurfaceFlags(const UPrimitiveComponent* Component, const FHitResult& Hit, const FDWallSurfaceRules& Rules)
+{
+	uint8 Flags = EDWallSurfaceFlags::None;
+
+	const AActor* Owner = Component->GetOwner();
+
+	if (Rules.NoClingTag != NAME_None && (Component->ComponentHasTag(Rules.NoClingTag) || (Owner && Owner->ActorHasTag(Rules.NoClingTag))))
+	{
+		Flags |= EDWallSurfaceFlags::NoCling;
+	}
+
+	if (Rules.NoJumpTag != NAME_None && (Component->ComponentHasTag(Rules.NoJumpTag) || (Owner && Owner->ActorHasTag(Rules.NoJumpTag))))
+	{
+		Flags |= EDWallSurfaceFlags::NoJump;
+	}
+
+	if (Rules.NoClingSurfaceTypes.Num() > 0 || Rules.NoJumpSurfaceTypes.Num() > 0)
+	{
+		// The Characters sweep only returns the Physical Material of the face if it was asked to, otherwise use the one of the Body.
+		const UPhysicalMaterial* PhysicalMaterial = Hit.PhysMaterial.Get();
+		if (!PhysicalMaterial && Component->GetBodyInstance())
+		{
+			PhysicalMaterial = Component->GetBodyInstance()->GetSimplePhysicalMaterial();
+		}
+
+		if (PhysicalMaterial)
+		{
+			const TEnumAsByte<EPhysicalSurface> SurfaceType = PhysicalMaterial->SurfaceType;
+
+			if (Rules.NoClingSurfaceTypes.Contains(SurfaceType))
+			{
+				Flags |= EDWallSurfaceFlags::NoCling;
+			}
+
+			if (Rules.NoJumpSurfaceTypes.Contains(SurfaceType))
+			{
+				Flags |= EDWallSurfaceFlags::NoJump;
+			}
+		}
+	}
+
+	return Flags;
+}
+
+FDWallSurfaceCacheEntry& FDWallSurfaceCache::FindOrAdd(const UPrimitiveComponent* Component, const FHitResult& Hit, const FDWallSurfaceRules& Rules)
+{
+	check(Component);
+
+	FKey Key;
+	Key.Component = FObjectKey(Component);
+	Key.Normal = QuantizeNormal(Hit.ImpactNormal);
+
+	if (FDWallSurfaceCacheEntry* Entry = Entries.Find(Key))
+	{
+		NumHits++;
+		return *Entry;
+	}
+
+	NumMisses++;
+
+	// Nothing in the cache is ever more than an lookup away from being rebuilt, so rather than tracking what is least used just start again.
+	if (Entries.Num() >= Capacity)
+	{
+		Entries.Reset();
+	}
+
+	FDWallSurfaceCacheEntry& Entry = Entries.Add(Key);
+	Entry.Flags = GetSurfaceFlags(Component, Hit, Rules);
+	Entry.NormalZ = (float)((Key.Normal >> 20) & 1023) / 1023.f * 2.f - 1.f;
+	return Entry;
+}
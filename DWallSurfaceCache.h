@@ -0,0 +1,133 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "Engine/EngineTypes.h"
+
+class UPrimitiveComponent;
+
+/* Per Surface overrides that stop an WJC from using it, more than one can be set. */
+namespace EDWallSurfaceFlags
+{
+	enum Type : uint8
+	{
+		None		= 0,
+		NoCling		= 1 << 0,
+		NoJump		= 1 << 1,
+	};
+}
+
+/* What makes an Surface unusable for Clinging or Jumping, set up on the UDWallJumpSubsystem. */
+struct FDWallSurfaceRules
+{
+	/* An Component or Actor with this Tag cant be Clung to. */
+	FName NoClingTag;
+
+	/* An Component or Actor with this Tag cant be Jumped from. */
+	FName NoJumpTag;
+
+	/* Physical Surface types that cant be Clung to, ice for example. */
+	TArray<TEnumAsByte<EPhysicalSurface>> NoClingSurfaceTypes;
+
+	/* Physical Surface types that cant be Jumped from. */
+	TArray<TEnumAsByte<EPhysicalSurface>> NoJumpSurfaceTypes;
+};
+
+/* An cached Surface, the result of its overrides and of its last Pitch eligibility check. */
+struct FDWallSurfaceCacheEntry
+{
+	/* EDWallSurfaceFlags of the Surface. */
+	uint8 Flags;
+
+	/* The Z of the quantized normal, the Pitch Dot for an Character whose Up is the World Up. */
+	float NormalZ;
+
+	/* The Pitch Cosine bounds bIsPitchEligible was last checked against. */
+	float PitchMinCos;
+	float PitchMaxCos;
+
+	bool bIsPitchEligible;
+
+	FDWallSurfaceCacheEntry()
+		: Flags(EDWallSurfaceFlags::None)
+		, NormalZ(0.f)
+		, PitchMinCos(2.f)
+		, PitchMaxCos(2.f)
+		, bIsPitchEligible(false)
+	{
+	}
+
+	FORCEINLINE bool AllowsCling() const { return (Flags & EDWallSurfaceFlags::NoCling) == 0; }
+	FORCEINLINE bool AllowsJump() const { return (Flags & EDWallSurfaceFlags::NoJump) == 0; }
+
+	/**
+	 * True if an Character whose Up is the World Up could Cling to the Surface with these Pitch bounds, only recalculated when the bounds change.
+	 * The bounds are widened by the quantization of the normal so this never rejects an Surface the exact check in the FDWallHitBatch would accept.
+	 */
+	FORCEINLINE bool IsPitchEligible(float MinPitchCos, float MaxPitchCos)
+	{
+		if (MinPitchCos != PitchMinCos || MaxPitchCos != PitchMaxCos)
+		{
+			const float Tolerance = 2.f / 1023.f;
+
+			PitchMinCos = MinPitchCos;
+			PitchMaxCos = MaxPitchCos;
+			bIsPitchEligible = NormalZ >= MaxPitchCos - Tolerance && NormalZ <= MinPitchCos + Tolerance;
+		}
+
+		return bIsPitchEligible;
+	}
+};
+
+/**
+ * Caches what an WJC needs to know about the static Surfaces it hits, keyed by the Component and its quantized Impact normal.
+ * Characters hit the same walls over and over so the Tag and Physical Material lookups only need to happen on the first Hit of each face.
+ * The cache is emptied whenever an level is streamed in or out, and when it grows past its capacity.
+ * Changing the Tags or Physical Material of an Surface at runtime isnt noticed, call Invalidate() on each Component that changed, or on every Component of an Actor whose Tags changed.
+ */
+class DIGNITY_API FDWallSurfaceCache
+{
+public:
+
+	explicit FDWallSurfaceCache(int32 InCapacity = 4096);
+
+	/* Returns the Entry for the Surface that was Hit, building it if this is the first time we have seen it. */
+	FDWallSurfaceCacheEntry& FindOrAdd(const UPrimitiveComponent* Component, const FHitResult& Hit, const FDWallSurfaceRules& Rules);
+
+	void Reset();
+
+	/* Forgets every Entry of the Component, so its Tags and Physical Material are read again on its next Hit. */
+	void Invalidate(const UPrimitiveComponent* Component);
+
+	FORCEINLINE int32 Num() const { return Entries.Num(); }
+
+	/* Lookups answered from the cache, and lookups that had to build an Entry. */
+	FORCEINLINE uint32 GetNumHits() const { return NumHits; }
+	FORCEINLINE uint32 GetNumMisses() const { return NumMisses; }
+
+	/* Reads the EDWallSurfaceFlags of an Surface from its Tags and Physical Material, uncached. */
+	static uint8 GetSurfaceFlags(const UPrimitiveComponent* Component, const FHitResult& Hit, const FDWallSurfaceRules& Rules);
+
+private:
+
+	struct FKey
+	{
+		FObjectKey Component;
+
+		/* The Impact normal quantized to 10 bits per axis. */
+		uint32 Normal;
+
+		FORCEINLINE bool operator==(const FKey& Other) const { return Component == Other.Component && Normal == Other.Normal; }
+
+		friend FORCEINLINE uint32 GetTypeHash(const FKey& Key) { return HashCombine(GetTypeHash(Key.Component), Key.Normal); }
+	};
+
+	TMap<FKey, FDWallSurfaceCacheEntry> Entries;
+
+	int32 Capacity;
+
+	uint32 NumHits;
+	uint32 NumMisses;
+
+	static uint32 QuantizeNormal(const FVector& Normal);
+};